@@ -0,0 +1,116 @@
+/**
+ * \file bench.cpp
+ * \brief Microbenchmarks base help definitions
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "bench.h"
+
+namespace benchmarks
+{
+
+// -----------------------------------------------------------------------------
+
+auto local_dir(std::string_view sub) -> Path
+{
+  Path ret{filesystem::temp_directory_path()};
+  ret /= local_bench_dir;
+  if(sub.size()) ret /= std::string{sub};
+
+  if(!filesystem::exists(ret) && !filesystem::create_directories(ret))
+  {
+    throw std::runtime_error("Can't create local temporary directory");
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void make_file(const Path & path, const size_t & size)
+{
+  if(filesystem::exists(path) && (filesystem::file_size(path) == size)) return;
+
+  std::vector<char> data(size);
+  for(size_t iter = 0U; iter < size; ++iter)
+  {
+    data[iter] = static_cast<char>((iter * 7U + (iter >> 8U)) & 0xFFU);
+  }
+
+  std::ofstream file{path, std::ios_base::out | std::ios_base::binary};
+  file.write(data.data(), (std::streamsize) data.size());
+}
+
+// -----------------------------------------------------------------------------
+
+auto fake_md5(const size_t & num) -> std::string
+{
+  std::stringstream ss;
+  ss << std::hex << std::setw(32) << std::setfill('0') << (num * 0x9E3779B1U);
+  return ss.str();
+}
+
+// -----------------------------------------------------------------------------
+
+auto make_md5_tree() -> Path
+{
+  Path root{local_dir("md5_tree")};
+
+  for(size_t dir = 0U; dir < tree_dirs; ++dir)
+  {
+    Path curr_dir{root / ("dir" + std::to_string(dir))};
+    filesystem::create_directories(curr_dir);
+
+    for(size_t file = 0U; file < tree_files; ++file)
+    {
+      size_t num = dir * tree_files + file;
+      std::string name{"fw" + std::to_string(num) + ".bin"};
+
+      if(!filesystem::exists(curr_dir / name)) make_file(curr_dir / name, 16U);
+
+      std::ofstream md5{curr_dir / (name + ".md5"), std::ios_base::out};
+      md5 << fake_md5(num) << "  " << name << std::endl;
+    }
+  }
+
+  return root;
+}
+
+// -----------------------------------------------------------------------------
+
+auto request(
+    int16_t opcode,
+    std::string_view name,
+    ReqOpts opts) -> std::tuple<tftp::SmBuf, size_t>
+{
+  tftp::SmBuf buf(1024U, 0);
+
+  size_t pos = (size_t) buf.set_be(0U, opcode);
+  pos += (size_t) buf.set_string(pos, name, true);
+  pos += (size_t) buf.set_string(pos, "octet", true);
+  for(auto & [opt_name, opt_val] : opts)
+  {
+    pos += (size_t) buf.set_string(pos, opt_name, true);
+    pos += (size_t) buf.set_string(pos, opt_val, true);
+  }
+
+  return {std::move(buf), pos};
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace benchmarks
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+/**
+ * \file bench.h
+ * \brief Microbenchmarks base help definitions
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_BENCHMARKS_BENCH_H_
+#define SOURCE_BENCHMARKS_BENCH_H_
+
+#include <benchmark/benchmark.h>
+#include <experimental/filesystem>
+#include <initializer_list>
+#include <utility>
+
+#include "../tftpSmBuf.h"
+
+using namespace std::experimental;
+
+using Path = filesystem::path;
+
+//------------------------------------------------------------------------------
+
+namespace benchmarks
+{
+  /// Base temp directory for benchmark data
+  constexpr std::string_view local_bench_dir = "server-fw_bench_data";
+
+  /// Size of file used by read/write benchmarks
+  constexpr size_t file_size = 4U * 1024U * 1024U;
+
+  /// Synthetic tree for search by md5: directories x files in directory
+  constexpr size_t tree_dirs  = 16U;
+  constexpr size_t tree_files = 64U;
+
+  /// Option name/value pairs for request packet
+  using ReqOpts = std::initializer_list<std::pair<std::string_view, std::string_view>>;
+
+  /** \brief Get (create if need) temporary directory for benchmarks
+   *
+   *  \param [in] sub Name of subdirectory (empty - base directory)
+   *  \return Path to directory
+   */
+  auto local_dir(std::string_view sub = "") -> Path;
+
+  /** \brief Create file with generated content (if not exist or other size)
+   *
+   *  \param [in] path Path to file
+   *  \param [in] size Size of file
+   */
+  void make_file(const Path & path, const size_t & size);
+
+  /** \brief Fake md5 sum (32 hex digits) for number
+   *
+   *  \param [in] num Number
+   *  \return String with md5 sum
+   */
+  auto fake_md5(const size_t & num) -> std::string;
+
+  /** \brief Create synthetic tree of files with .md5 sidecars
+   *
+   *  Directories tree_dirs, each with tree_files files; md5 sum of file
+   *  number N is fake_md5(N)
+   *  \return Root path of tree
+   */
+  auto make_md5_tree() -> Path;
+
+  /** \brief Build TFTP request packet
+   *
+   *  \param [in] opcode Request opcode (1 - RRQ, 2 - WRQ)
+   *  \param [in] name File name
+   *  \param [in] opts Options
+   *  \return Tuple<buffer; size of packet>
+   */
+  auto request(
+      int16_t opcode,
+      std::string_view name,
+      ReqOpts opts = {}) -> std::tuple<tftp::SmBuf, size_t>;
+
+} // namespace benchmarks
+
+#endif /* SOURCE_BENCHMARKS_BENCH_H_ */
@@ -0,0 +1,170 @@
+/**
+ * \file tftpDataMgr_bench.cpp
+ * \brief Microbenchmarks of data managers
+ *
+ *  Match/search by md5, read/write per block
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "bench.h"
+#include "../tftpDataMgrMmap.h"
+#include "../tftpOptions.h"
+
+using namespace benchmarks;
+
+//------------------------------------------------------------------------------
+
+/** \brief Helper class for access to DataMgr protected fields
+ */
+class DataMgr_bench: public tftp::DataMgrFile
+{
+public:
+  using tftp::DataMgrFile::match_md5;
+  using tftp::DataMgrFile::search_by_md5;
+};
+
+//------------------------------------------------------------------------------
+
+/** \brief Settings with root directory of benchmark data
+ *
+ *  \return Settings
+ */
+static auto make_settings() -> tftp::pSettings
+{
+  auto ret = tftp::Settings::create();
+  ret->root_dir = local_dir().string();
+  ret->use_syslog = 0; // not interested in logging
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+
+/** \brief Request options for data manager init()
+ *
+ *  \param [in] opcode Request opcode (1 - RRQ, 2 - WRQ)
+ *  \param [in] name File name
+ *  \return Parsed options
+ */
+static auto make_opt(int16_t opcode, std::string_view name) -> tftp::Options
+{
+  auto [buf, size] = request(opcode, name);
+  tftp::Options opt;
+  opt.buffer_parse(buf, size, nullptr);
+  return opt;
+}
+
+//------------------------------------------------------------------------------
+
+static void DataMgr_match_md5(benchmark::State & state)
+{
+  DataMgr_bench dm;
+  const std::string md5{fake_md5(12345U)};
+  const std::string name{"firmware-v2.bin"};
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(dm.match_md5(md5));
+    benchmark::DoNotOptimize(dm.match_md5(name));
+  }
+}
+BENCHMARK(DataMgr_match_md5);
+
+//------------------------------------------------------------------------------
+
+static void DataMgr_search_by_md5(benchmark::State & state)
+{
+  Path root{make_md5_tree()};
+  DataMgr_bench dm;
+
+  // Found at middle of tree (arg 1) or full scan without result (arg 0)
+  const std::string md5{state.range(0) ?
+                        fake_md5(tree_dirs * tree_files / 2U) :
+                        fake_md5(tree_dirs * tree_files + 1U)};
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(dm.search_by_md5(root, md5));
+  }
+  state.counters["files"] = (double) (tree_dirs * tree_files);
+}
+BENCHMARK(DataMgr_search_by_md5)->ArgName("found")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+//------------------------------------------------------------------------------
+
+/** \brief Read file per block
+ *
+ *  Args: block size
+ */
+template<typename T>
+static void DataMgr_read(benchmark::State & state)
+{
+  const size_t block = (size_t) state.range(0);
+  make_file(local_dir() / "read.bin", file_size);
+
+  auto sett = make_settings();
+  T dm;
+  if(!dm.init(sett, nullptr, make_opt(1, "read.bin")))
+  {
+    state.SkipWithError("Can't open file for read");
+    return;
+  }
+
+  tftp::SmBufEx buf{block};
+  size_t position = 0U;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(dm.read(buf.begin(), buf.begin() + block, position));
+    position = (position + block) % file_size;
+  }
+  state.SetBytesProcessed((int64_t) (state.iterations() * block));
+
+  dm.close();
+}
+BENCHMARK_TEMPLATE(DataMgr_read, tftp::DataMgrFile)->ArgName("block")
+    ->Arg(512)->Arg(1428)->Arg(8192);
+BENCHMARK_TEMPLATE(DataMgr_read, tftp::DataMgrMmap)->ArgName("block")
+    ->Arg(512)->Arg(1428)->Arg(8192);
+
+//------------------------------------------------------------------------------
+
+/** \brief Write file per block (file rewritten in cycle)
+ *
+ *  Args: block size
+ */
+static void DataMgrFile_write(benchmark::State & state)
+{
+  const size_t block = (size_t) state.range(0);
+
+  auto sett = make_settings();
+  tftp::DataMgrFile dm;
+  filesystem::remove(local_dir() / "write.bin");
+
+  if(!dm.init(sett, nullptr, make_opt(2, "write.bin")))
+  {
+    state.SkipWithError("Can't open file for write");
+    return;
+  }
+
+  tftp::SmBufEx buf{block};
+  std::fill(buf.begin(), buf.end(), 0x5A);
+  size_t position = 0U;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(dm.write(buf.data(), block, position));
+    position = (position + block) % file_size;
+  }
+  state.SetBytesProcessed((int64_t) (state.iterations() * block));
+
+  dm.close();
+  filesystem::remove(local_dir() / "write.bin");
+}
+BENCHMARK(DataMgrFile_write)->ArgName("block")->Arg(512)->Arg(1428)->Arg(8192);
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,116 @@
+/**
+ * \file tftpPkt_bench.cpp
+ * \brief Microbenchmarks of protocol primitives
+ *
+ *  Options, SmBuf, SmBufEx, Addr
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "bench.h"
+#include "../tftpAddr.h"
+#include "../tftpOptions.h"
+#include "../tftpSmBufEx.h"
+
+using namespace benchmarks;
+
+//------------------------------------------------------------------------------
+
+static void Options_buffer_parse(benchmark::State & state)
+{
+  auto [buf, size] = state.range(0) ?
+      request(1, "firmware/device-v2.bin",
+              {{"blksize", "1428"}, {"timeout", "3"}, {"tsize", "0"},
+               {"windowsize", "8"}}) :
+      request(1, "firmware/device-v2.bin");
+
+  tftp::Options opt;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(opt.buffer_parse(buf, size, nullptr));
+  }
+  state.SetBytesProcessed((int64_t) (state.iterations() * size));
+}
+BENCHMARK(Options_buffer_parse)->ArgName("options")->Arg(0)->Arg(1);
+
+//------------------------------------------------------------------------------
+
+static void SmBufEx_push_data(benchmark::State & state)
+{
+  tftp::SmBufEx buf{1024U};
+  const std::string name{"firmware/device-v2.bin"};
+
+  for(auto _ : state)
+  {
+    buf.clear();
+    benchmark::DoNotOptimize(
+        buf.push_data((int16_t) 6, name, "blksize", "1428", "tsize", "300000"));
+  }
+  state.SetBytesProcessed((int64_t) (state.iterations() * buf.data_size()));
+}
+BENCHMARK(SmBufEx_push_data);
+
+//------------------------------------------------------------------------------
+
+static void SmBuf_get_be(benchmark::State & state)
+{
+  tftp::SmBuf buf(516U, 0);
+  buf.set_be(0U, (int16_t) 3);
+  buf.set_be(2U, (uint16_t) 0x1234U);
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(buf.get_be<int16_t>(0U));
+    benchmark::DoNotOptimize(buf.get_be<uint16_t>(2U));
+  }
+}
+BENCHMARK(SmBuf_get_be);
+
+//------------------------------------------------------------------------------
+
+static void SmBuf_get_string(benchmark::State & state)
+{
+  auto [buf, size] = request(1, "firmware/device-v2.bin");
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(buf.get_string(2U, size - 2U));
+  }
+}
+BENCHMARK(SmBuf_get_string);
+
+//------------------------------------------------------------------------------
+
+static void Addr_set_string(benchmark::State & state)
+{
+  const std::string_view str{state.range(0) ? "[fe80::1:2:3]:6969" :
+                                              "192.168.10.20:6969"};
+  tftp::Addr addr;
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(addr.set_string(str));
+  }
+}
+BENCHMARK(Addr_set_string)->ArgName("ipv6")->Arg(0)->Arg(1);
+
+//------------------------------------------------------------------------------
+
+static void Addr_str(benchmark::State & state)
+{
+  tftp::Addr addr;
+  addr.set_string(state.range(0) ? "[fe80::1:2:3]:6969" : "192.168.10.20:6969");
+
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(addr.str());
+  }
+}
+BENCHMARK(Addr_str)->ArgName("ipv6")->Arg(0)->Arg(1);
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+/**
+ * \file tftpSession_bench.cpp
+ * \brief Microbenchmarks of session packet construction
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "bench.h"
+#include "../tftpSession.h"
+
+using namespace benchmarks;
+
+//------------------------------------------------------------------------------
+
+/** \brief Helper class for access to Session protected fields
+ */
+class Session_bench: public tftp::Session
+{
+public:
+  using tftp::Session::settings_;
+  using tftp::Session::stage_;
+  using tftp::Session::construct_data;
+  using tftp::Session::construct_opt_reply;
+
+  /** \brief Prepare and init session for RRQ of benchmark file
+   *
+   *  \param [in] opts Request options
+   *  \return True if success, else - false
+   */
+  bool start(ReqOpts opts)
+  {
+    settings_->root_dir = local_dir().string();
+    settings_->use_syslog = 0; // not interested in logging
+
+    tftp::Addr cl_addr;
+    cl_addr.set_string("127.0.0.1:6969");
+
+    auto [buf, size] = request(1, "session.bin", opts);
+    return prepare(cl_addr, buf, size) && init();
+  }
+};
+
+//------------------------------------------------------------------------------
+
+/** \brief Construct DATA packets of whole file in cycle
+ *
+ *  Args: block size; window size
+ */
+static void Session_construct_data(benchmark::State & state)
+{
+  make_file(local_dir() / "session.bin", file_size);
+
+  const std::string blksize{std::to_string(state.range(0))};
+  const std::string windowsize{std::to_string(state.range(1))};
+
+  Session_bench sess;
+  if(!sess.start({{"blksize", blksize}, {"windowsize", windowsize}}))
+  {
+    state.SkipWithError("Can't start session");
+    return;
+  }
+
+  const size_t blocks = file_size / (size_t) state.range(0);
+  sess.stage_ = 1U;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(sess.construct_data().data_size());
+    if(++sess.stage_ > blocks) sess.stage_ = 1U;
+  }
+  state.SetBytesProcessed((int64_t) (state.iterations() * state.range(0)));
+}
+BENCHMARK(Session_construct_data)->ArgNames({"blksize", "windowsize"})
+    ->Args({512, 1})->Args({1428, 1})->Args({1428, 8})->Args({8192, 16});
+
+//------------------------------------------------------------------------------
+
+static void Session_construct_opt_reply(benchmark::State & state)
+{
+  make_file(local_dir() / "session.bin", file_size);
+
+  Session_bench sess;
+  if(!sess.start({{"blksize", "1428"}, {"timeout", "3"}, {"tsize", "0"},
+                  {"windowsize", "8"}}))
+  {
+    state.SkipWithError("Can't start session");
+    return;
+  }
+
+  tftp::SmBuf mem(1024U, 0);
+  tftp::SmBufView buf{mem};
+  for(auto _ : state)
+  {
+    sess.construct_opt_reply(buf);
+    benchmark::DoNotOptimize(buf.data_size());
+  }
+}
+BENCHMARK(Session_construct_opt_reply);
+
+//------------------------------------------------------------------------------
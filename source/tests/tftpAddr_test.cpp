@@ -198,6 +198,55 @@ UNIT_TEST_CASE_BEGIN(main, "Check main methods")
     TEST_CHECK_TRUE(a.as_in().sin_addr.s_addr == 0x01020304U);
   }
 
+  {
+    auto [b1,b2] = a.set_string(":6969");
+    TEST_CHECK_FALSE(b1);
+    TEST_CHECK_TRUE(b2);
+    TEST_CHECK_TRUE(a.family() == AF_INET);
+    TEST_CHECK_TRUE(a.port() == 6969U);
+    TEST_CHECK_TRUE(a.as_in().sin_addr.s_addr == 0x01020304U);
+  }
+
+  {
+    a.clear();
+    auto [b1,b2] = a.set_string("[::1]");
+    TEST_CHECK_TRUE(b1);
+    TEST_CHECK_FALSE(b2);
+    TEST_CHECK_TRUE(a.str() == "[::1]:0");
+  }
+
+  {
+    a.clear();
+    auto [b1,b2] = a.set_string("fe80::1");
+    TEST_CHECK_TRUE(b1);
+    TEST_CHECK_FALSE(b2);
+    TEST_CHECK_TRUE(a.str() == "[fe80::1]:0");
+  }
+
+  {
+    a.clear();
+    auto [b1,b2] = a.set_string("1.2.3.400:69");
+    TEST_CHECK_FALSE(b1);
+    TEST_CHECK_TRUE(b2);
+    TEST_CHECK_TRUE(a.family() == AF_INET);
+  }
+
+  {
+    a.clear();
+    auto [b1,b2] = a.set_string("1.2.3.4.5");
+    TEST_CHECK_FALSE(b1);
+    TEST_CHECK_FALSE(b2);
+    TEST_CHECK_TRUE(a.family() == 0U);
+  }
+
+  {
+    a.clear();
+    auto [b1,b2] = a.set_string("[::1]:x");
+    TEST_CHECK_FALSE(b1);
+    TEST_CHECK_FALSE(b2);
+    TEST_CHECK_TRUE(a.family() == 0U);
+  }
+
 
 UNIT_TEST_CASE_END
 
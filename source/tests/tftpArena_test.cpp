@@ -0,0 +1,95 @@
+/**
+ * \file tftpArena_test.cpp
+ * \brief Unit-tests for class Arena
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "test.h"
+#include "../tftpArena.h"
+#include "../tftpSmBuf.h"
+
+UNIT_TEST_SUITE_BEGIN(Arena)
+
+using namespace unit_tests;
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("Disabled arena use heap")
+{
+  tftp::Arena a;
+  TEST_CHECK_FALSE(a.enabled());
+
+  void * ptr = a.allocate(8192U);
+  TEST_CHECK_TRUE(ptr != nullptr);
+  auto [total, hugetlb, thp, used] = a.stat();
+  TEST_CHECK_TRUE(total == 0U);
+  TEST_CHECK_TRUE(used == 0U);
+  a.deallocate(ptr, 8192U);
+}
+
+START_ITER("Allocate and reuse")
+{
+  tftp::Arena a;
+  void * old_ptr = a.allocate(8192U); // before enable - from heap
+  a.enable();
+  TEST_CHECK_TRUE(a.enabled());
+
+  void * ptr1 = a.allocate(5000U);
+  void * ptr2 = a.allocate(65536U);
+  void * ptr3 = a.allocate(100U); // small - from heap
+  {
+    auto [total, hugetlb, thp, used] = a.stat();
+    TEST_CHECK_TRUE(total == tftp::constants::arena_region_size);
+    TEST_CHECK_TRUE(hugetlb + thp == total);
+    TEST_CHECK_TRUE(used == 8192U + 65536U);
+  }
+
+  memset(ptr1, 1, 5000U);
+  memset(ptr2, 2, 65536U);
+
+  a.deallocate(ptr1, 5000U);
+  TEST_CHECK_TRUE(a.allocate(8000U) == ptr1); // same size class
+  a.deallocate(ptr1, 8000U);
+  a.deallocate(ptr2, 65536U);
+  a.deallocate(ptr3, 100U);
+  a.deallocate(old_ptr, 8192U);
+  {
+    auto [total, hugetlb, thp, used] = a.stat();
+    TEST_CHECK_TRUE(total == tftp::constants::arena_region_size);
+    TEST_CHECK_TRUE(used == 0U);
+  }
+}
+
+START_ITER("Buffers from global arena")
+{
+  auto & a = tftp::Arena::global();
+  bool was_enabled = a.enabled();
+
+  tftp::SmBuf old_buf(0xFFFFU, 0);
+  a.enable();
+  {
+    tftp::SmBuf buf(0xFFFFU, 0);
+    buf.set_be<uint16_t>(0U, 0x1234U);
+    TEST_CHECK_TRUE(buf.get_be<uint16_t>(0U) == 0x1234U);
+
+    auto [total, hugetlb, thp, used] = a.stat();
+    TEST_CHECK_TRUE(total > 0U);
+    TEST_CHECK_TRUE(used >= 0x10000U);
+  }
+  old_buf = tftp::SmBuf(0x1000U, 0); // free heap buffer with enabled arena
+  a.enable(was_enabled);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
@@ -99,6 +99,36 @@ START_ITER("Modify values and try again")
   TEST_CHECK_TRUE(sd[2U] == "/dir3/");
 }
 
+START_ITER("Log level gate")
+{
+  b.settings_->use_syslog = 4; // up to warnings
+  TEST_CHECK_TRUE(b.is_log_enabled(tftp::LogLvl::err));
+  TEST_CHECK_TRUE(b.is_log_enabled(tftp::LogLvl::warning));
+  TEST_CHECK_FALSE(b.is_log_enabled(tftp::LogLvl::info));
+  TEST_CHECK_FALSE(b.is_log_enabled(tftp::LogLvl::debug));
+
+  b.set_logger([](const tftp::LogLvl, std::string_view){});
+  TEST_CHECK_TRUE(b.is_log_enabled(tftp::LogLvl::debug));
+  b.set_logger(nullptr);
+
+  TEST_CHECK_TRUE(&tftp::curr_type<Base_test>() ==
+                  &tftp::curr_type<Base_test>()); // cached
+  TEST_CHECK_TRUE(tftp::curr_type<Base_test>().find("Base_test") !=
+                  std::string::npos);
+}
+
+START_ITER("Settings snapshot")
+{
+  auto old_settings = b.settings_;
+  TEST_CHECK_TRUE(&b.get_serach_dir() == &old_settings->backup_dirs); // no copy
+
+  b.set_logger([](const tftp::LogLvl, std::string_view){});
+  TEST_CHECK_FALSE(b.settings_ == old_settings); // new snapshot published
+  TEST_CHECK_FALSE((bool) old_settings->log_);   // old snapshot not changed
+  TEST_CHECK_TRUE(b.settings_->root_dir == old_settings->root_dir);
+  b.set_logger(nullptr);
+}
+
 //
 UNIT_TEST_CASE_END
 
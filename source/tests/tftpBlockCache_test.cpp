@@ -0,0 +1,86 @@
+/**
+ * \file tftpBlockCache_test.cpp
+ * \brief Unit-tests for class BlockCache
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "test.h"
+#include "../tftpBlockCache.h"
+
+UNIT_TEST_SUITE_BEGIN(BlockCache)
+
+using namespace unit_tests;
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+const tftp::FileId id1{1, 10, 1000, 100, 0};
+const tftp::FileId id2{1, 11, 1000, 100, 0};
+
+auto new_chunk = [](size_t size, char val)
+    { return std::make_shared<const tftp::ArenaBuf>(size, val); };
+
+START_ITER("Find and insert")
+{
+  tftp::BlockCache c{1000U};
+  TEST_CHECK_TRUE(c.enabled());
+
+  TEST_CHECK_TRUE(c.find(id1, 0U) == nullptr);
+
+  c.insert(id1, 0U, new_chunk(100U, 'a'));
+  c.insert(id2, 0U, new_chunk(100U, 'b'));
+  TEST_CHECK_TRUE(c.size() == 200U);
+
+  auto data1 = c.find(id1, 0U);
+  TEST_CHECK_TRUE(data1 && ((*data1)[0U] == 'a'));
+  auto data2 = c.find(id2, 0U);
+  TEST_CHECK_TRUE(data2 && ((*data2)[0U] == 'b'));
+  TEST_CHECK_TRUE(c.find(id1, 1U) == nullptr);
+
+  auto [hits, misses] = c.stat();
+  TEST_CHECK_TRUE(hits == 2U);
+  TEST_CHECK_TRUE(misses == 2U);
+
+  c.clear();
+  TEST_CHECK_TRUE(c.size() == 0U);
+}
+
+START_ITER("Least recently used eviction")
+{
+  tftp::BlockCache c{300U};
+
+  c.insert(id1, 0U, new_chunk(100U, 'a'));
+  c.insert(id1, 1U, new_chunk(100U, 'b'));
+  c.insert(id1, 2U, new_chunk(100U, 'c'));
+  TEST_CHECK_TRUE(c.find(id1, 0U) != nullptr); // chunk 1 now oldest
+
+  c.insert(id1, 3U, new_chunk(100U, 'd'));
+  TEST_CHECK_TRUE(c.size() == 300U);
+  TEST_CHECK_TRUE(c.find(id1, 1U) == nullptr);
+  TEST_CHECK_TRUE(c.find(id1, 0U) != nullptr);
+  TEST_CHECK_TRUE(c.find(id1, 3U) != nullptr);
+
+  c.insert(id2, 0U, new_chunk(400U, 'e')); // more than budget
+  TEST_CHECK_TRUE(c.find(id2, 0U) == nullptr);
+}
+
+START_ITER("Disabled cache")
+{
+  tftp::BlockCache c{0U};
+  TEST_CHECK_FALSE(c.enabled());
+  c.insert(id1, 0U, new_chunk(1U, 'a'));
+  TEST_CHECK_TRUE(c.find(id1, 0U) == nullptr);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
@@ -91,6 +91,24 @@ START_ITER("Check operator+")
   }
 }
 
+START_ITER("Check MD5 sum matching")
+{
+  TEST_CHECK_TRUE (tftp::is_md5_str("2fdf093688bb7cef7c05b1ffcc71ff4e"));
+  TEST_CHECK_TRUE (tftp::is_md5_str("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"));
+  TEST_CHECK_FALSE(tftp::is_md5_str("2fdf093688bb7cef7c05b1ffcc71ff4"));
+  TEST_CHECK_FALSE(tftp::is_md5_str("2fdf093688bb7cef7c05b1ffcc71ff4e0"));
+  TEST_CHECK_FALSE(tftp::is_md5_str("2fdf093688bb7cef7c05b1ffcc71ff4g"));
+  TEST_CHECK_FALSE(tftp::is_md5_str(""));
+
+  constexpr auto npos = std::string_view::npos;
+  TEST_CHECK_TRUE(tftp::find_md5("2fdf093688bb7cef7c05b1ffcc71ff4e") == 0U);
+  TEST_CHECK_TRUE(tftp::find_md5("2fdf093688bb7cef7c05b1ffcc71ff4e  file") == 0U);
+  TEST_CHECK_TRUE(tftp::find_md5("MD5 (file) = 2fdf093688bb7cef7c05b1ffcc71ff4e") == 13U);
+  TEST_CHECK_TRUE(tftp::find_md5("xx2fdf093688bb7cef7c05b1ffcc71ff4e00") == 2U);
+  TEST_CHECK_TRUE(tftp::find_md5("2fdf093688bb7cef7c05b1ffcc71ff4 e") == npos);
+  TEST_CHECK_TRUE(tftp::find_md5("") == npos);
+}
+
 START_ITER("Check get uid/gid by name")
 {
   TEST_CHECK_TRUE(tftp::get_uid_by_name("root") == 0U);
@@ -0,0 +1,120 @@
+/**
+ * \file tftpControl_test.cpp
+ * \brief Unit-tests for class ControlServer
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "test.h"
+#include "../tftpControl.h"
+
+UNIT_TEST_SUITE_BEGIN(Control)
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("Split command line")
+{
+  auto words = tftp::ControlServer::split("  kill\t 12 \r");
+  TEST_CHECK_TRUE(words.size() == 2U);
+  TEST_CHECK_TRUE(words[0U] == "kill");
+  TEST_CHECK_TRUE(words[1U] == "12");
+
+  TEST_CHECK_TRUE(tftp::ControlServer::split("").empty());
+  TEST_CHECK_TRUE(tftp::ControlServer::split("   ").empty());
+}
+
+START_ITER("Command via Unix socket")
+{
+  const std::string path{"/tmp/server-fw-test-control.sock"};
+  tftp::ControlServer srv{path};
+  TEST_CHECK_TRUE(std::get<0>(srv.open()));
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U); // no clients
+
+  struct stat st;
+  TEST_CHECK_TRUE(stat(path.c_str(), & st) == 0);
+  TEST_CHECK_TRUE((st.st_mode & 0777) == 0600);
+
+  int client = socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  path.copy(addr.sun_path, path.size());
+  TEST_CHECK_TRUE(connect(client, (struct sockaddr *) & addr, sizeof(addr)) == 0);
+  TEST_CHECK_TRUE(write(client, "kill 7\n", 7) == 7);
+
+  std::vector<std::string> got;
+  TEST_CHECK_TRUE(srv.serve([&](const std::vector<std::string> & cmd)
+      {
+        got = cmd;
+        return std::string{"OK\n"};
+      }) == 1U);
+
+  std::string resp;
+  std::array<char, 256U> buf;
+  ssize_t res;
+  while((res = read(client, buf.data(), buf.size())) > 0) resp.append(buf.data(), res);
+  close(client);
+
+  TEST_CHECK_TRUE(got.size() == 2U);
+  TEST_CHECK_TRUE(got[0U] == "kill");
+  TEST_CHECK_TRUE(got[1U] == "7");
+  TEST_CHECK_TRUE(resp == "OK\n");
+
+  // Silent client not block server loop; served after command
+  client = socket(AF_UNIX, SOCK_STREAM, 0);
+  TEST_CHECK_TRUE(connect(client, (struct sockaddr *) & addr, sizeof(addr)) == 0);
+  auto begin = std::chrono::steady_clock::now();
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U);
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U);
+  TEST_CHECK_TRUE(std::chrono::steady_clock::now() - begin <
+                  std::chrono::milliseconds{tftp::constants::control_client_timeout_ms / 2});
+  TEST_CHECK_TRUE(write(client, "list", 4) == 4);
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U); // line not finished
+  TEST_CHECK_TRUE(write(client, "\n", 1) == 1);
+  TEST_CHECK_TRUE(srv.serve([&](const std::vector<std::string> & cmd)
+      {
+        got = cmd;
+        return std::string{"OK\n"};
+      }) == 1U);
+  TEST_CHECK_TRUE((got.size() == 1U) && (got[0U] == "list"));
+  close(client);
+}
+
+START_ITER("Not socket file at path kept")
+{
+  const std::string path{"/tmp/server-fw-test-control.file"};
+  {
+    std::ofstream file{path};
+    file << "data" << std::endl;
+  }
+
+  {
+    tftp::ControlServer srv{path};
+    auto [ok, err] = srv.open();
+    TEST_CHECK_FALSE(ok);
+    TEST_CHECK_TRUE(err == EEXIST);
+  }
+
+  struct stat st;
+  TEST_CHECK_TRUE(lstat(path.c_str(), & st) == 0);
+  TEST_CHECK_TRUE(S_ISREG(st.st_mode));
+  unlink(path.c_str());
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
@@ -10,8 +10,11 @@
  *  \version 0.2.1
  */
 
+#include <fcntl.h>
+
 #include "test.h"
 #include "../tftpDataMgrFile.h"
+#include "../tftpBlockCache.h"
 #include "tftpOptions_test.h"
 
 UNIT_TEST_SUITE_BEGIN(DataMgrFile)
@@ -83,7 +86,7 @@ START_ITER("write() check - store data files");
     if(init_res)
     {
       size_t block=512;
-      std::vector<char> buff(block, 0);
+      tftp::SmBuf buff(block, 0);
 
       for(size_t stage=0; stage*block < file_sizes[iter]; ++stage)
       {
@@ -94,8 +97,8 @@ START_ITER("write() check - store data files");
 
         success_file_rx =
             success_file_rx &&
-            (dm.write(buff.begin(),
-                   buff.begin()+left_size,
+            (dm.write(buff.data(),
+                   left_size,
                    stage*block) >= 0);
       }
       TEST_CHECK_TRUE(success_file_rx);
@@ -124,10 +127,7 @@ START_ITER("write() check - store data files");
       std::string md5_file{md5_as_str(& file_md5[iter][0])};
       md5_file.append(" ").append(curr_file_name);
 
-      TEST_CHECK_TRUE(dm.write(
-          static_cast<tftp::Buf::iterator>(& *md5_file.begin()),
-          static_cast<tftp::Buf::iterator>(& *md5_file.end()),
-          0) >= 0);
+      TEST_CHECK_TRUE(dm.write(md5_file.data(), md5_file.size(), 0) >= 0);
 
       TEST_CHECK_TRUE(dm.active());
       dm.close();
@@ -174,7 +174,7 @@ START_ITER("read() check - read data files by name");
     {
       size_t block=512;
       std::vector<char> buff_ethalon(block, 0);
-      std::vector<char> buff_checked(block, 0);
+      tftp::SmBuf buff_checked(block, 0);
 
       for(size_t stage = 0; stage * block < file_sizes[iter]; ++stage)
       {
@@ -228,7 +228,7 @@ START_ITER("tx() check - read data files by md5");
     {
       size_t block=512;
       std::vector<char> buff_ethalon(block, 0);
-      std::vector<char> buff_checked(block, 0);
+      tftp::SmBuf buff_checked(block, 0);
 
       for(size_t stage = 0; stage * block < file_sizes[iter]; ++stage)
       {
@@ -257,6 +257,131 @@ START_ITER("tx() check - read data files by md5");
   }
 }
 
+START_ITER("read() check - read data files via block cache");
+{
+  auto cache = std::make_shared<tftp::BlockCache>(1024U*1024U);
+
+  for(size_t pass=0; pass < 2U; ++pass)
+  {
+    for(size_t iter=0; iter < file_sizes.size(); ++iter)
+    {
+      DataMgr_test dm;
+      dm.settings_->root_dir.assign(local_dir);
+      dm.settings_->block_cache_ = cache;
+
+      Options::Options_test opt;
+      opt.request_type_ = tftp::SrvReq::read;
+      opt.filename_ = "file"+std::to_string(iter+1);
+
+      bool init_res;
+      TEST_CHECK_TRUE(init_res = dm.init(dm.settings_, nullptr, opt));
+      if(!init_res) continue;
+
+      size_t block=1024;
+      bool success = true;
+      std::vector<char> buff_ethalon(block, 0);
+      tftp::SmBuf buff_checked(block, 0);
+
+      for(size_t stage = 0; stage * block < file_sizes[iter]; ++stage)
+      {
+        size_t left_size = std::min(file_sizes[iter] - stage * block, block);
+        fill_buffer(buff_ethalon.data(), left_size, stage * block, iter);
+
+        success = success &&
+            (dm.read(buff_checked.begin(),
+                     buff_checked.end(),
+                     stage * block) == (ssize_t)left_size) &&
+            std::equal(buff_ethalon.cbegin(),
+                       buff_ethalon.cbegin() + left_size,
+                       buff_checked.cbegin());
+      }
+      TEST_CHECK_TRUE(success);
+
+      dm.close();
+    }
+  }
+
+  auto [hits, misses] = cache->stat();
+  TEST_CHECK_TRUE(hits > misses);
+  TEST_CHECK_TRUE(cache->size() > 0U);
+}
+
+START_ITER("read_blocks() check - read window of blocks");
+{
+  for(size_t iter=0; iter < file_sizes.size(); ++iter)
+  {
+    DataMgr_test dm;
+    dm.settings_->root_dir.assign(local_dir);
+
+    Options::Options_test opt;
+    opt.request_type_ = tftp::SrvReq::read;
+    opt.filename_ = "file"+std::to_string(iter+1);
+
+    bool init_res;
+    TEST_CHECK_TRUE(init_res = dm.init(dm.settings_, nullptr, opt));
+    if(!init_res) continue;
+
+    constexpr size_t block = 512U;
+    constexpr size_t window = 4U;
+    bool success = true;
+    std::vector<char> buff_ethalon(block, 0);
+    std::vector<tftp::SmBufEx> pkts(window, tftp::SmBufEx{block + 4U});
+
+    std::vector<tftp::BlkSlot> slots;
+    for(auto & pkt : pkts) slots.emplace_back(pkt.begin()+4U, pkt.end());
+
+    for(size_t pos = 0U; pos <= file_sizes[iter]; pos += block * window)
+    {
+      size_t need_size = std::min(file_sizes[iter] - pos, block * window);
+      success = success &&
+          (dm.read_blocks(slots, pos) == (ssize_t)need_size);
+
+      for(size_t blk = 0U; blk * block < need_size; ++blk)
+      {
+        size_t left_size = std::min(need_size - blk * block, block);
+        fill_buffer(buff_ethalon.data(), left_size, pos + blk * block, iter);
+        success = success &&
+            std::equal(buff_ethalon.cbegin(),
+                       buff_ethalon.cbegin() + left_size,
+                       pkts[blk].cbegin() + 4U);
+      }
+    }
+    TEST_CHECK_TRUE(success);
+
+    dm.close();
+  }
+}
+
+START_ITER("shared file descriptor");
+{
+  Path file{local_dir};
+  file /= "file1";
+
+  auto [f1, e1] = tftp::FileFd::get(file.string());
+  auto [f2, e2] = tftp::FileFd::get(file.string());
+  TEST_CHECK_TRUE(f1 != nullptr);
+  TEST_CHECK_TRUE(f1 == f2);
+  TEST_CHECK_TRUE(f1->size() == file_sizes[0U]);
+  TEST_CHECK_TRUE(e1 == 0);
+
+  auto [f3, e3] = tftp::FileFd::get(file.string()+"_not_exist");
+  TEST_CHECK_TRUE(f3 == nullptr);
+  TEST_CHECK_TRUE(e3 == ENOENT);
+
+  // Closed after release of all owners and opened again
+  int old_fd = f1->fd();
+  f1.reset();
+  TEST_CHECK_TRUE(fcntl(old_fd, F_GETFD) >= 0);
+  f2.reset();
+  TEST_CHECK_TRUE(fcntl(old_fd, F_GETFD) < 0);
+  auto [f4, e4] = tftp::FileFd::get(file.string());
+  TEST_CHECK_TRUE(f4 != nullptr);
+  TEST_CHECK_TRUE(e4 == 0);
+  TEST_CHECK_TRUE(f4->size() == file_sizes[0U]);
+  auto [f5, e5] = tftp::FileFd::get(file.string());
+  TEST_CHECK_TRUE(f4 == f5);
+}
+
 // delete temporary files
 unit_tests::files_delete();
 
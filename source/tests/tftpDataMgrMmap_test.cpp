@@ -0,0 +1,162 @@
+/**
+ * \file tftpDataMgrMmap_test.cpp
+ * \brief Unit-tests for class DataMgrMmap
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fstream>
+
+#include "test.h"
+#include "../tftpDataMgrMmap.h"
+#include "tftpOptions_test.h"
+
+UNIT_TEST_SUITE_BEGIN(DataMgrMmap)
+
+using namespace unit_tests;
+
+//------------------------------------------------------------------------------
+
+/** \brief Helper class for access to DataMgrMmap protected fields
+ */
+class DataMgrMmap_test: public tftp::DataMgrMmap
+{
+public:
+
+  using tftp::DataMgrMmap::settings_;
+  using tftp::DataMgrMmap::map_;
+};
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(read_check, "check read() from mapping")
+
+// Prepare
+TEST_CHECK_TRUE(check_local_directory());
+
+constexpr std::array<size_t, 4U> sizes{0U, 1U, 512U, 100000U};
+
+for(size_t iter=0U; iter < sizes.size(); ++iter)
+{
+  std::vector<char> data(sizes[iter], 0);
+  fill_buffer(data.data(), data.size(), 0U, iter);
+
+  Path file{local_dir};
+  file /= "mmap_file"+std::to_string(iter);
+  std::ofstream{file, std::ios::binary}.write(data.data(), data.size());
+}
+
+START_ITER("read files by name");
+{
+  for(size_t iter=0U; iter < sizes.size(); ++iter)
+  {
+    DataMgrMmap_test dm;
+    dm.settings_->root_dir.assign(local_dir.string());
+    TEST_CHECK_FALSE(dm.active());
+
+    Options::Options_test opt;
+    opt.request_type_ = tftp::SrvReq::read;
+    opt.filename_ = "mmap_file"+std::to_string(iter);
+
+    bool init_res;
+    TEST_CHECK_TRUE(init_res = dm.init(dm.settings_, nullptr, opt));
+    if(!init_res) continue;
+
+    TEST_CHECK_TRUE(dm.active());
+    TEST_CHECK_TRUE(dm.map_ != nullptr);
+
+    size_t block = 512U;
+    bool success = true;
+    std::vector<char> buff_ethalon(block, 0);
+    tftp::SmBufEx buff_checked(block);
+
+    for(size_t stage = 0U; stage * block <= sizes[iter]; ++stage)
+    {
+      size_t left_size = sizes[iter] - stage * block;
+      if(left_size > block) left_size = block;
+
+      fill_buffer(buff_ethalon.data(), left_size, stage * block, iter);
+
+      success = success &&
+          (dm.read(buff_checked.begin(),
+                   buff_checked.end(),
+                   stage * block) == (ssize_t)left_size) &&
+          std::equal(buff_ethalon.cbegin(),
+                     buff_ethalon.cbegin() + left_size,
+                     buff_checked.cbegin());
+    }
+    TEST_CHECK_TRUE(success);
+
+    // Window of 3 blocks
+    std::vector<tftp::SmBufEx> pkts(3U, tftp::SmBufEx{block});
+    std::vector<tftp::BlkSlot> slots;
+    for(auto & pkt : pkts) slots.emplace_back(pkt.begin(), pkt.end());
+
+    size_t need_size = std::min(sizes[iter], 3U * block);
+    TEST_CHECK_TRUE(dm.read_blocks(slots, 0U) == (ssize_t)need_size);
+
+    std::vector<char> window_ethalon(need_size, 0);
+    fill_buffer(window_ethalon.data(), need_size, 0U, iter);
+    success = true;
+    for(size_t pos = 0U; pos < need_size; ++pos)
+    {
+      success = success &&
+          (window_ethalon[pos] == pkts[pos / block][pos % block]);
+    }
+    TEST_CHECK_TRUE(success);
+
+    // Past end of file and wrapped position ((stage - 1) * block at stage 0)
+    TEST_CHECK_TRUE(dm.read(buff_checked.begin(),
+                            buff_checked.end(),
+                            sizes[iter] + block) == 0);
+    TEST_CHECK_TRUE(dm.read(buff_checked.begin(),
+                            buff_checked.end(),
+                            (size_t) 0U - block) == -1);
+    TEST_CHECK_TRUE(dm.read_blocks(slots, sizes[iter] + block) == 0);
+    TEST_CHECK_TRUE(dm.read_blocks(slots, (size_t) 0U - block) == -1);
+
+    dm.close();
+    TEST_CHECK_FALSE(dm.active());
+  }
+}
+
+START_ITER("shared mapping");
+{
+  Path file{local_dir};
+  file /= "mmap_file3";
+
+  auto [m1, e1] = tftp::MmapFile::get(file.string());
+  auto [m2, e2] = tftp::MmapFile::get(file.string());
+  TEST_CHECK_TRUE(m1 != nullptr);
+  TEST_CHECK_TRUE(m1 == m2);
+  TEST_CHECK_TRUE(m1->size() == sizes[3U]);
+  TEST_CHECK_TRUE(e1 == 0);
+
+  auto [m3, e3] = tftp::MmapFile::get(file.string()+"_not_exist");
+  TEST_CHECK_TRUE(m3 == nullptr);
+  TEST_CHECK_TRUE(e3 == ENOENT);
+
+  // Mapped again after release of all owners
+  m1.reset();
+  m2.reset();
+  auto [m4, e4] = tftp::MmapFile::get(file.string());
+  TEST_CHECK_TRUE(m4 != nullptr);
+  TEST_CHECK_TRUE(e4 == 0);
+  TEST_CHECK_TRUE(m4->size() == sizes[3U]);
+  auto [m5, e5] = tftp::MmapFile::get(file.string());
+  TEST_CHECK_TRUE(m4 == m5);
+}
+
+// delete temporary files
+files_delete();
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
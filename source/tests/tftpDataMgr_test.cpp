@@ -39,8 +39,8 @@ public:
       const tftp::Options & opt) override { set_error_ = cb_error; return true; };
 
   virtual auto write(
-      tftp::SmBufEx::const_iterator buf_begin,
-      tftp::SmBufEx::const_iterator buf_end,
+      const char * data,
+      size_t data_size,
       const size_t & position) -> ssize_t override { return 0; };
 
   virtual auto read(
@@ -0,0 +1,173 @@
+/**
+ * \file tftpLogRing_test.cpp
+ * \brief Unit-tests for class LogWriter
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fstream>
+
+#include "test.h"
+#include "../tftpLogRing.h"
+
+UNIT_TEST_SUITE_BEGIN(LogRing)
+
+//------------------------------------------------------------------------------
+
+/// Writer collect messages instead of syslog
+class LogWriter_test: public tftp::LogWriter
+{
+public:
+  std::mutex msg_mutex;
+  std::vector<std::string> msgs;
+
+  void write(const Entry & entry) override
+  {
+    std::lock_guard lk{msg_mutex};
+    msgs.emplace_back(entry.text.data(), entry.size);
+  }
+
+  virtual ~LogWriter_test()
+  {
+    flush(); // before base destructor (virtual write not available there)
+  }
+
+  auto first_ring() -> std::weak_ptr<Ring>
+  {
+    std::lock_guard lk{mutex_};
+    return rings_.front();
+  }
+
+  /// Wait count of written messages (without flush)
+  bool wait_msgs(size_t count, int timeout_ms)
+  {
+    for(int iter = 0; iter < timeout_ms; ++iter)
+    {
+      {
+        std::lock_guard lk{msg_mutex};
+        if(msgs.size() >= count) return true;
+      }
+      usleep(1000);
+    }
+    return false;
+  }
+};
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("Messages from many threads")
+{
+  LogWriter_test w;
+
+  constexpr size_t thr_count = 4U;
+  constexpr size_t msg_count = 100U;
+  std::vector<std::thread> threads;
+  for(size_t thr = 0U; thr < thr_count; ++thr)
+  {
+    threads.emplace_back([&w, thr]()
+        {
+          for(size_t iter = 0U; iter < msg_count; ++iter)
+          {
+            while(!w.push(tftp::LogLvl::info,
+                          "thread "+std::to_string(thr)+
+                          " msg "+std::to_string(iter))) usleep(100);
+          }
+        });
+  }
+  for(auto & thr : threads) thr.join();
+  w.flush();
+
+  auto [written, dropped] = w.stat();
+  TEST_CHECK_TRUE(written == thr_count * msg_count);
+  std::lock_guard lk{w.msg_mutex};
+  TEST_CHECK_TRUE(w.msgs.size() == thr_count * msg_count);
+  TEST_CHECK_TRUE(std::count(w.msgs.begin(), w.msgs.end(), "thread 2 msg 99") == 1);
+}
+
+START_ITER("Full ring drops and long message truncated")
+{
+  LogWriter_test w;
+  {
+    std::lock_guard lk{w.msg_mutex}; // writer thread blocked in write()
+    std::thread thr([&w]()
+        {
+          for(size_t iter = 0U; iter < 2U*tftp::constants::log_ring_entries; ++iter)
+          {
+            w.push(tftp::LogLvl::debug, std::string(1000U, 'a'));
+          }
+        });
+    thr.join();
+  }
+  w.flush();
+
+  auto [written, dropped] = w.stat();
+  TEST_CHECK_TRUE(dropped > 0U);
+  TEST_CHECK_TRUE(written + dropped == 2U*tftp::constants::log_ring_entries);
+  std::lock_guard lk{w.msg_mutex};
+  TEST_CHECK_TRUE(w.msgs.size() == written);
+  TEST_CHECK_TRUE(w.msgs[0U].size() == tftp::constants::log_ring_msg_size - 1U);
+}
+
+START_ITER("Idle writer woken by new message")
+{
+  LogWriter_test w;
+  w.push(tftp::LogLvl::info, "first");
+  TEST_CHECK_TRUE(w.wait_msgs(1U, 1000));
+
+  usleep(20000); // writer thread sleeping
+  w.push(tftp::LogLvl::info, "second");
+  TEST_CHECK_TRUE(w.wait_msgs(2U, 1000));
+}
+
+START_ITER("Ring of living thread released with writer")
+{
+  std::weak_ptr<tftp::LogWriter::Ring> weak;
+  {
+    LogWriter_test w;
+    w.push(tftp::LogLvl::info, "msg");
+    weak = w.first_ring();
+    TEST_CHECK_FALSE(weak.expired());
+  }
+  TEST_CHECK_TRUE(weak.expired());
+
+  // Next writer in same thread work after expired entry
+  LogWriter_test w;
+  TEST_CHECK_TRUE(w.push(tftp::LogLvl::info, "next"));
+  w.flush();
+  TEST_CHECK_TRUE(std::get<0>(w.stat()) == 1U);
+}
+
+START_ITER("Lines to file")
+{
+  const std::string file_name{"/tmp/server-fw-test-lines.log"};
+  unlink(file_name.c_str());
+  {
+    tftp::LogFileWriter w{file_name};
+    TEST_CHECK_TRUE(w.is_open());
+    w.push(tftp::LogLvl::info, "{\"line\":1}");
+    w.push(tftp::LogLvl::info, "{\"line\":2}");
+  } // rest written by destructor
+
+  std::ifstream in{file_name};
+  std::string line1, line2;
+  std::getline(in, line1);
+  std::getline(in, line2);
+  TEST_CHECK_TRUE(line1 == "{\"line\":1}");
+  TEST_CHECK_TRUE(line2 == "{\"line\":2}");
+  unlink(file_name.c_str());
+
+  TEST_CHECK_FALSE(tftp::LogFileWriter{"/not_exist_dir/file"}.is_open());
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
@@ -0,0 +1,164 @@
+/**
+ * \file tftpLookupCache_test.cpp
+ * \brief Unit-tests for class LookupCache
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fstream>
+#include <unistd.h>
+
+#include "test.h"
+#include "../tftpLookupCache.h"
+
+UNIT_TEST_SUITE_BEGIN(LookupCache)
+
+using namespace unit_tests;
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("Positive and negative results")
+{
+  tftp::LookupCache c{10U, 100};
+  TEST_CHECK_TRUE(c.enabled());
+
+  TEST_CHECK_TRUE(std::get<0>(c.find("file1")) == tftp::TripleResult::nop);
+
+  c.insert("file1", c.generation(), true, "/dir/file1");
+  c.insert("file2", c.generation(), false, "/dir/file2");
+  TEST_CHECK_TRUE(c.size() == 2U);
+
+  auto [r1, p1] = c.find("file1");
+  TEST_CHECK_TRUE(r1 == tftp::TripleResult::ok);
+  TEST_CHECK_TRUE(p1 == "/dir/file1");
+
+  auto [r2, p2] = c.find("file2");
+  TEST_CHECK_TRUE(r2 == tftp::TripleResult::fail);
+  TEST_CHECK_TRUE(p2 == "");
+
+  auto [hits, misses] = c.stat();
+  TEST_CHECK_TRUE(hits == 2U);
+  TEST_CHECK_TRUE(misses == 1U);
+
+  c.erase("file1");
+  TEST_CHECK_TRUE(std::get<0>(c.find("file1")) == tftp::TripleResult::nop);
+  TEST_CHECK_TRUE(c.size() == 1U);
+
+  c.clear();
+  TEST_CHECK_TRUE(c.size() == 0U);
+}
+
+START_ITER("Bounded size")
+{
+  tftp::LookupCache c{3U, 100};
+
+  for(size_t iter=0U; iter < 5U; ++iter)
+  {
+    c.insert("file"+std::to_string(iter), c.generation(), false);
+  }
+  TEST_CHECK_TRUE(c.size() == 3U);
+  TEST_CHECK_TRUE(std::get<0>(c.find("file0")) == tftp::TripleResult::nop);
+  TEST_CHECK_TRUE(std::get<0>(c.find("file1")) == tftp::TripleResult::nop);
+  TEST_CHECK_TRUE(std::get<0>(c.find("file4")) == tftp::TripleResult::fail);
+}
+
+START_ITER("Disabled cache")
+{
+  tftp::LookupCache c0{0U, 100};
+  TEST_CHECK_FALSE(c0.enabled());
+  c0.insert("file", c0.generation(), true, "/file");
+  TEST_CHECK_TRUE(std::get<0>(c0.find("file")) == tftp::TripleResult::nop);
+
+  tftp::LookupCache c1{10U, 0};
+  TEST_CHECK_FALSE(c1.enabled());
+}
+
+START_ITER("Time to live")
+{
+  tftp::LookupCache c{10U, 1};
+  c.insert("file", c.generation(), true, "/file");
+  TEST_CHECK_TRUE(std::get<0>(c.find("file")) == tftp::TripleResult::ok);
+  sleep(1);
+  TEST_CHECK_TRUE(std::get<0>(c.find("file")) == tftp::TripleResult::nop);
+  TEST_CHECK_TRUE(c.size() == 0U);
+}
+
+START_ITER("Result of lookup started before drop not stored")
+{
+  tftp::LookupCache c{10U, 100};
+
+  auto gen = c.generation();
+  c.clear(); // directory changed while lookup
+  c.insert("file", gen, false);
+  TEST_CHECK_TRUE(std::get<0>(c.find("file")) == tftp::TripleResult::nop);
+
+  gen = c.generation();
+  c.erase("file"); // file created by WRQ while lookup
+  c.insert("file", gen, false);
+  TEST_CHECK_TRUE(std::get<0>(c.find("file")) == tftp::TripleResult::nop);
+
+  c.insert("file", c.generation(), false);
+  TEST_CHECK_TRUE(std::get<0>(c.find("file")) == tftp::TripleResult::fail);
+}
+
+START_ITER("Invalidate on directory change")
+{
+  TEST_CHECK_TRUE(check_local_directory());
+
+  tftp::LookupCache c{10U, 100};
+  const std::string dir{local_dir.string()};
+  c.watch(dir);
+  auto gen = c.generation();
+  c.insert("new_file", gen, false, "", {dir});
+  c.insert("other_file", gen, false, "", {dir});
+  TEST_CHECK_TRUE(std::get<0>(c.find("new_file")) == tftp::TripleResult::fail);
+
+  Path new_file{local_dir};
+  new_file /= "new_file";
+  std::ofstream{new_file}.close();
+
+  size_t wait_cnt = 0U;
+  while((c.size() > 1U) && (++wait_cnt < 100U)) usleep(10000);
+
+  TEST_CHECK_TRUE(std::get<0>(c.find("new_file")) == tftp::TripleResult::nop);
+  TEST_CHECK_TRUE(c.generation() != gen);
+
+  // Other names of directory kept
+  TEST_CHECK_TRUE(std::get<0>(c.find("other_file")) == tftp::TripleResult::fail);
+
+  files_delete();
+}
+
+START_ITER("Not existing directory not watched; lookup in it not cached")
+{
+  TEST_CHECK_TRUE(check_local_directory());
+
+  tftp::LookupCache c{10U, 100};
+  const std::string dir{local_dir.string()};
+  const std::string sub{(local_dir / "no_such_dir").string()};
+  c.watch(dir); // start watcher
+  c.watch(sub);
+  c.insert("no_such_dir/file", c.generation(), false, "", {sub});
+  TEST_CHECK_TRUE(c.size() == 0U);
+
+  // Directory created - watched at next lookup
+  filesystem::create_directory(sub);
+  c.watch(sub);
+  c.insert("no_such_dir/file", c.generation(), false, "", {sub});
+  TEST_CHECK_TRUE(std::get<0>(c.find("no_such_dir/file")) == tftp::TripleResult::fail);
+
+  filesystem::remove_all(sub);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
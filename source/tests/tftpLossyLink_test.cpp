@@ -0,0 +1,212 @@
+/**
+ * \file tftpLossyLink_test.cpp
+ * \brief Unit-tests for class LossyLink
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "test.h"
+#include "../tools/tftpLossyLink.h"
+
+UNIT_TEST_SUITE_BEGIN(LossyLink)
+
+//------------------------------------------------------------------------------
+
+/** \brief UDP socket on loopback (any free port)
+ */
+struct Peer
+{
+  int sock;
+  tftp::Addr addr;
+
+  Peer()
+  {
+    addr.set_string("127.0.0.1:0");
+    sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    bind(sock, addr.as_sockaddr_ptr(), addr.data_size());
+    getsockname(sock, addr.as_sockaddr_ptr(), & addr.data_size());
+  }
+
+  ~Peer() { close(sock); }
+
+  void send(const tftp::Addr & to, std::string_view data)
+  {
+    tftp::Addr dst{to};
+    sendto(sock, data.data(), data.size(), 0, dst.as_sockaddr_ptr(), dst.data_size());
+  }
+
+  /// Receive packet (empty if timeout)
+  auto recv(int timeout_ms, tftp::Addr * from = nullptr) -> std::string
+  {
+    struct pollfd pfd{sock, POLLIN, 0};
+    if(poll(& pfd, 1, timeout_ms) <= 0) return {};
+
+    std::array<char, 1024U> buf;
+    tftp::Addr src;
+    src.data_size() = src.size();
+    ssize_t size = recvfrom(sock, buf.data(), buf.size(), 0,
+                            src.as_sockaddr_ptr(), & src.data_size());
+    if(from) *from = src;
+    return (size > 0) ? std::string(buf.data(), (size_t) size) : std::string{};
+  }
+};
+
+/** \brief Link with access to protected members
+ */
+class LossyLink_test: public tftp::LossyLink
+{
+public:
+  using tftp::LossyLink::LossyLink;
+  using tftp::LossyLink::flow_idle_;
+};
+
+/** \brief Start link to server with impairments
+ */
+static void link_start(tftp::LossyLink & link)
+{
+  tftp::Addr listen;
+  listen.set_string("127.0.0.1:0");
+  TEST_CHECK_TRUE(std::get<0>(link.open(listen)));
+  TEST_CHECK_TRUE(link.local().port() != 0U);
+  link.start();
+}
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("Clean link; server reply from transfer port (TID)")
+{
+  Peer server;
+  Peer server_tid;
+  Peer client;
+
+  tftp::LossyLink link{server.addr, tftp::Impairment{}};
+  link_start(link);
+
+  client.send(link.local(), "request");
+  tftp::Addr proxy_up;
+  TEST_CHECK_TRUE(server.recv(1000, & proxy_up) == "request");
+
+  // Reply from other port of server
+  server_tid.send(proxy_up, "reply");
+  tftp::Addr from;
+  TEST_CHECK_TRUE(client.recv(1000, & from) == "reply");
+  TEST_CHECK_TRUE(from.port() == link.local().port());
+
+  // Next client packets go to transfer port
+  client.send(link.local(), "ack");
+  TEST_CHECK_TRUE(server_tid.recv(1000) == "ack");
+  TEST_CHECK_TRUE(server.recv(50).empty());
+
+  // Other port of server ignored after TID known
+  server.send(proxy_up, "alien");
+  TEST_CHECK_TRUE(client.recv(50).empty());
+
+  auto st = link.stat();
+  TEST_CHECK_TRUE(st.forwarded == 3U);
+  TEST_CHECK_TRUE(st.dropped == 0U);
+}
+
+START_ITER("Full loss")
+{
+  Peer server;
+  Peer client;
+
+  tftp::Impairment imp;
+  imp.loss = 1.0;
+  tftp::LossyLink link{server.addr, imp};
+  link_start(link);
+
+  for(size_t iter = 0U; iter < 5U; ++iter) client.send(link.local(), "lost");
+  TEST_CHECK_TRUE(server.recv(100).empty());
+  TEST_CHECK_TRUE(link.stat().dropped == 5U);
+  TEST_CHECK_TRUE(link.stat().forwarded == 0U);
+}
+
+START_ITER("Duplication")
+{
+  Peer server;
+  Peer client;
+
+  tftp::Impairment imp;
+  imp.duplicate = 1.0;
+  tftp::LossyLink link{server.addr, imp};
+  link_start(link);
+
+  client.send(link.local(), "twice");
+  TEST_CHECK_TRUE(server.recv(1000) == "twice");
+  TEST_CHECK_TRUE(server.recv(1000) == "twice");
+  TEST_CHECK_TRUE(server.recv(50).empty());
+  TEST_CHECK_TRUE(link.stat().duplicated == 1U);
+}
+
+START_ITER("Delay")
+{
+  Peer server;
+  Peer client;
+
+  tftp::Impairment imp;
+  imp.delay_ms = 50U;
+  tftp::LossyLink link{server.addr, imp};
+  link_start(link);
+
+  auto begin = std::chrono::steady_clock::now();
+  client.send(link.local(), "late");
+  TEST_CHECK_TRUE(server.recv(1000) == "late");
+  TEST_CHECK_TRUE(std::chrono::steady_clock::now() - begin >=
+                  std::chrono::milliseconds{50});
+}
+
+START_ITER("Reorder")
+{
+  Peer server;
+  Peer client;
+
+  tftp::Impairment imp;
+  imp.reorder = 0.5;
+  imp.reorder_ms = 20U;
+  tftp::LossyLink link{server.addr, imp};
+  link_start(link);
+
+  // First packet creates flow; next packets sent at once
+  for(char iter = 'a'; iter <= 't'; ++iter) client.send(link.local(), {& iter, 1U});
+
+  std::string got;
+  for(std::string pkt; (pkt = server.recv(200)).size();) got += pkt;
+  TEST_CHECK_TRUE(got.size() == 20U);
+  TEST_CHECK_TRUE(link.stat().reordered > 0U);
+  TEST_CHECK_TRUE(!std::is_sorted(got.begin(), got.end()));
+}
+
+START_ITER("Forgotten flow - pending packets dropped")
+{
+  Peer server;
+  Peer client;
+
+  tftp::Impairment imp;
+  imp.delay_ms = 300U;
+  LossyLink_test link{server.addr, imp};
+  link.flow_idle_ = std::chrono::seconds{0};
+  link_start(link);
+
+  client.send(link.local(), "orphan");
+  TEST_CHECK_TRUE(server.recv(600).empty());
+  TEST_CHECK_TRUE(link.stat().dropped == 1U);
+  TEST_CHECK_TRUE(link.stat().forwarded == 0U);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
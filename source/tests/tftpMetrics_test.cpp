@@ -0,0 +1,192 @@
+/**
+ * \file tftpMetrics_test.cpp
+ * \brief Unit-tests for class Metrics
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "test.h"
+#include "../tftpMetrics.h"
+
+UNIT_TEST_SUITE_BEGIN(Metrics)
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("Counters from many threads")
+{
+  auto & m = tftp::Metrics::global();
+  auto before = m.values();
+
+  constexpr size_t thr_count = 4U;
+  constexpr size_t add_count = 1000U;
+  std::vector<std::thread> threads;
+  for(size_t thr = 0U; thr < thr_count; ++thr)
+  {
+    threads.emplace_back([]()
+        {
+          for(size_t iter = 0U; iter < add_count; ++iter)
+          {
+            tftp::Metrics::add(tftp::Metric::bytes_tx, 2U);
+          }
+          tftp::Metrics::error(1U);
+          tftp::Metrics::error(100U); // counted as 0
+          tftp::Metrics::observe(tftp::Hist::lookup, 70U);
+        });
+  }
+  for(auto & thr : threads) thr.join();
+
+  auto after = m.values();
+  auto delta = [&](tftp::Metric metric)
+      { return after.counters[(size_t) metric] -
+               before.counters[(size_t) metric]; };
+
+  TEST_CHECK_TRUE(delta(tftp::Metric::bytes_tx) == 2U * thr_count * add_count);
+  TEST_CHECK_TRUE(delta(tftp::Metric::error_0) == thr_count);
+  TEST_CHECK_TRUE(delta((tftp::Metric) ((size_t) tftp::Metric::error_0 + 1U)) == thr_count);
+
+  const auto & h_before = before.hists[(size_t) tftp::Hist::lookup];
+  const auto & h_after = after.hists[(size_t) tftp::Hist::lookup];
+  const size_t bkt = tftp::Metrics::bucket(70U);
+  TEST_CHECK_TRUE(h_after.buckets[bkt] - h_before.buckets[bkt] == thr_count);
+  TEST_CHECK_TRUE(h_after.sum_us - h_before.sum_us == 70U * thr_count);
+}
+
+START_ITER("Histograms")
+{
+  TEST_CHECK_TRUE(tftp::Metrics::transfer_hist(0U) == tftp::Hist::transfer_64k);
+  TEST_CHECK_TRUE(tftp::Metrics::transfer_hist(65536U) == tftp::Hist::transfer_64k);
+  TEST_CHECK_TRUE(tftp::Metrics::transfer_hist(65537U) == tftp::Hist::transfer_1m);
+  TEST_CHECK_TRUE(tftp::Metrics::transfer_hist(16U*1024U*1024U) == tftp::Hist::transfer_16m);
+  TEST_CHECK_TRUE(tftp::Metrics::transfer_hist(16U*1024U*1024U+1U) == tftp::Hist::transfer_max);
+
+  // Log2 buckets with linear sub-buckets: exact small values, then
+  // relative error not more 1/16
+  TEST_CHECK_TRUE(tftp::Metrics::bucket(0U) == 0U);
+  TEST_CHECK_TRUE(tftp::Metrics::bucket(15U) == 15U);
+  TEST_CHECK_TRUE(tftp::Metrics::bucket_bound(tftp::Metrics::bucket(16U)) == 16U);
+  TEST_CHECK_TRUE(tftp::Metrics::bucket(32U) == tftp::Metrics::bucket(33U));
+  TEST_CHECK_TRUE(tftp::Metrics::bucket(33U) + 1U == tftp::Metrics::bucket(34U));
+  TEST_CHECK_TRUE(tftp::Metrics::bucket(1U << 27U) == tftp::Metrics::bucket_count - 1U);
+  TEST_CHECK_TRUE(tftp::Metrics::bucket((1U << 27U) - 1U) == tftp::Metrics::bucket_count - 2U);
+  bool bounds_ok = true;
+  for(uint64_t val = 1U; val < (1U << 27U); val = val * 3U / 2U + 1U)
+  {
+    auto bkt = tftp::Metrics::bucket(val);
+    auto bound = tftp::Metrics::bucket_bound(bkt);
+    bounds_ok = bounds_ok &&
+        (bound >= val) &&
+        (bound - val <= val / 16U) &&
+        ((bkt == 0U) || (tftp::Metrics::bucket_bound(bkt - 1U) < val));
+  }
+  TEST_CHECK_TRUE(bounds_ok);
+
+  auto & m = tftp::Metrics::global();
+  auto before = m.values();
+
+  tftp::Metrics::observe(tftp::Hist::disk_read, 0U);
+  tftp::Metrics::observe(tftp::Hist::disk_read, 2000U);
+  tftp::Metrics::observe(tftp::Hist::disk_read, 200000000U); // +Inf
+  tftp::Metrics::observe_since(tftp::Hist::block_rtt,
+      std::chrono::steady_clock::now() - std::chrono::seconds{30}, 10U); // ~3 s
+
+  auto after = m.values();
+  auto delta = [&](tftp::Hist hist, size_t bucket)
+      { return after.hists[(size_t) hist].buckets[bucket] -
+               before.hists[(size_t) hist].buckets[bucket]; };
+
+  TEST_CHECK_TRUE(delta(tftp::Hist::disk_read, 0U) == 1U);
+  TEST_CHECK_TRUE(delta(tftp::Hist::disk_read, tftp::Metrics::bucket(2000U)) == 1U);
+  TEST_CHECK_TRUE(delta(tftp::Hist::disk_read, tftp::Metrics::bucket_count - 1U) == 1U);
+  TEST_CHECK_TRUE(delta(tftp::Hist::block_rtt, tftp::Metrics::bucket(3000000U)) == 1U);
+}
+
+START_ITER("Prometheus text")
+{
+  tftp::Metrics::add(tftp::Metric::requests_rrq);
+  tftp::Metrics::observe(tftp::Hist::lookup, 100U); // bucket 100-103 us
+  auto text = tftp::Metrics::global().text();
+
+  TEST_CHECK_TRUE(text.find("# TYPE tftp_requests_total counter\n") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_requests_total{op=\"rrq\"} ") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_errors_total{code=\"8\"} ") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_lookup_duration_seconds_bucket{le=\"0.000103\"} ") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_lookup_duration_seconds_bucket{le=\"0.0001\"} ") == std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_lookup_duration_seconds_bucket{le=\"+Inf\"} ") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_transfer_duration_seconds_bucket{size=\"1MiB\",le=\"+Inf\"} ") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_transfer_duration_seconds_count{size=\"+Inf\"} ") != std::string::npos);
+
+  size_t type_pos = text.find("# TYPE tftp_transfer_duration_seconds histogram\n");
+  TEST_CHECK_TRUE(type_pos != std::string::npos);
+  TEST_CHECK_TRUE(text.find("# TYPE tftp_transfer_duration_seconds", type_pos + 1U) == std::string::npos);
+}
+
+START_ITER("Export via Unix socket")
+{
+  const std::string path{"/tmp/server-fw-test-metrics.sock"};
+  tftp::MetricsServer srv{path};
+  TEST_CHECK_TRUE(std::get<0>(srv.open()));
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U); // no clients
+
+  int client = socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  path.copy(addr.sun_path, path.size());
+  TEST_CHECK_TRUE(connect(client, (struct sockaddr *) & addr, sizeof(addr)) == 0);
+  TEST_CHECK_TRUE(write(client, "GET /metrics HTTP/1.0\r\n\r\n", 25) == 25);
+
+  TEST_CHECK_TRUE(srv.serve([]() { return std::string{"extra_metric 1\n"}; }) == 1U);
+
+  std::string resp;
+  std::array<char, 4096U> buf;
+  ssize_t res;
+  while((res = read(client, buf.data(), buf.size())) > 0) resp.append(buf.data(), res);
+  close(client);
+
+  TEST_CHECK_TRUE(resp.find("HTTP/1.0 200 OK\r\n") == 0U);
+  TEST_CHECK_TRUE(resp.find("tftp_sessions_active ") != std::string::npos);
+  TEST_CHECK_TRUE(resp.find("extra_metric 1\n") != std::string::npos);
+
+  // Silent client not block server loop; served after request
+  client = socket(AF_UNIX, SOCK_STREAM, 0);
+  TEST_CHECK_TRUE(connect(client, (struct sockaddr *) & addr, sizeof(addr)) == 0);
+  auto begin = std::chrono::steady_clock::now();
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U);
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U);
+  TEST_CHECK_TRUE(std::chrono::steady_clock::now() - begin <
+                  std::chrono::milliseconds{tftp::constants::metrics_client_timeout_ms / 2});
+  TEST_CHECK_TRUE(write(client, "GET /metrics HTTP/1.0\r\n", 23) == 23);
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U); // request not finished
+  TEST_CHECK_TRUE(write(client, "\r\n", 2) == 2);
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 1U);
+
+  resp.clear();
+  while((res = read(client, buf.data(), buf.size())) > 0) resp.append(buf.data(), res);
+  close(client);
+  TEST_CHECK_TRUE(resp.find("HTTP/1.0 200 OK\r\n") == 0U);
+
+  // Client without request get response after timeout
+  client = socket(AF_UNIX, SOCK_STREAM, 0);
+  TEST_CHECK_TRUE(connect(client, (struct sockaddr *) & addr, sizeof(addr)) == 0);
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 0U);
+  usleep(tftp::constants::metrics_client_timeout_ms * 1000);
+  TEST_CHECK_TRUE(srv.serve(nullptr) == 1U);
+  close(client);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
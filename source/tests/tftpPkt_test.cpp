@@ -0,0 +1,143 @@
+/**
+ * \file tftpPkt_test.cpp
+ * \brief Unit-tests for TFTP packet encoders
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "test.h"
+#include "tftpOptions_test.h"
+#include "../tftpPkt.h"
+#include "../tftpSmBufView.h"
+
+UNIT_TEST_SUITE_BEGIN(Pkt)
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+// Packets made by push_data() are ethalon
+auto same = [](const tftp::SmBufEx & b1, const tftp::SmBufEx & b2)
+    {
+      return (b1.data_size() == b2.data_size()) &&
+             std::equal(b1.cbegin(),
+                        b1.cbegin() + b1.data_size(),
+                        b2.cbegin());
+    };
+
+START_ITER("Fixed header packets")
+{
+  tftp::SmBufEx b{512U};
+  tftp::SmBufEx e{512U};
+
+  TEST_CHECK_TRUE(tftp::pkt::encode_ack(b, 0x1234U));
+  e.push_data((uint16_t) 4U, (uint16_t) 0x1234U);
+  TEST_CHECK_TRUE(same(b, e));
+
+  e.clear();
+  TEST_CHECK_TRUE(tftp::pkt::encode_data_header(b, 0xFEDCU));
+  e.push_data((uint16_t) 3U, (uint16_t) 0xFEDCU);
+  TEST_CHECK_TRUE(same(b, e));
+
+  e.clear();
+  TEST_CHECK_TRUE(tftp::pkt::encode_error(b, 2U, "Access violation"));
+  e.push_data((uint16_t) 5U, (uint16_t) 2U, "Access violation");
+  TEST_CHECK_TRUE(same(b, e));
+
+  auto [op, field] = tftp::pkt::decode_header(b.data(), b.data_size());
+  TEST_CHECK_TRUE(op == 5U);
+  TEST_CHECK_TRUE(field == 2U);
+  auto [op2, field2] = tftp::pkt::decode_header(b.data(), 3U);
+  TEST_CHECK_TRUE(op2 == 0U);
+  TEST_CHECK_TRUE(field2 == 0U);
+
+  // Small buffer
+  char mem[8U];
+  tftp::SmBufView v{mem, sizeof(mem)};
+  TEST_CHECK_TRUE(tftp::pkt::encode_ack(v, 1U));
+  TEST_CHECK_TRUE(v.data_size() == 4U);
+  TEST_CHECK_FALSE(tftp::pkt::encode_error(v, 1U, "Too long message"));
+  TEST_CHECK_TRUE(v.data_size() == 4U);
+}
+
+START_ITER("Classify received packets")
+{
+  tftp::SmBufEx b{512U};
+  b.push_data((uint16_t) 5U, (uint16_t) 1U, "File not found");
+
+  auto rx = tftp::pkt::classify(b.data(), b.data_size());
+  TEST_CHECK_TRUE(rx.op == tftp::pkt::Op::error);
+  TEST_CHECK_TRUE(rx.field == 1U);
+  TEST_CHECK_TRUE(rx.payload == b.data() + 4U);
+  TEST_CHECK_TRUE(rx.payload_size == b.data_size() - 4U);
+  TEST_CHECK_TRUE(tftp::pkt::to_string(rx, b.data_size()) ==
+                  "Rx pkt [19 octets]: ERROR #1 'File not found'");
+
+  rx = tftp::pkt::classify(b.data(), 5U); // message without zero end
+  TEST_CHECK_TRUE(tftp::pkt::to_string(rx, 5U) ==
+                  "Rx pkt [5 octets]: ERROR #1 'F'");
+
+  b.clear();
+  b.push_data((uint16_t) 4U, (uint16_t) 7U);
+  rx = tftp::pkt::classify(b.data(), b.data_size());
+  TEST_CHECK_TRUE(rx.op == tftp::pkt::Op::ack);
+  TEST_CHECK_TRUE(rx.field == 7U);
+  TEST_CHECK_TRUE(rx.payload_size == 0U);
+
+  TEST_CHECK_TRUE(tftp::pkt::classify(b.data(), 3U).op == tftp::pkt::Op::unknown);
+
+  b.clear();
+  b.push_data((uint16_t) 77U, (uint16_t) 7U);
+  rx = tftp::pkt::classify(b.data(), b.data_size());
+  TEST_CHECK_TRUE(rx.op == tftp::pkt::Op::unknown);
+  TEST_CHECK_TRUE(tftp::pkt::to_string(rx, 4U) ==
+                  "Rx pkt [4 octets]: FAKE tftp packet");
+}
+
+START_ITER("OACK packets")
+{
+  Options::Options_test opt;
+  tftp::SmBufEx b{512U};
+  TEST_CHECK_FALSE(tftp::pkt::encode_oack(b, opt)); // nothing to ack
+
+  opt.blksize_ = {true, 1024};
+  opt.tsize_ = {true, 12345};
+  opt.windowsize_ = {true, 8};
+
+  size_t old_size = tftp::pkt::OackCache::global().size();
+  TEST_CHECK_TRUE(tftp::pkt::encode_oack(b, opt));
+  TEST_CHECK_TRUE(tftp::pkt::encode_oack(b, opt));
+  TEST_CHECK_TRUE(tftp::pkt::OackCache::global().size() == old_size + 1U);
+
+  tftp::SmBufEx e{512U};
+  e.push_data((uint16_t) 6U,
+              "blksize", "1024",
+              "tsize", "12345",
+              "windowsize", "8");
+  TEST_CHECK_TRUE(same(b, e));
+
+  opt.tsize_ = {true, 987654321}; // other file size - same cached layout
+  TEST_CHECK_TRUE(tftp::pkt::encode_oack(b, opt));
+  TEST_CHECK_TRUE(tftp::pkt::OackCache::global().size() == old_size + 1U);
+
+  e.clear();
+  e.push_data((uint16_t) 6U,
+              "blksize", "1024",
+              "tsize", "987654321",
+              "windowsize", "8");
+  TEST_CHECK_TRUE(same(b, e));
+
+  tftp::SmBufEx small{10U};
+  TEST_CHECK_FALSE(tftp::pkt::encode_oack(small, opt));
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
@@ -0,0 +1,166 @@
+/**
+ * \file tftpPreload_test.cpp
+ * \brief Unit-tests for class Preload
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fstream>
+
+#include "test.h"
+#include "../tftpPreload.h"
+#include "../tftpDataMgrFile.h"
+#include "../tftpSettings.h"
+#include "tftpOptions_test.h"
+
+UNIT_TEST_SUITE_BEGIN(Preload)
+
+using namespace unit_tests;
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+// Prepare
+TEST_CHECK_TRUE(check_local_directory());
+
+constexpr std::array<size_t, 3U> sizes{0U, 1000U, 3U*1024U*1024U};
+
+for(size_t iter=0U; iter < sizes.size(); ++iter)
+{
+  std::vector<char> data(sizes[iter], 0);
+  fill_buffer(data.data(), data.size(), 0U, iter);
+
+  Path file{local_dir};
+  file /= "preload_file"+std::to_string(iter);
+  std::ofstream{file, std::ios::binary}.write(data.data(), data.size());
+}
+
+Path manifest{local_dir};
+manifest /= "preload.manifest";
+{
+  std::ofstream out{manifest};
+  out << "# comment" << std::endl
+      << std::endl
+      << "  preload_file0  " << std::endl
+      << "preload_file1" << std::endl
+      << "preload_file2" << std::endl;
+}
+
+START_ITER("Read manifest")
+{
+  auto [ret, entries] = tftp::read_preload_manifest(manifest.string());
+  TEST_CHECK_TRUE(ret);
+  TEST_CHECK_TRUE(entries.size() == 3U);
+  TEST_CHECK_TRUE(entries[0U] == "preload_file0");
+  TEST_CHECK_TRUE(entries[2U] == "preload_file2");
+
+  TEST_CHECK_FALSE(std::get<0>(tftp::read_preload_manifest(
+      manifest.string()+"_not_exist")));
+}
+
+START_ITER("Load and serve preloaded files")
+{
+  auto sett = tftp::Settings::create();
+  sett->root_dir.assign(local_dir.string());
+  TEST_CHECK_TRUE(sett->preload_ == nullptr); // no manifest - no storage
+  sett->preload_ = std::make_shared<tftp::Preload>();
+
+  auto store = sett->preload_;
+  for(size_t iter=0U; iter < sizes.size(); ++iter)
+  {
+    tftp::DataMgrFile dm;
+    auto [found, path] = dm.locate(sett, "preload_file"+std::to_string(iter));
+    TEST_CHECK_TRUE(found);
+
+    auto [img, err] = store->load(path.string());
+    TEST_CHECK_TRUE(img != nullptr);
+    TEST_CHECK_TRUE(err == 0);
+    if(img) TEST_CHECK_TRUE(img->size() == sizes[iter]);
+  }
+
+  auto [cnt, data_size, alloc_size] = store->stat();
+  TEST_CHECK_TRUE(cnt == sizes.size());
+  TEST_CHECK_TRUE(data_size == sizes[0U] + sizes[1U] + sizes[2U]);
+  TEST_CHECK_TRUE(alloc_size >= data_size);
+
+  auto [img_err, err] = store->load(manifest.string()+"_not_exist");
+  TEST_CHECK_TRUE(img_err == nullptr);
+  TEST_CHECK_TRUE(err == ENOENT);
+
+  // Read via data manager
+  for(size_t iter=0U; iter < sizes.size(); ++iter)
+  {
+    tftp::DataMgrFile dm;
+
+    Options::Options_test opt;
+    opt.request_type_ = tftp::SrvReq::read;
+    opt.filename_ = "preload_file"+std::to_string(iter);
+
+    bool init_res;
+    TEST_CHECK_TRUE(init_res = dm.init(sett, nullptr, opt));
+    if(!init_res) continue;
+
+    constexpr size_t block = 4096U;
+    bool success = true;
+    std::vector<char> buff_ethalon(block, 0);
+    tftp::SmBufEx buff_checked(block);
+
+    for(size_t stage = 0U; stage * block <= sizes[iter]; ++stage)
+    {
+      size_t left_size = std::min(sizes[iter] - stage * block, block);
+      fill_buffer(buff_ethalon.data(), left_size, stage * block, iter);
+
+      success = success &&
+          (dm.read(buff_checked.begin(),
+                   buff_checked.end(),
+                   stage * block) == (ssize_t)left_size) &&
+          std::equal(buff_ethalon.cbegin(),
+                     buff_ethalon.cbegin() + left_size,
+                     buff_checked.cbegin());
+    }
+    TEST_CHECK_TRUE(success);
+
+    dm.close();
+  }
+
+  // Changed file not served from memory
+  Path file{local_dir};
+  file /= "preload_file1";
+
+  struct stat st;
+  TEST_CHECK_TRUE(stat(file.c_str(), & st) == 0);
+  TEST_CHECK_TRUE(store->find(file.string(), tftp::file_id(st)) != nullptr);
+
+  std::ofstream{file, std::ios::binary | std::ios::app}.write("x", 1);
+
+  TEST_CHECK_TRUE(stat(file.c_str(), & st) == 0);
+  TEST_CHECK_TRUE(store->find(file.string(), tftp::file_id(st)) == nullptr);
+
+  // Reload: unchanged file shared, changed file loaded again
+  tftp::Preload new_store;
+  Path file0{local_dir};
+  file0 /= "preload_file0";
+  TEST_CHECK_TRUE(stat(file0.c_str(), & st) == 0);
+
+  auto [img0, err0] = new_store.load(file0.string(), store.get());
+  TEST_CHECK_TRUE(img0 == store->find(file0.string(), tftp::file_id(st)));
+
+  auto [img1, err1] = new_store.load(file.string(), store.get());
+  TEST_CHECK_TRUE(img1 != nullptr);
+  if(img1) TEST_CHECK_TRUE(img1->size() == sizes[1U] + 1U);
+}
+
+// delete temporary files
+files_delete();
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
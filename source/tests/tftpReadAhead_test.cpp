@@ -0,0 +1,82 @@
+/**
+ * \file tftpReadAhead_test.cpp
+ * \brief Unit-tests for class ReadAhead
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <unistd.h>
+
+#include "test.h"
+#include "../tftpReadAhead.h"
+
+UNIT_TEST_SUITE_BEGIN(ReadAhead)
+
+using namespace unit_tests;
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("Tasks processed in background");
+{
+  tftp::ReadAhead ra{2U};
+  TEST_CHECK_TRUE(ra.enabled());
+
+  std::vector<std::future<ssize_t>> results;
+  for(ssize_t iter = 0; iter < 10; ++iter)
+  {
+    results.push_back(ra.submit([iter]() { return iter * 10; }));
+  }
+
+  bool success = true;
+  for(ssize_t iter = 0; iter < 10; ++iter)
+  {
+    success = success &&
+        results[iter].valid() &&
+        (results[iter].get() == iter * 10);
+  }
+  TEST_CHECK_TRUE(success);
+}
+
+START_ITER("Disabled read-ahead");
+{
+  tftp::ReadAhead ra{0U};
+  TEST_CHECK_FALSE(ra.enabled());
+  TEST_CHECK_FALSE(ra.submit([]() { return (ssize_t) 1; }).valid());
+}
+
+START_ITER("Counters");
+{
+  tftp::ReadAhead ra;
+  ra.account(true);
+  ra.account(true);
+  ra.account(false);
+
+  auto [hits, misses] = ra.stat();
+  TEST_CHECK_TRUE(hits == 2U);
+  TEST_CHECK_TRUE(misses == 1U);
+}
+
+START_ITER("Queued tasks finished on destroy");
+{
+  std::future<ssize_t> res;
+  {
+    tftp::ReadAhead ra{1U};
+    res = ra.submit([]() { usleep(10000); return (ssize_t) 5; });
+  }
+  TEST_CHECK_TRUE(res.wait_for(std::chrono::seconds(0)) ==
+                  std::future_status::ready);
+  TEST_CHECK_TRUE(res.get() == 5);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
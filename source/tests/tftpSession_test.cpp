@@ -10,9 +10,12 @@
  *  \version 0.2.1
  */
 
+#include <fstream>
+#include <future>
 #include <netinet/in.h>
 
 #include "../tftpCommon.h"
+#include "../tftpReadAhead.h"
 #include "../tftpSession.h"
 #include "test.h"     
 
@@ -28,13 +31,27 @@ UNIT_TEST_SUITE_BEGIN(Session)
 class Session_test: public tftp::Session
 {
 public:
+  using tftp::Session::settings_;
   using tftp::Session::opt_;
   using tftp::Session::stage_;
+  using tftp::Session::construct_data;
   using tftp::Session::cl_addr_;
   using tftp::Session::was_error;
   using tftp::Session::set_error_if_first;
   using tftp::Session::is_window_close;
   using tftp::Session::step_back_window;
+  using tftp::Session::summary_;
+  using tftp::Session::summary_block;
+  using tftp::Session::summary_rtt_begin;
+  using tftp::Session::summary_rtt_end;
+  using tftp::Session::summary_record;
+  using tftp::Session::FlightDir;
+  using tftp::Session::flight_;
+  using tftp::Session::flight_count_;
+  using tftp::Session::flight_dumped_;
+  using tftp::Session::flight_record;
+  using tftp::Session::flight_dump;
+  using tftp::Session::stop_dump_level;
 };
 
 //------------------------------------------------------------------------------
@@ -170,4 +187,180 @@ UNIT_TEST_CASE_END
 
 //------------------------------------------------------------------------------
 
+UNIT_TEST_CASE_BEGIN(sess_read_ahead, "check read-ahead finished before destroy")
+
+  TEST_CHECK_TRUE(check_local_directory());
+  {
+    std::ofstream out{local_dir / "read_ahead.bin", std::ios::binary};
+    std::string data(64U * 1024U, 'r');
+    out.write(data.data(), (std::streamsize) data.size());
+  }
+
+  // One I/O thread busy until gate opened - read-ahead of session queued
+  auto ra = std::make_shared<tftp::ReadAhead>(1U);
+  std::promise<void> gate;
+  std::shared_future<void> gate_wait{gate.get_future()};
+  auto busy = ra->submit([gate_wait]() { gate_wait.wait(); return (ssize_t) 0; });
+
+  auto sess = std::make_unique<Session_test>();
+  sess->settings_->root_dir = local_dir.string();
+  sess->settings_->use_syslog = 0;
+  sess->settings_->read_ahead_ = ra;
+
+  tftp::Addr b_addr;
+  b_addr.set_string("127.0.0.1:6969");
+  tftp::SmBuf b_pkt
+  {
+    0,1,
+    'r','e','a','d','_','a','h','e','a','d','.','b','i','n',0,
+    'o','c','t','e','t',0,
+    'w','i','n','d','o','w','s','i','z','e',0,'4',0
+  };
+  TEST_CHECK_TRUE(sess->prepare(b_addr, b_pkt, b_pkt.size()));
+  TEST_CHECK_TRUE(sess->init());
+
+  sess->stage_ = 1U;
+  TEST_CHECK_TRUE(sess->construct_data().data_size() == 516U);
+
+  // Destroy session without run(); destructor must wait queued task
+  std::atomic_bool destroyed{false};
+  std::thread thr([&]() { sess.reset(); destroyed = true; });
+  usleep(50000);
+  TEST_CHECK_FALSE(destroyed);
+
+  gate.set_value();
+  thr.join();
+  TEST_CHECK_TRUE(destroyed);
+  TEST_CHECK_TRUE(busy.get() == 0);
+
+  filesystem::remove(local_dir / "read_ahead.bin");
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(sess_summary, "check transfer summary")
+
+  Session_test s1;
+
+  tftp::Addr b_addr;
+  b_addr.set_string("1.2.3.4:5678");
+  tftp::SmBuf b_pkt
+  {
+    0,1,
+    'a','"','b',0,
+    'o','c','t','e','t',0,
+  };
+  s1.prepare(b_addr, b_pkt, b_pkt.size());
+
+  for(s1.stage_ = 1U; s1.stage_ <= 3U; ++s1.stage_)
+  {
+    s1.summary_block(s1.stage_ < 3U ? 512U : 100U);
+    s1.summary_rtt_begin();
+    s1.summary_rtt_end();
+  }
+  s1.summary_rtt_begin();
+  s1.summary_rtt_end();
+  s1.summary_rtt_end(); // no reply waiting
+
+  s1.summary_.rtt_skip = true; // after retransmit
+  s1.summary_rtt_begin();
+  s1.summary_rtt_end();
+
+  TEST_CHECK_TRUE(s1.summary_.blocks == 3U);
+  TEST_CHECK_TRUE(s1.summary_.data_bytes == 1124U);
+  TEST_CHECK_TRUE(s1.summary_.rtt_count == 4U);
+  TEST_CHECK_TRUE(s1.summary_.rtt_min_us <= s1.summary_.rtt_max_us);
+
+  auto rec = s1.summary_record();
+  TEST_CHECK_TRUE(rec.find("{\"client\":\"1.2.3.4:5678\",\"op\":\"rrq\",\"file\":\"a\\\"b\"") == 0U);
+  TEST_CHECK_TRUE(rec.find("\"bytes\":1124,\"blocks\":3,") != std::string::npos);
+  TEST_CHECK_TRUE(rec.find("\"samples\":4}") != std::string::npos);
+  TEST_CHECK_TRUE(rec.find("\"result\":\"ok\"") != std::string::npos);
+
+  s1.set_error_if_first(1U, "File not found");
+  rec = s1.summary_record();
+  TEST_CHECK_TRUE(rec.find("\"result\":\"error\",\"error_code\":1,\"error_msg\":\"File not found\"}") != std::string::npos);
+  TEST_CHECK_TRUE(rec.size() < tftp::constants::log_ring_msg_size);
+
+  // Escaped names not overflow record
+  Session_test s2;
+  std::string long_name(200U, '\x01');
+  tftp::SmBuf long_pkt(2U + long_name.size() + 1U + 6U, 0);
+  long_pkt.set_be<uint16_t>(0U, 1U);
+  long_pkt.set_string(2U, long_name, true);
+  long_pkt.set_string(3U + long_name.size(), "octet", true);
+  s2.prepare(b_addr, long_pkt, long_pkt.size());
+  s2.set_error_if_first(0U, std::string(200U, '"'));
+  rec = s2.summary_record();
+  TEST_CHECK_TRUE(rec.size() < tftp::constants::log_ring_msg_size);
+  TEST_CHECK_TRUE(rec.find(",\"file\":\"...\\u0001") != std::string::npos);
+  TEST_CHECK_TRUE(rec.find("\\u0001\",\"path\":") != std::string::npos);
+  TEST_CHECK_TRUE(rec.find(",\"error_msg\":\"...\\\"") != std::string::npos);
+  TEST_CHECK_TRUE(rec.size() >= 2U);
+  if(rec.size() >= 2U) TEST_CHECK_TRUE(rec.compare(rec.size() - 2U, 2U, "\"}") == 0);
+
+  rec = s2.summary_record(300U);
+  TEST_CHECK_TRUE(rec.size() <= 300U);
+  TEST_CHECK_TRUE(rec.find("\"samples\":0}") != std::string::npos);
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(sess_flight, "check flight recorder")
+
+  Session_test s1;
+
+  constexpr size_t ring_size = tftp::constants::flight_recorder_size;
+  auto now = std::chrono::steady_clock::now();
+  for(uint16_t blk = 1U; blk <= ring_size + 8U; ++blk)
+  {
+    s1.flight_record(Session_test::FlightDir::tx, now, 3U, blk, 516U);
+  }
+  s1.flight_record(Session_test::FlightDir::timeout, now);
+
+  TEST_CHECK_TRUE(s1.flight_count_ == ring_size + 9U);
+  TEST_CHECK_TRUE(s1.flight_[8U].dir == Session_test::FlightDir::timeout);
+  TEST_CHECK_TRUE(s1.flight_[9U].field == 10U); // oldest kept event
+  TEST_CHECK_TRUE(s1.flight_[9U].size == 516U);
+
+  std::vector<std::string> lines;
+  s1.set_logger([&](const tftp::LogLvl lvl, std::string_view msg)
+      {
+        if(lvl == tftp::LogLvl::warning) lines.emplace_back(msg);
+      });
+  s1.flight_dump("test");
+  s1.set_logger(nullptr);
+
+  TEST_CHECK_TRUE(s1.flight_dumped_);
+  TEST_CHECK_TRUE(lines.size() == ring_size + 1U);
+  TEST_CHECK_TRUE(lines[0U].find("Flight recorder (test): last 32 of 41") != std::string::npos);
+  TEST_CHECK_TRUE(lines[1U].find("tx DATA #10 [516 octets]") != std::string::npos);
+  TEST_CHECK_TRUE(lines.back().find("timeout; state") != std::string::npos);
+
+  // Not abnormal stop dumped at debug level
+  lines.clear();
+  s1.set_logger([&](const tftp::LogLvl lvl, std::string_view msg)
+      {
+        if(lvl == tftp::LogLvl::warning) lines.emplace_back(msg);
+      });
+  s1.flight_dump("test", tftp::LogLvl::debug);
+  s1.set_logger(nullptr);
+  TEST_CHECK_TRUE(lines.empty());
+
+  TEST_CHECK_TRUE(s1.stop_dump_level() == tftp::LogLvl::warning); // no error code
+  Session_test s2;
+  s2.set_error_if_first(1U, "File not found");
+  TEST_CHECK_TRUE(s2.stop_dump_level() == tftp::LogLvl::debug);
+  s2.summary_.timed_out = true;
+  TEST_CHECK_TRUE(s2.stop_dump_level() == tftp::LogLvl::warning);
+  Session_test s3;
+  s3.set_error_if_first(0U, "Session cancelled by administrator");
+  TEST_CHECK_TRUE(s3.stop_dump_level() == tftp::LogLvl::warning);
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
 UNIT_TEST_SUITE_END
@@ -10,6 +10,9 @@
  *  \version 0.2.1
  */
 
+#include <fstream>
+#include <unistd.h>
+
 #include "../tftpCommon.h"
 #include "../tftpSettings.h"
 #include "test.h"
@@ -56,6 +59,10 @@ START_ITER("default options");
   TEST_CHECK_TRUE(b.dialect == 3U);
   TEST_CHECK_TRUE(b.retransmit_count_ == tftp::constants::default_retransmit_count);
   TEST_CHECK_TRUE(b.file_chmod == tftp::constants::default_file_chmod);
+  TEST_CHECK_TRUE(b.log_writer_ == nullptr); // runtime objects only after load
+  TEST_CHECK_TRUE(b.lookup_cache_ == nullptr);
+  TEST_CHECK_TRUE(b.read_ahead_ == nullptr);
+  TEST_CHECK_TRUE(b.block_cache_ == nullptr);
 }
 
 // 2
@@ -146,6 +153,87 @@ START_ITER("load options IPv6");
   TEST_CHECK_TRUE(b.local_base_.as_in6().sin6_addr.__in6_u.__u6_addr8[15] == 0x01U);
   TEST_CHECK_TRUE(b.local_base_.str() == "[fe80::1]:65000");
   TEST_CHECK_TRUE(b.retransmit_count_ == tftp::constants::default_retransmit_count);
+  TEST_CHECK_FALSE(b.use_mmap);
+  TEST_CHECK_TRUE(b.preload_ == nullptr);
+  TEST_CHECK_TRUE(b.log_writer_ != nullptr);
+  TEST_CHECK_TRUE(b.lookup_cache_ != nullptr);
+  TEST_CHECK_TRUE(b.read_ahead_ != nullptr);
+  TEST_CHECK_TRUE(b.block_cache_ != nullptr);
+}
+
+// 4
+START_ITER("load options with configuration file");
+{
+  const std::string conf_name{"/tmp/server-fw-test.conf"};
+  {
+    std::ofstream conf{conf_name};
+    conf << "# comment" << std::endl
+         << std::endl
+         << "root-dir /mnt/conf" << std::endl
+         << "  search=/mnt/conf1" << std::endl
+         << "--retransmit 7" << std::endl
+         << "mmap" << std::endl
+         << "config /tmp/other.conf" << std::endl;
+  }
+
+  const char * tst_args[]=
+  {
+    "./server-fw",
+    "--config", conf_name.c_str(),
+    "--root-dir", "/mnt/tftp",
+    "--search", "/mnt/tst1",
+  };
+
+  Settings_test b;
+  TEST_CHECK_TRUE(b.load_options(sizeof(tst_args)/sizeof(tst_args[0]),
+                                 const_cast<char **>(tst_args)));
+  TEST_CHECK_TRUE(b.config_file == conf_name);
+  TEST_CHECK_TRUE(b.root_dir == "/mnt/tftp"); // command line win
+  TEST_CHECK_TRUE(b.backup_dirs.size() == 2);
+  TEST_CHECK_TRUE(b.backup_dirs[0] == "/mnt/conf1");
+  TEST_CHECK_TRUE(b.backup_dirs[1] == "/mnt/tst1");
+  TEST_CHECK_TRUE(b.retransmit_count_ == 7U);
+  TEST_CHECK_TRUE(b.use_mmap);
+
+  // Reload: not reloadable options kept, runtime objects shared
+  b.local_base_.set_string("1.1.1.1:7777");
+  Settings_test n;
+  TEST_CHECK_TRUE(n.load_options(b.cmd_args));
+  auto ignored = n.adopt(b);
+  TEST_CHECK_TRUE(ignored.size() == 1U);
+  if(ignored.size()) TEST_CHECK_TRUE(ignored[0U] == "listen");
+  TEST_CHECK_TRUE(n.local_base_.str() == "1.1.1.1:7777");
+  TEST_CHECK_TRUE(n.block_cache_ == b.block_cache_);
+  TEST_CHECK_TRUE(n.read_ahead_ == b.read_ahead_);
+  TEST_CHECK_FALSE(n.lookup_cache_ == b.lookup_cache_);
+
+  unlink(conf_name.c_str());
+  TEST_CHECK_FALSE(n.load_options(b.cmd_args)); // file not exist
+}
+
+// 5
+START_ITER("transfer log file");
+{
+  const std::string log_name{"/tmp/server-fw-test-transfer.log"};
+  const char * tst_args[]=
+  {
+    "./server-fw",
+    "--transfer-log", log_name.c_str(),
+  };
+
+  Settings_test b;
+  TEST_CHECK_TRUE(b.load_options(sizeof(tst_args)/sizeof(tst_args[0]),
+                                 const_cast<char **>(tst_args)));
+  TEST_CHECK_TRUE(b.transfer_log_ != nullptr);
+  b.transfer_log_.reset();
+  unlink(log_name.c_str());
+
+  // Not opened file - options not loaded
+  tst_args[2] = "/tmp/server-fw-test-not-exist/transfer.log";
+  Settings_test n;
+  TEST_CHECK_FALSE(n.load_options(sizeof(tst_args)/sizeof(tst_args[0]),
+                                  const_cast<char **>(tst_args)));
+  TEST_CHECK_TRUE(n.transfer_log_ == nullptr);
 }
 
 UNIT_TEST_CASE_END
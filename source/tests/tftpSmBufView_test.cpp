@@ -0,0 +1,77 @@
+/**
+ * \file tftpSmBufView_test.cpp
+ * \brief Unit-tests for class SmBufView
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "test.h"
+#include "../tftpSmBufView.h"
+
+UNIT_TEST_SUITE_BEGIN(SmBufView)
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(main, "Main checks")
+
+START_ITER("View over external memory")
+{
+  char mem[32U];
+  tftp::SmBufView b{mem, sizeof(mem)};
+  TEST_CHECK_TRUE(b.data() == mem);
+  TEST_CHECK_TRUE(b.size() == sizeof(mem));
+  TEST_CHECK_TRUE(b.data_size() == 0U);
+  TEST_CHECK_TRUE(b.is_bigendian() == tftp::constants::default_buf_int_bigendian);
+  TEST_CHECK_TRUE(b.is_zeroend() == tftp::constants::default_buf_str_zeroend);
+
+  TEST_CHECK_TRUE(b.push_data((uint16_t) 5U, (uint16_t) 1U, "Error"));
+  TEST_CHECK_TRUE(b.data_size() == 10U);
+  TEST_CHECK_TRUE(mem[0U] == 0);
+  TEST_CHECK_TRUE(mem[1U] == 5);
+  TEST_CHECK_TRUE(mem[3U] == 1);
+  TEST_CHECK_TRUE(mem[9U] == 0);
+  TEST_CHECK_TRUE(b.get_be<uint16_t>(2U) == 1U);
+  TEST_CHECK_TRUE(b.get_le<uint16_t>(2U) == 0x0100U);
+  TEST_CHECK_TRUE(b.get_string(4U) == "Error");
+  TEST_CHECK_TRUE(b.eqv_string(4U, "Error", true));
+  TEST_CHECK_FALSE(b.eqv_string(4U, "Err", true));
+
+  // Overflow
+  TEST_CHECK_FALSE(b.push_data(std::string(30U, 'a')));
+  TEST_CHECK_TRUE(b.data_size() == 10U);
+  TEST_CHECK_FALSE(b.is_valid<uint32_t>(30U));
+
+  bool was_throw = false;
+  try { b.set_be<uint32_t>(30U, 1U); } catch(std::invalid_argument &) { was_throw = true; }
+  TEST_CHECK_TRUE(was_throw);
+
+  b.clear();
+  TEST_CHECK_TRUE(b.data_size() == 0U);
+  b.data_size_reset(20U);
+  TEST_CHECK_TRUE(b.data_size() == 20U);
+}
+
+START_ITER("View over SmBufEx")
+{
+  tftp::SmBufEx buf{64U};
+  buf.push_data((uint16_t) 4U, (uint16_t) 7U);
+
+  tftp::SmBufView b{buf};
+  TEST_CHECK_TRUE(b.data() == buf.data());
+  TEST_CHECK_TRUE(b.data_size() == 4U);
+  TEST_CHECK_TRUE(b.get_be<uint16_t>(2U) == 7U);
+
+  b.set_be<uint16_t>(2U, 8U);
+  TEST_CHECK_TRUE(buf.get_be<uint16_t>(2U) == 8U);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_SUITE_END
@@ -10,9 +10,12 @@
  *  \version 0.2.1
  */
 
+#include <fstream>
 #include <netinet/in.h> // sockaddr
 
 #include "tftpSrv_test.h"
+#include "../tftpArena.h"
+#include "../tools/tftpLossyLink.h"
 
 using namespace unit_tests;
 
@@ -123,5 +126,262 @@ UNIT_TEST_CASE_END
 
 //------------------------------------------------------------------------------
 
+/// Write test file with content
+static auto make_file(const std::string & name, size_t size) -> std::string
+{
+  std::string ret(size, 0);
+  for(size_t iter = 0U; iter < size; ++iter) ret[iter] = (char) (iter * 7U + 3U);
+
+  std::ofstream out{local_dir / name, std::ios::binary};
+  out.write(ret.data(), (std::streamsize) ret.size());
+  return ret;
+}
+
+/// Read test file content
+static auto read_file(const std::string & name) -> std::string
+{
+  std::ifstream in{local_dir / name, std::ios::binary};
+  return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(retransmit, "Retransmit on lost packets and windows")
+
+  TEST_CHECK_TRUE(check_local_directory());
+
+  tftp::Addr srv_addr;
+  srv_addr.set_string("127.0.0.1:5152");
+  RunServer run;
+  TEST_CHECK_TRUE(run.start({"--ip", srv_addr.str(), "--root-dir", local_dir.string()}));
+
+START_ITER("RRQ: OACK lost - OACK repeated")
+{
+  const std::string content{make_file("oack_lost.bin", 100U)};
+
+  Client cl{srv_addr};
+  cl.send(Client::request(1U, "oack_lost.bin", {{"blksize", "512"}, {"timeout", "1"}}));
+  TEST_CHECK_TRUE(Client::op(cl.recv(2000)) == 6U);
+
+  // No ACK 0 (OACK lost) - server must repeat OACK, not DATA
+  auto begin = std::chrono::steady_clock::now();
+  TEST_CHECK_TRUE(Client::op(cl.recv(2500)) == 6U);
+  TEST_CHECK_TRUE(std::chrono::steady_clock::now() - begin >= std::chrono::milliseconds{900});
+
+  // Late ACK 0 - transfer continue
+  cl.send(Client::ack(0U));
+  auto pkt = cl.recv(2000);
+  TEST_CHECK_TRUE(Client::op(pkt) == 3U);
+  TEST_CHECK_TRUE(Client::field(pkt) == 1U);
+  TEST_CHECK_TRUE((pkt.size() > 4U) && (pkt.compare(4U, std::string::npos, content) == 0));
+  cl.send(Client::ack(1U));
+}
+
+START_ITER("WRQ: last block in middle of window acknowledged at once")
+{
+  std::string content(512U * 5U + 100U, 0); // 6 blocks; windows 1-4, 5-6
+  for(size_t iter = 0U; iter < content.size(); ++iter) content[iter] = (char) iter;
+  filesystem::remove(local_dir / "wrq_window.bin");
+
+  Client cl{srv_addr};
+  cl.send(Client::request(2U, "wrq_window.bin", {{"blksize", "512"},
+                                                 {"windowsize", "4"},
+                                                 {"timeout", "1"}}));
+  TEST_CHECK_TRUE(Client::op(cl.recv(2000)) == 6U);
+
+  auto send_blocks = [&](uint16_t from, uint16_t to)
+  {
+    for(uint16_t blk = from; blk <= to; ++blk)
+    {
+      cl.send(Client::data(blk, std::string_view{content}.substr((blk - 1U) * 512U, 512U)));
+    }
+  };
+
+  send_blocks(1U, 4U);
+  auto pkt = cl.recv(2000);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 4U));
+
+  // Window not full - ACK of last block without waiting timeout
+  auto begin = std::chrono::steady_clock::now();
+  send_blocks(5U, 6U);
+  pkt = cl.recv(2000);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 6U));
+  TEST_CHECK_TRUE(std::chrono::steady_clock::now() - begin < std::chrono::milliseconds{500});
+
+  usleep(100000); // session finish
+  TEST_CHECK_TRUE(read_file("wrq_window.bin") == content);
+}
+
+START_ITER("WRQ: lost block - ACK of last received block, no hole in file")
+{
+  std::string content(512U * 5U + 100U, 0); // 6 blocks
+  for(size_t iter = 0U; iter < content.size(); ++iter) content[iter] = (char) (iter * 3U);
+  filesystem::remove(local_dir / "wrq_lost.bin");
+
+  Client cl{srv_addr};
+  cl.send(Client::request(2U, "wrq_lost.bin", {{"blksize", "512"},
+                                               {"windowsize", "4"},
+                                               {"timeout", "1"}}));
+  TEST_CHECK_TRUE(Client::op(cl.recv(2000)) == 6U);
+
+  auto send_block = [&](uint16_t blk)
+  {
+    cl.send(Client::data(blk, std::string_view{content}.substr((blk - 1U) * 512U, 512U)));
+  };
+
+  // Block 3 lost - ACK 2 at once (window restart), block 4 not written
+  auto begin = std::chrono::steady_clock::now();
+  for(uint16_t blk : {1U, 2U, 4U}) send_block(blk);
+  auto pkt = cl.recv(2000);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 2U));
+  TEST_CHECK_TRUE(std::chrono::steady_clock::now() - begin < std::chrono::milliseconds{500});
+
+  for(uint16_t blk : {3U, 4U}) send_block(blk);
+  pkt = cl.recv(2000);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 4U));
+
+  // Old block (duplicate of acknowledged window) - ACK repeated
+  send_block(4U);
+  pkt = cl.recv(2000);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 4U));
+
+  for(uint16_t blk : {5U, 6U}) send_block(blk);
+  pkt = cl.recv(2000);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 6U));
+
+  usleep(100000); // session finish
+  TEST_CHECK_TRUE(read_file("wrq_lost.bin") == content);
+}
+
+START_ITER("WRQ: timeout - OACK or ACK of last received block repeated")
+{
+  std::string content(512U + 10U, 'w'); // 2 blocks
+  filesystem::remove(local_dir / "wrq_timeout.bin");
+
+  Client cl{srv_addr};
+  cl.send(Client::request(2U, "wrq_timeout.bin", {{"blksize", "512"},
+                                                  {"windowsize", "4"},
+                                                  {"timeout", "1"}}));
+  TEST_CHECK_TRUE(Client::op(cl.recv(2000)) == 6U);
+
+  // No DATA - OACK repeated
+  TEST_CHECK_TRUE(Client::op(cl.recv(2500)) == 6U);
+
+  // Block 1 in middle of window; next lost - ACK 1 (not 2) on timeout
+  cl.send(Client::data(1U, std::string_view{content}.substr(0U, 512U)));
+  auto pkt = cl.recv(2500);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 1U));
+
+  cl.send(Client::data(2U, std::string_view{content}.substr(512U)));
+  pkt = cl.recv(2000);
+  TEST_CHECK_TRUE((Client::op(pkt) == 4U) && (Client::field(pkt) == 2U));
+
+  usleep(100000); // session finish
+  TEST_CHECK_TRUE(read_file("wrq_timeout.bin") == content);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(lossy, "Transfers over lossy link (loss, reorder, windows)")
+
+  TEST_CHECK_TRUE(check_local_directory());
+
+  tftp::Addr srv_addr;
+  srv_addr.set_string("127.0.0.1:5153");
+  RunServer run;
+  TEST_CHECK_TRUE(run.start({"--ip", srv_addr.str(), "--root-dir", local_dir.string()}));
+
+  tftp::Impairment imp;
+  imp.loss = 0.05;
+  imp.reorder = 0.1;
+  imp.duplicate = 0.02;
+  imp.seed = 7U;
+  tftp::LossyLink link{srv_addr, imp};
+  tftp::Addr listen;
+  listen.set_string("127.0.0.1:0");
+  TEST_CHECK_TRUE(std::get<0>(link.open(listen)));
+  link.start();
+
+START_ITER("RRQ: windowsize 4")
+{
+  const std::string content{make_file("lossy_rrq.bin", 512U * 40U + 77U)};
+
+  Client cl{link.local()};
+  auto [ok, data] = cl.download("lossy_rrq.bin", 512U, 4U, 200);
+  TEST_CHECK_TRUE(ok);
+  TEST_CHECK_TRUE(data == content);
+}
+
+START_ITER("WRQ: windowsize 4")
+{
+  std::string content(512U * 40U + 33U, 0);
+  for(size_t iter = 0U; iter < content.size(); ++iter) content[iter] = (char) (iter * 7U);
+  filesystem::remove(local_dir / "lossy_wrq.bin");
+
+  Client cl{link.local()};
+  TEST_CHECK_TRUE(cl.upload("lossy_wrq.bin", content, 512U, 4U, 200));
+
+  usleep(200000); // session finish
+  TEST_CHECK_TRUE(read_file("lossy_wrq.bin") == content);
+}
+
+START_ITER("Impairments applied")
+{
+  auto st = link.stat();
+  TEST_CHECK_TRUE(st.dropped > 0U);
+  TEST_CHECK_TRUE(st.reordered > 0U);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
+UNIT_TEST_CASE_BEGIN(metrics, "Metrics of server objects")
+
+START_ITER("Arena memory exported")
+{
+  auto & arena = tftp::Arena::global();
+  bool was_enabled = arena.enabled();
+  arena.enable();
+  {
+    tftp::SmBuf buf(0xFFFFU, 0);
+
+    Srv_test srv;
+    auto text = srv.metrics_text();
+    TEST_CHECK_TRUE(text.find("# TYPE tftp_arena_bytes gauge\n") != std::string::npos);
+    TEST_CHECK_TRUE(text.find("tftp_arena_bytes{kind=\"total\"} ") != std::string::npos);
+    TEST_CHECK_TRUE(text.find("tftp_arena_bytes{kind=\"used\"} 0\n") == std::string::npos);
+  }
+  arena.enable(was_enabled);
+}
+
+START_ITER("Caches and log writer exported")
+{
+  const char * tst_arg[]={ "./server-fw",
+                           "--syslog", "0",
+                           "--block-cache", "1" };
+
+  Srv_test srv;
+  TEST_CHECK_TRUE(srv.load_options(
+      sizeof(tst_arg)/sizeof(tst_arg[0]),
+      const_cast<char **>(tst_arg)));
+
+  auto text = srv.metrics_text();
+  TEST_CHECK_TRUE(text.find("# HELP tftp_lookup_cache_total Lookup cache requests\n"
+                            "# TYPE tftp_lookup_cache_total counter\n"
+                            "tftp_lookup_cache_total{result=\"hit\"} 0\n"
+                            "tftp_lookup_cache_total{result=\"miss\"} 0\n") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_block_cache_total{result=\"miss\"} 0\n") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("tftp_read_ahead_total{result=\"hit\"} 0\n") != std::string::npos);
+  TEST_CHECK_TRUE(text.find("# TYPE tftp_log_messages_total counter\n"
+                            "tftp_log_messages_total{log=\"syslog\",result=\"written\"} ") != std::string::npos);
+}
+
+UNIT_TEST_CASE_END
+
+//------------------------------------------------------------------------------
+
 UNIT_TEST_SUITE_END
 
@@ -13,6 +13,9 @@
 #ifndef SOURCE_TESTS_TFTPSRV_TEST_H_
 #define SOURCE_TESTS_TFTPSRV_TEST_H_
 
+#include <poll.h>
+#include <thread>
+
 #include "test.h"
 #include "../tftpSrv.h"
 #include "../tftpBase.h"
@@ -329,6 +332,299 @@ public:
 
 //------------------------------------------------------------------------------
 
+/** \brief Server with access to protected members
+ */
+class Srv_test: public tftp::Srv
+{
+public:
+  using tftp::Srv::metrics_text;
+};
+
+//------------------------------------------------------------------------------
+
+/** \brief Server under test running in own thread
+ */
+class RunServer
+{
+public:
+  tftp::Srv srv;
+  std::thread thr;
+
+  /** \brief Load options ("--syslog 0" added), init and start main loop
+   *
+   *  \param [in] args Command line options
+   *  \return True if started
+   */
+  bool start(const std::vector<std::string> & args)
+  {
+    std::vector<std::string> all{"./server-fw", "--syslog", "0"};
+    all.insert(all.end(), args.begin(), args.end());
+
+    std::vector<char *> argv;
+    for(auto & item : all) argv.push_back(item.data());
+
+    if(!srv.load_options((int) argv.size(), argv.data()) || !srv.init()) return false;
+
+    thr = std::thread(& tftp::Srv::main_loop, & srv);
+    usleep(100000);
+    return true;
+  }
+
+  ~RunServer()
+  {
+    if(!thr.joinable()) return;
+    srv.stop();
+    thr.join();
+  }
+};
+
+//------------------------------------------------------------------------------
+
+/** \brief Minimal TFTP client (RFC 1350/2347/7440) over loopback
+ *
+ *  Transfer address of server (TID) remembered from first reply; packets
+ *  from other addresses ignored after that.
+ */
+class Client
+{
+protected:
+  int sock_;
+  tftp::Addr server_; ///< Request address, then transfer address
+  bool tid_set_;
+
+public:
+  using Opts = std::vector<std::pair<std::string, std::string>>;
+
+  Client(const tftp::Addr & server):
+      sock_{socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)},
+      server_{server},
+      tid_set_{false}
+  {
+    tftp::Addr local;
+    local.set_string("127.0.0.1:0");
+    bind(sock_, local.as_sockaddr_ptr(), local.data_size());
+  }
+
+  ~Client() { close(sock_); }
+
+  static auto request(uint16_t op, std::string_view name, const Opts & opts)
+      -> std::string
+  {
+    std::string ret{(char) 0, (char) op};
+    ret.append(name).append(1U, '\0').append("octet").append(1U, '\0');
+    for(auto & [key, val] : opts)
+    {
+      ret.append(key).append(1U, '\0').append(val).append(1U, '\0');
+    }
+    return ret;
+  }
+
+  static auto ack(uint16_t blk) -> std::string
+  {
+    return {(char) 0, (char) 4, (char) (blk >> 8), (char) (blk & 0xFFU)};
+  }
+
+  static auto data(uint16_t blk, std::string_view payload) -> std::string
+  {
+    std::string ret{(char) 0, (char) 3, (char) (blk >> 8), (char) (blk & 0xFFU)};
+    return ret.append(payload);
+  }
+
+  static auto op(const std::string & pkt) -> uint16_t
+  {
+    return pkt.size() < 2U ? 0U :
+        (uint16_t) (((uint8_t) pkt[0U] << 8) | (uint8_t) pkt[1U]);
+  }
+
+  static auto field(const std::string & pkt) -> uint16_t
+  {
+    return pkt.size() < 4U ? 0U :
+        (uint16_t) (((uint8_t) pkt[2U] << 8) | (uint8_t) pkt[3U]);
+  }
+
+  void send(const std::string & pkt)
+  {
+    sendto(sock_, pkt.data(), pkt.size(), 0,
+           server_.as_sockaddr_ptr(), server_.data_size());
+  }
+
+  /** \brief Receive packet from server
+   *
+   *  \param [in] timeout_ms Timeout
+   *  \return Packet (empty if timeout)
+   */
+  auto recv(int timeout_ms) -> std::string
+  {
+    auto until = std::chrono::steady_clock::now() +
+                 std::chrono::milliseconds{timeout_ms};
+    std::array<char, 0x10000U> buf;
+    for(;;)
+    {
+      auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+          until - std::chrono::steady_clock::now()).count();
+      struct pollfd pfd{sock_, POLLIN, 0};
+      if((left <= 0) || (poll(& pfd, 1, (int) left) <= 0)) return {};
+
+      tftp::Addr from;
+      from.data_size() = from.size();
+      ssize_t size = recvfrom(sock_, buf.data(), buf.size(), 0,
+                              from.as_sockaddr_ptr(), & from.data_size());
+      if(size < 4) continue;
+
+      if(!tid_set_)
+      {
+        server_ = from;
+        tid_set_ = true;
+      }
+      else
+      if(from.str() != server_.str())
+      {
+        continue; // other TID
+      }
+
+      return std::string(buf.data(), (size_t) size);
+    }
+  }
+
+  /** \brief Read file; ACK at window end, once on gap and on timeout
+   *
+   *  \param [in] name File name
+   *  \param [in] blksize Block size
+   *  \param [in] windowsize Window size
+   *  \param [in] timeout_ms Timeout of client
+   *  \return Tuple<success; received data>
+   */
+  auto download(
+      std::string_view name,
+      uint16_t blksize,
+      uint16_t windowsize,
+      int timeout_ms) -> std::tuple<bool, std::string>
+  {
+    const std::string req{request(1U, name, {{"blksize", std::to_string(blksize)},
+                                             {"windowsize", std::to_string(windowsize)}})};
+    send(req);
+
+    std::string ret;
+    uint16_t blk = 0U;   // last block received in order
+    uint16_t acked = 0U; // last acknowledged block
+    bool gap_acked = false;
+    for(size_t fails = 0U; fails < 10U;)
+    {
+      auto pkt = recv(timeout_ms);
+      if(pkt.empty())
+      {
+        ++fails;
+        if(tid_set_) send(ack(acked = blk)); else send(req);
+        continue;
+      }
+      fails = 0U;
+
+      if(op(pkt) == 5U) return {false, ret}; // ERROR
+
+      if((op(pkt) == 6U) && !blk)
+      {
+        send(ack(acked = 0U));
+        continue;
+      }
+
+      if(op(pkt) != 3U) continue;
+
+      uint16_t ahead = (uint16_t) (field(pkt) - blk);
+      if(!ahead || (ahead > windowsize)) continue; // old or duplicate
+
+      if(ahead > 1U)
+      {
+        if(!gap_acked) send(ack(acked = blk)); // lost block - restart window
+        gap_acked = true;
+        continue;
+      }
+
+      ret.append(pkt, 4U);
+      blk = field(pkt);
+      gap_acked = false;
+      bool last = (pkt.size() - 4U) < blksize;
+      if(last || ((uint16_t) (blk - acked) >= windowsize)) send(ack(acked = blk));
+
+      if(last)
+      {
+        // Dally: repeat last ACK if server repeat last window
+        while(recv(timeout_ms).size()) send(ack(blk));
+        return {true, ret};
+      }
+    }
+
+    return {false, ret};
+  }
+
+  /** \brief Write file; window repeated from first not acknowledged block
+   *
+   *  \param [in] name File name
+   *  \param [in] content Data
+   *  \param [in] blksize Block size
+   *  \param [in] windowsize Window size
+   *  \param [in] timeout_ms Timeout of client
+   *  \return True if last block acknowledged
+   */
+  bool upload(
+      std::string_view name,
+      const std::string & content,
+      uint16_t blksize,
+      uint16_t windowsize,
+      int timeout_ms)
+  {
+    const std::string req{request(2U, name, {{"blksize", std::to_string(blksize)},
+                                             {"windowsize", std::to_string(windowsize)}})};
+    const size_t blocks = content.size() / blksize + 1U;
+
+    size_t acked = 0U; // full number of last acknowledged block
+    bool started = false;
+    for(size_t fails = 0U; fails < 10U;)
+    {
+      if(!started)
+      {
+        send(req);
+      }
+      else
+      {
+        for(size_t num = acked + 1U; num <= std::min(acked + windowsize, blocks); ++num)
+        {
+          send(data((uint16_t) num, std::string_view{content}.substr(
+              (num - 1U) * blksize, blksize)));
+        }
+      }
+
+      // Wait ACK moved forward (or repeated - restart window)
+      bool got = false;
+      for(std::string pkt; !got && (pkt = recv(timeout_ms)).size();)
+      {
+        if(op(pkt) == 5U) return false; // ERROR
+
+        if(!started)
+        {
+          got = started = (op(pkt) == 6U) || ((op(pkt) == 4U) && !field(pkt));
+          continue;
+        }
+
+        if(op(pkt) != 4U) continue;
+
+        size_t full = acked + (uint16_t) (field(pkt) - (uint16_t) acked);
+        if(full > acked + windowsize) continue; // old
+        got = true;
+        acked = full;
+      }
+
+      if(!got) { ++fails; continue; }
+      fails = 0U;
+
+      if(acked == blocks) return true;
+    }
+
+    return false;
+  }
+};
+
+//------------------------------------------------------------------------------
+
 } // namespace tftp_server
 
 #endif /* SOURCE_TESTS_TFTPSRV_TEST_H_ */
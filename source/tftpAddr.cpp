@@ -13,9 +13,9 @@
 #include <arpa/inet.h>
 #include <type_traits>
 #include <string>
-#include <regex>
 
 #include "tftpAddr.h"
+#include "tftpCommon.h"
 
 namespace tftp
 {
@@ -254,65 +254,127 @@ auto Addr::set_string(std::string_view new_value) -> std::tuple<bool,bool>
 {
   bool is_set_addr = false;
   bool is_set_port = false;
-  std::string tmp{new_value};
-  std::regex  re4("^(\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\.\\d{1,3})$|(^(\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}):(\\d{0,5}))$|^:(\\d{1,5})$");
-  std::regex  re6("^\\[?([0-9a-fA-F\\:]*)[\\]]?:(\\d{1,5})$|^\\[?([0-9a-fA-F\\:]*)[\\]]?$");
-  std::smatch sm4, sm6;
 
-  bool is_ipv4 = (std::regex_search(tmp, sm4, re4) && (sm4.size() == 6));
-  bool is_ipv6 = std::regex_search(tmp, sm6, re6);
+  std::string_view addr_s;
+  std::string_view port_s;
+  uint16_t new_family = AF_UNSPEC;
 
-  if(is_ipv4)
+  // IPv4: "<addr>" or "<addr>:[port]" or ":<port>"
+  if(auto pos = new_value.find(':'); pos == std::string_view::npos)
   {
-    set_family(AF_INET);
-
-    // port
-    if(std::string port_s{sm4[5].str()}; port_s.size())
-    {
-      is_set_port = set_port(port_s);
-    }
-    else
-    if(std::string port_s{sm4[4].str()}; port_s.size())
+    if(is_ipv4_str(new_value))
     {
-      is_set_port = set_port(port_s);
+      new_family = AF_INET;
+      addr_s = new_value;
     }
+  }
+  else
+  if(new_value.find(':', pos + 1U) == std::string_view::npos)
+  {
+    addr_s = new_value.substr(0U, pos);
+    port_s = new_value.substr(pos + 1U);
 
-    // addr
-    if(std::string addr_s{sm4[3].str()}; addr_s.size())
+    if((addr_s.size() ? is_ipv4_str(addr_s) : port_s.size()) &&
+       is_port_str(port_s))
     {
-      is_set_addr = set_addr(addr_s);
-    }
-    else
-    if(std::string addr_s{sm4[1].str()}; addr_s.size())
-    {
-      is_set_addr = set_addr(addr_s);
+      new_family = AF_INET;
     }
   }
-  else
-  if(is_ipv6)
+
+  // IPv6: "<addr>" or "[<addr>]" or "[<addr>]:<port>"
+  if(new_family == AF_UNSPEC)
   {
-    set_family(AF_INET6);
+    addr_s = new_value;
+    port_s = std::string_view{};
 
-    // port
-    if(std::string port_s{sm6[2].str()}; port_s.size())
+    if(addr_s.size() && (addr_s.front() == '['))
     {
-      is_set_port = set_port(port_s);
+      auto pos = addr_s.find(']');
+      if(pos != std::string_view::npos)
+      {
+        port_s = addr_s.substr(pos + 1U);
+        addr_s = addr_s.substr(1U, pos - 1U);
+
+        if(port_s.size())
+        {
+          if((port_s.front() == ':') && (port_s.size() > 1U))
+          {
+            port_s.remove_prefix(1U);
+          }
+          else
+          {
+            port_s = std::string_view{"?"}; // wrong port
+          }
+        }
+      }
+      else
+      {
+        addr_s.remove_prefix(1U);
+      }
     }
 
-    // addr
-    if(std::string addr_s{sm6[3].str()}; addr_s.size())
+    if(is_ipv6_str(addr_s) && is_port_str(port_s))
     {
-      is_set_addr = set_addr(addr_s);
+      new_family = AF_INET6;
     }
-    else
-    if(std::string addr_s{sm6[1].str()}; addr_s.size())
+  }
+
+  if(new_family != AF_UNSPEC)
+  {
+    set_family(new_family);
+    if(port_s.size()) is_set_port = set_port(port_s);
+    if(addr_s.size()) is_set_addr = set_addr(addr_s);
+  }
+
+  return {is_set_addr, is_set_port};
+}
+
+// -----------------------------------------------------------------------------
+
+bool Addr::is_ipv4_str(std::string_view val)
+{
+  for(size_t iter=0U; iter < 4U; ++iter)
+  {
+    auto pos = (iter < 3U) ? val.find('.') : val.size();
+    if((pos == std::string_view::npos) ||
+       (pos < 1U) ||
+       (pos > 3U)) return false;
+
+    for(size_t chr=0U; chr < pos; ++chr)
     {
-      is_set_addr = set_addr(addr_s);
+      if((val[chr] < '0') || (val[chr] > '9')) return false;
     }
+
+    val.remove_prefix(std::min(pos + 1U, val.size()));
   }
 
-  return {is_set_addr, is_set_port};
-;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Addr::is_ipv6_str(std::string_view val)
+{
+  for(const char & c : val)
+  {
+    if(!is_hex_char(c) && (c != ':')) return false;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Addr::is_port_str(std::string_view val)
+{
+  if(val.size() > 5U) return false;
+
+  for(const char & c : val)
+  {
+    if((c < '0') || (c > '9')) return false;
+  }
+
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -15,6 +15,8 @@
 
 #include <netinet/in.h> // sockaddr_in6
 #include <array>
+#include <string>
+#include <string_view>
 #include <stddef.h>
 
 namespace tftp
@@ -84,6 +86,28 @@ protected:
    */
   void set_addr_in6(const in6_addr & adr);
 
+  /* \brief Check string is IPv4 address (4 groups of 1...3 digits)
+   *
+   *  Values of groups not checked (only format)
+   *  \param [in] val String
+   *  \return True if format valid, else - false
+   */
+  static bool is_ipv4_str(std::string_view val);
+
+  /* \brief Check string has only IPv6 address symbols (hex digits and ':')
+   *
+   *  \param [in] val String
+   *  \return True if format valid, else - false
+   */
+  static bool is_ipv6_str(std::string_view val);
+
+  /* \brief Check string is port (0...5 digits)
+   *
+   *  \param [in] val String
+   *  \return True if format valid, else - false
+   */
+  static bool is_port_str(std::string_view val);
+
 public:
 
   /** \brief default constructor
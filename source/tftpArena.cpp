@@ -0,0 +1,202 @@
+/**
+ * \file tftpArena.cpp
+ * \brief Memory arena class module
+ *
+ *  Arena for packet buffers and cached blocks with huge pages backing
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <new>
+#include <sys/mman.h>
+
+#include "tftpArena.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+Arena::Arena():
+    mutex_{},
+    enabled_{false},
+    regions_{},
+    regions_count_{0U},
+    free_ptr_{nullptr},
+    free_size_{0U},
+    free_lists_{},
+    total_size_{0U},
+    hugetlb_size_{0U},
+    thp_size_{0U},
+    used_size_{0U}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+Arena::~Arena()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+auto Arena::global() -> Arena &
+{
+  static Arena arena;
+
+  return arena;
+}
+
+// -----------------------------------------------------------------------------
+
+void Arena::enable(bool val)
+{
+  enabled_ = val;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Arena::enabled() const
+{
+  return enabled_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Arena::size_class(size_t size) -> size_t
+{
+  if((size < constants::arena_min_size) ||
+     (size > constants::arena_max_size)) return constants::arena_class_count;
+
+  size_t ret = 0U;
+  while((constants::arena_min_size << ret) < size) ++ret;
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Arena::region_add()
+{
+  constexpr size_t size = constants::arena_region_size;
+
+  size_t count = regions_count_.load(std::memory_order_relaxed);
+  if(count >= regions_.size()) return false;
+
+  bool huge = true;
+  void * addr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if(addr == MAP_FAILED)
+  {
+    huge = false;
+    addr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(addr == MAP_FAILED) return false;
+
+    madvise(addr, size, MADV_HUGEPAGE);
+  }
+
+  regions_[count] = {(char *) addr, size};
+  regions_count_.store(count + 1U, std::memory_order_release);
+  free_ptr_ = (char *) addr;
+  free_size_ = size;
+
+  total_size_ += size;
+  if(huge) hugetlb_size_ += size;
+      else thp_size_ += size;
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Arena::is_own(const void * ptr) const
+{
+  size_t count = regions_count_.load(std::memory_order_acquire);
+  for(size_t idx = 0U; idx < count; ++idx)
+  {
+    const auto & reg = regions_[idx];
+    if((ptr >= reg.begin) && (ptr < reg.begin + reg.size)) return true;
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Arena::allocate(size_t size) -> void *
+{
+  size_t cls = size_class(size);
+
+  if(enabled_ && (cls < constants::arena_class_count))
+  {
+    size_t cls_size = constants::arena_min_size << cls;
+
+    // ... reuse freed buffer
+    {
+      auto & free_list = free_lists_[cls];
+      std::lock_guard lk{free_list.mutex};
+      if(free_list.bufs.size())
+      {
+        void * ret = free_list.bufs.back();
+        free_list.bufs.pop_back();
+        used_size_ += cls_size;
+        return ret;
+      }
+    }
+
+    // ... else take from region
+    std::lock_guard lk{mutex_};
+    if((free_size_ >= cls_size) || region_add())
+    {
+      void * ret = free_ptr_;
+      free_ptr_ += cls_size;
+      free_size_ -= cls_size;
+      used_size_ += cls_size;
+      return ret;
+    }
+  }
+
+  return ::operator new(size);
+}
+
+// -----------------------------------------------------------------------------
+
+void Arena::deallocate(void * ptr, size_t size)
+{
+  if(ptr == nullptr) return;
+
+  size_t cls = size_class(size);
+
+  // Owner checked without lock (no regions - heap buffer at once)
+  if((cls < constants::arena_class_count) && is_own(ptr))
+  {
+    auto & free_list = free_lists_[cls];
+    {
+      std::lock_guard lk{free_list.mutex};
+      free_list.bufs.push_back(ptr);
+    }
+    used_size_ -= constants::arena_min_size << cls;
+    return;
+  }
+
+  ::operator delete(ptr);
+}
+
+// -----------------------------------------------------------------------------
+
+auto Arena::stat() const -> std::tuple<size_t, size_t, size_t, size_t>
+{
+  std::lock_guard lk{mutex_};
+
+  return {total_size_, hugetlb_size_, thp_size_, used_size_};
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
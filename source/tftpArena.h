@@ -0,0 +1,244 @@
+/**
+ * \file tftpArena.h
+ * \brief Memory arena class header
+ *
+ *  Arena for packet buffers and cached blocks with huge pages backing
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPARENA_H_
+#define SOURCE_TFTPARENA_H_
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Size of one arena region (multiple of huge page size)
+  constexpr size_t arena_region_size = 32U*1024U*1024U;
+
+  /// Minimal size allocated from arena (less allocated from heap)
+  constexpr size_t arena_min_size = 4U*1024U;
+
+  /// Count of arena size classes (powers of 2 from arena_min_size)
+  constexpr size_t arena_class_count = 6U;
+
+  /// Maximal size allocated from arena (more allocated from heap)
+  constexpr size_t arena_max_size =
+      arena_min_size << (arena_class_count - 1U);
+
+  /// Maximal count of arena regions (more allocated from heap)
+  constexpr size_t arena_region_max = 256U;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Process-wide memory arena
+ *
+ *  Large buffers (arena_min_size ... arena_max_size) allocated from big
+ *  regions backed by huge pages (MAP_HUGETLB, else transparent huge pages
+ *  advice); freed buffers reused by size classes. Memory of regions never
+ *  returned to system. Other sizes and all sizes when arena disabled
+ *  allocated from heap.
+ *  Regions only added, so owner of freed buffer checked without lock; while
+ *  no region mapped free is a plain heap delete. Free lists of size classes
+ *  locked separately.
+ *  Thread safe.
+ */
+class Arena
+{
+protected:
+
+  /// Region of memory
+  struct Region
+  {
+    char * begin; ///< Begin of region
+    size_t size;  ///< Size of region
+  };
+
+  /// Freed buffers of one size class
+  struct FreeList
+  {
+    std::mutex mutex;           ///< Mutex for buffers
+    std::vector<void *> bufs;   ///< Freed buffers
+  };
+
+  mutable std::mutex mutex_; ///< Mutex for adding regions and take memory
+
+  std::atomic_bool enabled_; ///< Flag: arena enabled
+
+  /// Allocated regions (filled up to regions_count_)
+  std::array<Region, constants::arena_region_max> regions_;
+
+  std::atomic<size_t> regions_count_; ///< Count of allocated regions
+
+  char * free_ptr_; ///< Begin of not used memory in last region
+
+  size_t free_size_; ///< Size of not used memory in last region
+
+  /// Freed buffers by size class
+  std::array<FreeList, constants::arena_class_count> free_lists_;
+
+  size_t total_size_;   ///< Size of all regions
+  size_t hugetlb_size_; ///< Size of regions from MAP_HUGETLB
+  size_t thp_size_;     ///< Size of regions advised for transparent huge pages
+  std::atomic<size_t> used_size_; ///< Size of allocated buffers
+
+  /** \brief Get size class of buffer
+   *
+   *  \param [in] size Size of buffer
+   *  \return Index of size class; arena_class_count if not for arena
+   */
+  static auto size_class(size_t size) -> size_t;
+
+  /** \brief Map new region
+   *
+   *  Need locked mutex_
+   *  \return True if success, else - false
+   */
+  bool region_add();
+
+  /** \brief Check pointer is from arena regions
+   *
+   *  Lock free
+   *  \param [in] ptr Pointer
+   *  \return True if from arena, else - false
+   */
+  bool is_own(const void * ptr) const;
+
+public:
+
+  /** \brief Default constructor
+   *
+   *  Arena disabled
+   */
+  Arena();
+
+  Arena(const Arena &) = delete; ///< Deleted/unused
+
+  Arena & operator=(const Arena &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Regions not unmapped (buffers can be used up to process exit)
+   */
+  virtual ~Arena();
+
+  /** \brief Get process-wide arena
+   *
+   *  \return Reference to arena
+   */
+  static auto global() -> Arena &;
+
+  /** \brief Enable/disable allocation from arena
+   *
+   *  Buffers allocated before change freed right
+   *  \param [in] val New state
+   */
+  void enable(bool val = true);
+
+  /** \brief Check arena enabled
+   *
+   *  \return True if enabled, else - false
+   */
+  bool enabled() const;
+
+  /** \brief Allocate buffer
+   *
+   *  \param [in] size Size of buffer
+   *  \return Pointer to buffer
+   */
+  auto allocate(size_t size) -> void *;
+
+  /** \brief Free buffer
+   *
+   *  \param [in] ptr Pointer to buffer
+   *  \param [in] size Size of buffer
+   */
+  void deallocate(void * ptr, size_t size);
+
+  /** \brief Get memory counters
+   *
+   *  \return Tuple<size of regions; size from MAP_HUGETLB;
+   *          size advised for transparent huge pages; size of used buffers>
+   */
+  auto stat() const -> std::tuple<size_t, size_t, size_t, size_t>;
+};
+
+// -----------------------------------------------------------------------------
+
+/** \brief Allocator for standard containers over process-wide arena
+ *
+ *  Elements constructed without value are default-initialized (trivial
+ *  types not zeroed): buffers are usually filled by read after resize
+ */
+template<typename T>
+struct ArenaAllocator
+{
+  using value_type = T;
+
+  ArenaAllocator() noexcept = default;
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U> &) noexcept {}
+
+  auto allocate(size_t n) -> T *
+  {
+    return static_cast<T *>(Arena::global().allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T * ptr, size_t n)
+  {
+    Arena::global().deallocate(ptr, n * sizeof(T));
+  }
+
+  template<typename U>
+  void construct(U * ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+  {
+    ::new(static_cast<void *>(ptr)) U;
+  }
+
+  template<typename U, typename... Args>
+  void construct(U * ptr, Args &&... args)
+  {
+    ::new(static_cast<void *>(ptr)) U(std::forward<Args>(args)...);
+  }
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T> &, const ArenaAllocator<U> &)
+{
+  return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &, const ArenaAllocator<U> &)
+{
+  return false;
+}
+
+/// Buffer allocated from process-wide arena
+using ArenaBuf = std::vector<char, ArenaAllocator<char>>;
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPARENA_H_ */
@@ -45,8 +45,6 @@ auto Base::operator=(const Base & src) -> Base &
 {
   if(settings_.get() != src.settings_.get())
   {
-    auto lk = begin_unique(); // write lock
-
     settings_ = src.settings_;
   }
 
@@ -70,38 +68,27 @@ auto Base::get_ptr() const -> const pSettings &
 
 auto Base::server_addr() const -> Addr
 {
-  auto lk = begin_shared(); // read lock
-
   return Addr{settings_->local_base_};
 }
 
 // -----------------------------------------------------------------------------
 
-auto Base::begin_shared() const -> std::shared_lock<std::shared_mutex>
-{
-  return std::shared_lock{mutex_};
-}
-
-// -----------------------------------------------------------------------------
-
-auto Base::begin_unique() const -> std::unique_lock<std::shared_mutex>
-{
-  return std::unique_lock{mutex_};
-}
-
-// -----------------------------------------------------------------------------
-
 void Base::log(LogLvl lvl, std::string_view msg) const
 {
-  auto lk = begin_shared(); // read lock
-
   if((int)lvl <= settings_->use_syslog)
   {
-    syslog((int)lvl,
-           "[%d] %s %s",
-           (int)syscall(SYS_gettid),
-           to_string(lvl).data(),
-           msg.data());
+    if(settings_->log_writer_)
+    {
+      settings_->log_writer_->push(lvl, msg); // never blocks
+    }
+    else
+    {
+      syslog((int)lvl,
+             "[%d] %s %s",
+             (int)syscall(SYS_gettid),
+             to_string(lvl).data(),
+             msg.data());
+    }
   }
 
   if(settings_->log_) settings_->log_(lvl, msg);
@@ -109,19 +96,26 @@ void Base::log(LogLvl lvl, std::string_view msg) const
 
 // -----------------------------------------------------------------------------
 
+bool Base::is_log_enabled(LogLvl lvl) const
+{
+  return ((int)lvl <= settings_->use_syslog) || (bool)settings_->log_;
+}
+
+// -----------------------------------------------------------------------------
+
 void Base::set_logger(fLogMsg new_logger)
 {
-  auto lk = begin_unique(); // write lock
+  auto new_settings = Settings::create(* settings_);
 
-  settings_->log_ = new_logger;
+  new_settings->log_ = new_logger;
+
+  settings_ = new_settings;
 }
 
 // -----------------------------------------------------------------------------
 
 auto Base::get_root_dir() const -> std::string
 {
-  auto lk = begin_shared(); // read lock
-
   if(settings_->root_dir.size())
   {
     bool fin_slash =
@@ -140,8 +134,6 @@ auto Base::get_root_dir() const -> std::string
 
 auto Base::get_lib_dir() const -> std::string
 {
-  auto lk = begin_shared(); // read lock
-
   bool fin_slash =
       settings_->lib_dir.size() &&
       (*--settings_->lib_dir.end() == '/');
@@ -151,19 +143,15 @@ auto Base::get_lib_dir() const -> std::string
 
 // -----------------------------------------------------------------------------
 
-auto Base::get_lib_name_fb() const -> std::string
+auto Base::get_lib_name_fb() const -> const std::string &
 {
-  auto lk = begin_shared(); // read lock
-
-  return std::string{settings_->lib_name};
+  return settings_->lib_name;
 }
 
 // -----------------------------------------------------------------------------
 
 auto Base::get_retransmit_count() const -> uint16_t
 {
-  auto lk = begin_shared(); // read lock
-
   return settings_->retransmit_count_;
 }
 
@@ -176,8 +164,6 @@ auto Base::get_connection() const
                 std::string,
                 uint16_t>
 {
-  auto lk = begin_shared(); // read lock
-
   return {std::string{settings_->db},
           std::string{settings_->user},
           std::string{settings_->pass},
@@ -189,50 +175,39 @@ auto Base::get_connection() const
 
 auto Base::get_local_base_str() const -> std::string
 {
-  auto lk = begin_shared(); // read lock
-
   return settings_->local_base_.str();
 }
 // -----------------------------------------------------------------------------
 
 bool Base::get_is_daemon() const
 {
-  auto lk = begin_shared(); // read lock
-
   return settings_->is_daemon;
 }
 
 // -----------------------------------------------------------------------------
 
-auto Base::get_serach_dir() const -> VecStr
+auto Base::get_serach_dir() const -> const VecStr &
 {
-
-  auto lk = begin_shared(); // read lock
-
-  VecStr ret;
-  for(const auto & one_dir: settings_->backup_dirs)
-  {
-    ret.emplace_back(one_dir);
-  }
-
-  return ret;
+  return settings_->backup_dirs;
 }
 
 // -----------------------------------------------------------------------------
 
 bool Base::load_options(int argc, char* argv[])
 {
-  auto lk = begin_unique(); // write lock
+  auto new_settings = Settings::create(* settings_);
 
-  return settings_->load_options(argc, argv);
+  bool ret = new_settings->load_options(argc, argv);
+
+  settings_ = new_settings;
+
+  return ret;
 }
 
 // -----------------------------------------------------------------------------
 
 void Base::out_help(std::ostream & stream, std::string_view app) const
 {
-  auto lk = begin_shared(); // read lock
-
   settings_->out_help(stream, app);
 }
 
@@ -240,8 +215,6 @@ void Base::out_help(std::ostream & stream, std::string_view app) const
 
 void Base::out_id(std::ostream & stream) const
 {
-  auto lk = begin_shared(); // read lock
-
   settings_->out_id(stream);
 }
 
@@ -249,23 +222,94 @@ void Base::out_id(std::ostream & stream) const
 
 int Base::get_file_chmod() const
 {
-  auto lk = begin_shared(); // read lock
-
   return settings_->file_chmod;
 }
 
-auto Base::get_file_chown_user() const -> std::string
+auto Base::get_file_chown_user() const -> const std::string &
 {
-  auto lk = begin_shared(); // read lock
+  return settings_->file_chown_user;
+}
 
-  return std::string{settings_->file_chown_user};
+auto Base::get_file_chown_grp() const -> const std::string &
+{
+  return settings_->file_chown_grp;
 }
 
-auto Base::get_file_chown_grp() const -> std::string
+// -----------------------------------------------------------------------------
+
+bool Base::get_use_mmap() const
 {
-  auto lk = begin_shared(); // read lock
+  return settings_->use_mmap;
+}
 
-  return std::string{settings_->file_chown_grp};
+// -----------------------------------------------------------------------------
+
+auto Base::get_lookup_cache() const -> pLookupCache
+{
+  return settings_->lookup_cache_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_read_ahead() const -> pReadAhead
+{
+  return settings_->read_ahead_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_block_cache() const -> pBlockCache
+{
+  return settings_->block_cache_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_preload_manifest() const -> const std::string &
+{
+  return settings_->preload_manifest;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_preload() const -> pPreload
+{
+  return settings_->preload_;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Base::get_use_huge_pages() const
+{
+  return settings_->use_huge_pages;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_log_writer() const -> pLogWriter
+{
+  return settings_->log_writer_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_metrics_listen() const -> const std::string &
+{
+  return settings_->metrics_listen;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_control_path() const -> const std::string &
+{
+  return settings_->control_path;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Base::get_transfer_log() const -> pLogWriter
+{
+  return settings_->transfer_log_;
 }
 
 
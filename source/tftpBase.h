@@ -15,8 +15,6 @@
 #ifndef SOURCE_TFTPBASE_H_
 #define SOURCE_TFTPBASE_H_
 
-#include <shared_mutex>
-
 #include "tftpCommon.h"
 #include "tftpSettings.h"
 
@@ -29,43 +27,23 @@ namespace tftp
  * \brief Base class for child TFTP server classes
  *
  * Base class with server settings storage.
- * Thread safe access to storage by read/write mutex.
+ * Settings is immutable snapshot: getters read it without locks and
+ * without copies. Change of settings make new snapshot and replace
+ * pointer (only from owner thread); sessions keep snapshot taken at start.
  * Base logging infrastructure.
  * Base settings getters.
  * Method for parsing running arguments (options).
- *
- * External direct use "settings_" can only with starting:
- * - begin_shared() for settings read operations
- * - begin_unique() for settings write operations
  */
 class Base
 {
 protected:
 
-  /** \brief Shared pointer for settings storage
+  /** \brief Shared pointer for settings snapshot
    *
-   *  Danger direct use! Before use do it:
-   *  - begin_shared()
-   *  - begin_unique()
+   *  Fields never changed after publish; replace pointer for change
    */
   pSettings settings_;
 
-  mutable std::shared_mutex mutex_; ///< RW mutex for threading access
-
-  /** \brief Create shared locker for settings_
-   *
-   *  Use for direct read operations with settings_
-   *  \return Lock object
-   */
-  auto begin_shared() const -> std::shared_lock<std::shared_mutex>;
-
-  /** \brief Create unique locker for settings_
-   *
-   *  Use for direct write/read operations with settings_
-   *  \return Lock object
-   */
-  auto begin_unique() const -> std::unique_lock<std::shared_mutex>;
-
   /** \brief Constructor from Settings pointer
    *
    *  \param [in] src Settings instance
@@ -110,9 +88,17 @@ public:
    */
   void log(LogLvl lvl, std::string_view msg) const;
 
+  /** \brief Check message of level will be logged
+   *
+   *  Safe use
+   *  \param [in] lvl Level of message
+   *  \return True if syslog level pass it or custom logger set
+   */
+  bool is_log_enabled(LogLvl lvl) const;
+
   /** \brief Set: second custom logger
    *
-   *  Use mutex unique mode
+   *  Make new settings snapshot
    *  \param [in] new_logger Custom function of logger
    */
   void set_logger(fLogMsg new_logger);
@@ -136,7 +122,7 @@ public:
    *  Safe use
    *  \return Name Firebird library name
    */
-  auto get_lib_name_fb() const -> std::string;
+  auto get_lib_name_fb() const -> const std::string &;
 
   /** \brief Get retransmit count
    *
@@ -169,7 +155,7 @@ public:
    *  Safe use
    *  \return Vector with strings
    */
-  auto get_serach_dir() const -> VecStr;
+  auto get_serach_dir() const -> const VecStr &;
 
   /** \brief Get: Local base address and port as string
    *
@@ -213,14 +199,91 @@ public:
    *  Safe use
    *  \return User name
    */
-  auto get_file_chown_user() const -> std::string;
+  auto get_file_chown_user() const -> const std::string &;
 
   /** \brief get chown group value
    *
    *  Safe use
    *  \return Group name
    */
-  auto get_file_chown_grp() const -> std::string;
+  auto get_file_chown_grp() const -> const std::string &;
+
+  /** \brief Get flag: read files via memory mapping
+   *
+   *  Safe use
+   *  \return Value
+   */
+  bool get_use_mmap() const;
+
+  /** \brief Get cache of file name lookup results
+   *
+   *  Safe use
+   *  \return Shared pointer to cache (can be nullptr)
+   */
+  auto get_lookup_cache() const -> pLookupCache;
+
+  /** \brief Get read-ahead I/O threads
+   *
+   *  Safe use
+   *  \return Shared pointer to read-ahead (can be nullptr)
+   */
+  auto get_read_ahead() const -> pReadAhead;
+
+  /** \brief Get cache of files data
+   *
+   *  Safe use
+   *  \return Shared pointer to cache (can be nullptr)
+   */
+  auto get_block_cache() const -> pBlockCache;
+
+  /** \brief Get manifest of preloaded files
+   *
+   *  Safe use
+   *  \return Path to manifest
+   */
+  auto get_preload_manifest() const -> const std::string &;
+
+  /** \brief Get preloaded files
+   *
+   *  Safe use
+   *  \return Shared pointer to preloaded files (can be nullptr)
+   */
+  auto get_preload() const -> pPreload;
+
+  /** \brief Get flag of huge pages arena use
+   *
+   *  Safe use
+   *  \return True if buffers from huge pages arena, else - false
+   */
+  bool get_use_huge_pages() const;
+
+  /** \brief Get asynchronous syslog writer
+   *
+   *  Safe use
+   *  \return Shared pointer to writer (nullptr if syslog written directly)
+   */
+  auto get_log_writer() const -> pLogWriter;
+
+  /** \brief Get metrics endpoint
+   *
+   *  Safe use
+   *  \return Address "ip:port" or path to Unix socket (empty if disabled)
+   */
+  auto get_metrics_listen() const -> const std::string &;
+
+  /** \brief Get control socket path
+   *
+   *  Safe use
+   *  \return Path to Unix socket (empty if disabled)
+   */
+  auto get_control_path() const -> const std::string &;
+
+  /** \brief Get writer of transfer summary records
+   *
+   *  Safe use
+   *  \return Shared pointer to writer (nullptr if records written to syslog)
+   */
+  auto get_transfer_log() const -> pLogWriter;
 
 };
 
@@ -0,0 +1,140 @@
+/**
+ * \file tftpBlockCache.cpp
+ * \brief Block cache class module
+ *
+ *  Process-wide in-memory cache of served files data
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "tftpBlockCache.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+auto BlockCache::KeyHash::operator()(const Key & key) const -> size_t
+{
+  auto & [id, chunk] = key;
+  auto & [dev, ino, size, mtime_sec, mtime_nsec] = id;
+
+  size_t ret = std::hash<size_t>{}(chunk);
+  for(size_t val : {(size_t) dev, (size_t) ino, (size_t) size,
+                    (size_t) mtime_sec, (size_t) mtime_nsec})
+  {
+    ret ^= std::hash<size_t>{}(val) + 0x9e3779b97f4a7c15U +
+           (ret << 6) + (ret >> 2);
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+BlockCache::BlockCache(size_t max_size):
+    mutex_{},
+    items_{},
+    order_{},
+    max_size_{max_size},
+    curr_size_{0U},
+    hits_{0U},
+    misses_{0U}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+BlockCache::~BlockCache()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+bool BlockCache::enabled() const
+{
+  return max_size_ > 0U;
+}
+
+// -----------------------------------------------------------------------------
+
+auto BlockCache::find(const FileId & id, size_t chunk) -> pChunk
+{
+  if(!enabled()) return nullptr;
+
+  std::lock_guard lk{mutex_};
+
+  auto it = items_.find(Key{id, chunk});
+  if(it == items_.end())
+  {
+    ++misses_;
+    return nullptr;
+  }
+
+  // Mark as most recently used
+  order_.splice(order_.end(), order_, it->second.order);
+
+  ++hits_;
+  return it->second.data;
+}
+
+// -----------------------------------------------------------------------------
+
+void BlockCache::insert(const FileId & id, size_t chunk, pChunk data)
+{
+  if(!enabled() || !data || (data->size() > max_size_)) return;
+
+  std::lock_guard lk{mutex_};
+
+  Key key{id, chunk};
+  if(items_.count(key)) return; // already stored by other session
+
+  // Drop least recently used chunks if no memory
+  while(order_.size() && (curr_size_ + data->size() > max_size_))
+  {
+    auto it = items_.find(order_.front());
+    curr_size_ -= it->second.data->size();
+    items_.erase(it);
+    order_.pop_front();
+  }
+
+  curr_size_ += data->size();
+  order_.push_back(key);
+  items_.emplace(key, Item{std::move(data), --order_.end()});
+}
+
+// -----------------------------------------------------------------------------
+
+void BlockCache::clear()
+{
+  std::lock_guard lk{mutex_};
+
+  items_.clear();
+  order_.clear();
+  curr_size_ = 0U;
+}
+
+// -----------------------------------------------------------------------------
+
+auto BlockCache::size() const -> size_t
+{
+  std::lock_guard lk{mutex_};
+
+  return curr_size_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto BlockCache::stat() const -> std::tuple<size_t, size_t>
+{
+  return {hits_.load(), misses_.load()};
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
@@ -0,0 +1,148 @@
+/**
+ * \file tftpBlockCache.h
+ * \brief Block cache class header
+ *
+ *  Process-wide in-memory cache of served files data
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPBLOCKCACHE_H_
+#define SOURCE_TFTPBLOCKCACHE_H_
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "tftpCommon.h"
+#include "tftpArena.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Size of one cached chunk of file
+  constexpr size_t block_cache_chunk_size = 64U*1024U;
+
+  /// Default memory budget of block cache (0 - cache disabled)
+  constexpr size_t default_block_cache_size = 0U;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Cached chunk of file data
+using pChunk = std::shared_ptr<const ArenaBuf>;
+
+// -----------------------------------------------------------------------------
+
+/** \brief Cache of files data
+ *
+ *  Store chunks (block_cache_chunk_size) of files keyed by file identity
+ *  and chunk number. Cache bounded by memory budget; least recently used
+ *  chunks evicted first.
+ *  Thread safe.
+ */
+class BlockCache
+{
+protected:
+
+  /// Cache key: file identity and chunk number
+  using Key = std::tuple<FileId, size_t>;
+
+  /// Hash of cache key
+  struct KeyHash
+  {
+    auto operator()(const Key & key) const -> size_t;
+  };
+
+  /// Cache entry
+  struct Item
+  {
+    pChunk data; ///< Chunk data
+    std::list<Key>::iterator order; ///< Position in order list
+  };
+
+  mutable std::mutex mutex_; ///< Mutex for entries
+
+  std::unordered_map<Key, Item, KeyHash> items_; ///< Cached chunks
+
+  std::list<Key> order_; ///< Chunks keys, least recently used first
+
+  size_t max_size_; ///< Memory budget (bytes)
+
+  size_t curr_size_; ///< Memory used by chunks (bytes)
+
+  std::atomic<size_t> hits_;   ///< Counter of cache hits
+
+  std::atomic<size_t> misses_; ///< Counter of cache misses
+
+public:
+
+  /** \brief Constructor
+   *
+   *  \param [in] max_size Memory budget in bytes; 0 - cache disabled
+   */
+  BlockCache(size_t max_size = constants::default_block_cache_size);
+
+  BlockCache(const BlockCache &) = delete; ///< Deleted/unused
+
+  BlockCache & operator=(const BlockCache &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   */
+  virtual ~BlockCache();
+
+  /** \brief Check cache enabled
+   *
+   *  \return True if enabled, else - false
+   */
+  bool enabled() const;
+
+  /** \brief Find cached chunk
+   *
+   *  \param [in] id File identity
+   *  \param [in] chunk Number of chunk
+   *  \return Pointer to chunk data (nullptr if not cached)
+   */
+  auto find(const FileId & id, size_t chunk) -> pChunk;
+
+  /** \brief Store chunk
+   *
+   *  If memory budget exceeded, then drop least recently used chunks
+   *  \param [in] id File identity
+   *  \param [in] chunk Number of chunk
+   *  \param [in] data Chunk data
+   */
+  void insert(const FileId & id, size_t chunk, pChunk data);
+
+  /** \brief Drop all cached chunks
+   */
+  void clear();
+
+  /** \brief Get memory used by cached chunks
+   *
+   *  \return Size in bytes
+   */
+  auto size() const -> size_t;
+
+  /** \brief Get counters of cache hits and misses
+   *
+   *  \return Tuple<hits; misses>
+   */
+  auto stat() const -> std::tuple<size_t, size_t>;
+};
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPBLOCKCACHE_H_ */
@@ -97,6 +97,44 @@ bool is_digit_str(std::string_view val)
 
 // -----------------------------------------------------------------------------
 
+bool is_md5_str(std::string_view val)
+{
+  if(val.size() != constants::md5_str_len) return false;
+
+  for(const char & c : val)
+  {
+    if(!is_hex_char(c)) return false;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+auto find_md5(std::string_view val) -> size_t
+{
+  size_t run = 0U; // length of current hex digits run
+
+  for(size_t iter=0U; iter < val.size(); ++iter)
+  {
+    if(!is_hex_char(val[iter]))
+    {
+      run = 0U;
+      // not enough tail for MD5 sum
+      if((val.size() - iter - 1U) < constants::md5_str_len) break;
+    }
+    else
+    if(++run == constants::md5_str_len)
+    {
+      return iter + 1U - constants::md5_str_len;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+// -----------------------------------------------------------------------------
+
 auto get_uid_by_name(const std::string & name) -> uid_t
 {
   auto bufsize = sysconf(_SC_GETPW_R_SIZE_MAX);
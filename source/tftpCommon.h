@@ -20,6 +20,8 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <sys/types.h>
 
 
 namespace tftp
@@ -34,8 +36,8 @@ namespace constants
   /// Full version of this
   constexpr std::string_view app_version = "0.2.1";
 
-  /// Template for match MD5 by regex
-  const std::string regex_template_md5{"([a-fA-F0-9]{32})"};
+  /// Length of MD5 sum as hex string
+  constexpr size_t md5_str_len = 32U;
 
 }
 
@@ -59,6 +61,29 @@ class Settings;
 
 using pSettings = std::shared_ptr<Settings>;
 
+class LookupCache;
+
+using pLookupCache = std::shared_ptr<LookupCache>;
+
+class ReadAhead;
+
+using pReadAhead = std::shared_ptr<ReadAhead>;
+
+class BlockCache;
+
+using pBlockCache = std::shared_ptr<BlockCache>;
+
+class Preload;
+
+using pPreload = std::shared_ptr<Preload>;
+
+class LogWriter;
+
+using pLogWriter = std::shared_ptr<LogWriter>;
+
+/// File identity: device, inode, size, modify time (sec, nsec)
+using FileId = std::tuple<dev_t, ino_t, off_t, time_t, long>;
+
 class Options;
 
 using Buf = std::vector<char>;
@@ -193,16 +218,23 @@ constexpr bool is_container_v = is_container<T>::value;
 // -----------------------------------------------------------------------------
 
 /** Get string with typename class T
+ *
+ *  Name demangled once and cached
  *  \return Typename
  */
 template<typename T>
-auto curr_type() -> std::string
+auto curr_type() -> const std::string &
 {
-  int stat{0};
-  char * tmp_name = abi::__cxa_demangle(typeid(T).name(), 0, 0, & stat);
-  if(!tmp_name) return "???";
-  std::string ret{tmp_name};
-  free(tmp_name);
+  static const std::string ret = []()
+      {
+        int stat{0};
+        char * tmp_name = abi::__cxa_demangle(typeid(T).name(), 0, 0, & stat);
+        if(!tmp_name) return std::string{"???"};
+        std::string name{tmp_name};
+        free(tmp_name);
+        return name;
+      }();
+
   return ret;
 }
 
@@ -349,6 +381,36 @@ bool is_digit_str(std::string_view val);
 
 // -----------------------------------------------------------------------------
 
+/** \brief Check character is hex digit (0...9, a...f, A...F)
+ *
+ *  Locale independent
+ *  \param [in] val Character
+ *  \return True if hex digit, else - false
+ */
+constexpr bool is_hex_char(const char val)
+{
+  return ((val >= '0') && (val <= '9')) ||
+         ((val >= 'a') && (val <= 'f')) ||
+         ((val >= 'A') && (val <= 'F'));
+}
+
+/** \brief Check source string is MD5 sum (32 hex digits exactly)
+ *
+ *  \param [in] val Source string
+ *  \return True if string is MD5 sum, else - false
+ */
+bool is_md5_str(std::string_view val);
+
+/** \brief Find first MD5 sum (32 hex digits) in source string
+ *
+ *  Same as first match of regex "([a-fA-F0-9]{32})"
+ *  \param [in] val Source string
+ *  \return Position of MD5 sum or std::string_view::npos if not found
+ */
+auto find_md5(std::string_view val) -> size_t;
+
+// -----------------------------------------------------------------------------
+
 /** \brief Get UID by user name
  *
  *  If fail, return 0U (root UID)
@@ -387,11 +449,16 @@ auto get_gid_by_name(const std::string & name) -> gid_t;
 
 /** \brief Logging with context
  *
+ *  Level checked first; message built only if it will be logged
  *  Warning! Use only inside methods with base class tftp::Base
  *  \param [in] LEVEL Logging messages level (from type LogLvl)
  *  \param [in] MSG Text message
  */
-#define LOG(LEVEL,MSG) LOG_FMSG(LEVEL,CURR_MSG(MSG))
+#define LOG(LEVEL,MSG) \
+    do \
+    { \
+      if(is_log_enabled(LogLvl::LEVEL)) LOG_FMSG(LEVEL,CURR_MSG(MSG)); \
+    } while(false)
 
 /** \brief Logging with context as LOG_DEBUG message
  *
@@ -0,0 +1,213 @@
+/**
+ * \file tftpControl.cpp
+ * \brief Control socket class module
+ *
+ *  Unix socket for administration of running server
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "tftpControl.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+  /** \brief Remove socket file (other file types kept)
+   *
+   *  \param [in] path Path to file
+   *  \return True if no file at path now, else - false
+   */
+  bool unlink_socket(const std::string & path)
+  {
+    struct stat st;
+    if(lstat(path.c_str(), & st) != 0) return errno == ENOENT;
+    if(!S_ISSOCK(st.st_mode)) return false;
+
+    return unlink(path.c_str()) == 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+ControlServer::ControlServer(std::string_view path):
+    path_{path},
+    socket_{-1},
+    client_{-1},
+    exchange_{},
+    sent_{0U},
+    replying_{false},
+    deadline_{}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+ControlServer::~ControlServer()
+{
+  close_socket();
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlServer::close_socket()
+{
+  close_client();
+
+  if(socket_ < 0) return;
+
+  close(socket_);
+  socket_ = -1;
+
+  unlink_socket(path_);
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlServer::close_client()
+{
+  if(client_ < 0) return;
+
+  close(client_);
+  client_ = -1;
+  exchange_.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+auto ControlServer::open() -> std::tuple<bool, int>
+{
+  close_socket();
+
+  struct sockaddr_un addr{};
+  if(path_.empty() || (path_.size() >= sizeof(addr.sun_path)))
+  {
+    return {false, ENAMETOOLONG};
+  }
+
+  addr.sun_family = AF_UNIX;
+  path_.copy(addr.sun_path, path_.size());
+
+  // Replace only stale socket, never other file
+  if(!unlink_socket(path_)) return {false, EEXIST};
+
+  socket_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if(socket_ < 0) return {false, errno};
+
+  // Socket file created accessible by owner only (no window for others)
+  mode_t old_mask = umask(S_IRWXG | S_IRWXO);
+  int bind_result = bind(socket_, (struct sockaddr *) & addr, sizeof(addr));
+  int err = errno;
+  umask(old_mask);
+
+  if(bind_result != 0)
+  {
+    close(socket_);
+    socket_ = -1;
+    return {false, err};
+  }
+
+  if((chmod(path_.c_str(), S_IRUSR | S_IWUSR) != 0) ||
+     (listen(socket_, 8) != 0))
+  {
+    err = errno;
+    close_socket();
+    return {false, err};
+  }
+
+  return {true, 0};
+}
+
+// -----------------------------------------------------------------------------
+
+auto ControlServer::serve(const Handler & handler) -> size_t
+{
+  if(socket_ < 0) return 0U;
+
+  auto now = std::chrono::steady_clock::now();
+
+  if(client_ < 0)
+  {
+    client_ = accept4(socket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if(client_ < 0) return 0U;
+
+    sent_ = 0U;
+    replying_ = false;
+    deadline_ = now + std::chrono::milliseconds{constants::control_client_timeout_ms};
+  }
+
+  bool timeout = now >= deadline_;
+
+  // Read command line while ready (till new line, end or timeout)
+  if(!replying_)
+  {
+    std::array<char, constants::control_max_command_size> buf;
+    ssize_t res = 0;
+    while((exchange_.find('\n') == std::string::npos) &&
+          (exchange_.size() < constants::control_max_command_size) &&
+          ((res = recv(client_, buf.data(), buf.size(), MSG_DONTWAIT)) > 0))
+    {
+      exchange_.append(buf.data(), (size_t) res);
+    }
+
+    bool line_end = (res == 0) ||
+                    (exchange_.find('\n') != std::string::npos) ||
+                    (exchange_.size() >= constants::control_max_command_size);
+    if(!line_end && !timeout) return 0U;
+
+    exchange_.erase(std::min(exchange_.find('\n'), exchange_.size()));
+    exchange_ = handler ? handler(split(exchange_)) : std::string{};
+    replying_ = true;
+  }
+
+  // Send response while ready
+  while(sent_ < exchange_.size())
+  {
+    ssize_t res = send(client_, exchange_.data() + sent_, exchange_.size() - sent_,
+                       MSG_DONTWAIT | MSG_NOSIGNAL);
+    if(res <= 0) break;
+    sent_ += (size_t) res;
+  }
+
+  if((sent_ < exchange_.size()) && !timeout && (errno == EAGAIN)) return 0U;
+
+  close_client();
+  return 1U;
+}
+
+// -----------------------------------------------------------------------------
+
+auto ControlServer::split(std::string_view line) -> std::vector<std::string>
+{
+  std::vector<std::string> ret;
+
+  size_t pos = 0U;
+  while(pos < line.size())
+  {
+    size_t begin = line.find_first_not_of(" \t\r", pos);
+    if(begin == std::string_view::npos) break;
+
+    size_t end = std::min(line.find_first_of(" \t\r", begin), line.size());
+    ret.emplace_back(line.substr(begin, end - begin));
+    pos = end;
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
@@ -0,0 +1,127 @@
+/**
+ * \file tftpControl.h
+ * \brief Control socket class header
+ *
+ *  Unix socket for administration of running server
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPCONTROL_H_
+#define SOURCE_TFTPCONTROL_H_
+
+#include <chrono>
+#include <vector>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Timeout of exchange with control client (milliseconds)
+  constexpr int control_client_timeout_ms = 500;
+
+  /// Maximum size of control command line
+  constexpr size_t control_max_command_size = 256U;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Control socket (Unix socket only)
+ *
+ *  Polled from server main loop; every connection send one command line
+ *  (words separated by spaces), get one text response and closed.
+ *  One connection served at a time by non-blocking steps.
+ *  Socket file accessible by owner only; file at path replaced only if it
+ *  is a socket.
+ */
+class ControlServer
+{
+public:
+
+  /// Handler of command: words of command line -> response text
+  using Handler = std::function<std::string(const std::vector<std::string> &)>;
+
+protected:
+
+  std::string path_; ///< Path to Unix socket
+
+  int socket_; ///< Listening socket (-1 if closed)
+
+  int client_; ///< Client in progress (-1 if none)
+
+  std::string exchange_; ///< Command line (while reading), then response
+
+  size_t sent_; ///< Sent size of response
+
+  bool replying_; ///< Flag: command read, response sending
+
+  std::chrono::steady_clock::time_point deadline_; ///< End of client timeout
+
+  /** \brief Close listening socket and remove socket file
+   */
+  void close_socket();
+
+  /** \brief Close client in progress
+   */
+  void close_client();
+
+public:
+
+  /** \brief Constructor
+   *
+   *  \param [in] path Path to Unix socket
+   */
+  ControlServer(std::string_view path);
+
+  ControlServer(const ControlServer &) = delete; ///< Deleted/unused
+
+  ControlServer & operator=(const ControlServer &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Close socket; remove socket file
+   */
+  virtual ~ControlServer();
+
+  /** \brief Open listening socket
+   *
+   *  Fail with EEXIST if path exist and not a socket
+   *  \return Tuple<success; errno value>
+   */
+  auto open() -> std::tuple<bool, int>;
+
+  /** \brief Serve one client step by step (never blocks)
+   *
+   *  Called from server main loop each pass: accept one client, read its
+   *  command and send response as far as sockets ready; client not
+   *  finished in control_client_timeout_ms get response or closed.
+   *  \param [in] handler Handler of command
+   *  \return Count of served (finished) clients
+   */
+  auto serve(const Handler & handler) -> size_t;
+
+  /** \brief Split command line to words
+   *
+   *  \param [in] line Command line
+   *  \return Words
+   */
+  static auto split(std::string_view line) -> std::vector<std::string>;
+};
+
+using pControlServer = std::shared_ptr<ControlServer>;
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPCONTROL_H_ */
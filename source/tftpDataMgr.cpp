@@ -12,8 +12,6 @@
  *  \version 0.2.1
  */
 
-#include <regex>
-
 #include "tftpDataMgr.h"
 
 namespace tftp
@@ -47,12 +45,36 @@ void DataMgr::set_error_if_first(
 
 bool DataMgr::match_md5(const std::string & val) const
 {
-  std::regex regex_md5_pure(constants::regex_template_md5);
-  std::smatch sm;
+  return is_md5_str(val);
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgr::path() const -> std::string
+{
+  return "";
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgr::read_blocks(
+    const std::vector<BlkSlot> & slots,
+    const size_t & position) -> ssize_t
+{
+  ssize_t ret = 0;
+
+  for(auto & [slot_begin, slot_end] : slots)
+  {
+    ssize_t slot_size = std::distance(slot_begin, slot_end);
+    ssize_t blk_size = read(slot_begin, slot_end, position + ret);
+
+    if(blk_size < 0) return -1;
+
+    ret += blk_size;
+    if(blk_size < slot_size) break; // end of data
+  }
 
-  return std::regex_search(val, sm, regex_md5_pure) &&
-         (sm.prefix().str().size() == 0U) &&
-         (sm.suffix().str().size() == 0U);
+  return ret;
 }
 
 // -----------------------------------------------------------------------------
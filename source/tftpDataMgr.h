@@ -25,6 +25,19 @@ namespace tftp
 
 // -----------------------------------------------------------------------------
 
+namespace constants
+{
+  /// Maximum size of data read by one read_blocks() call from session
+  constexpr size_t max_window_read_size = 1024U*1024U;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Slot for data of one block: tuple<buffer begin; buffer end>
+using BlkSlot = std::tuple<SmBufEx::iterator, SmBufEx::iterator>;
+
+// -----------------------------------------------------------------------------
+
 
 /** \brief Data manage abstract class
  *
@@ -53,7 +66,7 @@ protected:
 
   /** Check requested value is md5 sum
    *
-   *  Match by regex used 'regex_template_md5'
+   *  Match as 32 hex digits exactly
    *  /return True if md5, else - false
    */
   bool match_md5(const std::string & val) const;
@@ -84,14 +97,14 @@ public:
 
   /** \brief Write data stream operations - abstract method
    *
-   *  \param [in] buf_begin Buffer begin iterator
-   *  \param [in] buf_end Buffer end iterator
+   *  \param [in] data Pointer to received data
+   *  \param [in] data_size Size of received data
    *  \param [in] position Position received block (offset)
    *  \return Processed size, -1 on error
    */
   virtual auto write(
-      SmBufEx::const_iterator buf_begin,
-      SmBufEx::const_iterator buf_end,
+      const char * data,
+      size_t data_size,
       const size_t & position) -> ssize_t = 0;
 
   /** \brief Read data stream operations - abstract method
@@ -106,10 +119,30 @@ public:
       SmBufEx::iterator buf_end,
       const size_t & position) -> ssize_t = 0;
 
+  /** \brief Read data of sequential blocks
+   *
+   *  Fill slots with continuous file data starting from position;
+   *  each slot is filled completely while data exist, so size of data in
+   *  each slot can be calculated from total size.
+   *  Default implementation call read() for each slot.
+   *  \param [in] slots Slots for data of blocks
+   *  \param [in] position Position of first block (offset)
+   *  \return Total processed size, -1 on error
+   */
+  virtual auto read_blocks(
+      const std::vector<BlkSlot> & slots,
+      const size_t & position) -> ssize_t;
+
   /**  Close all opened steams - abstract method
    */
   virtual void close() = 0;
 
+  /** \brief Get resolved path of served file
+   *
+   *  \return Path (empty if not known)
+   */
+  virtual auto path() const -> std::string;
+
 };
 
 // -----------------------------------------------------------------------------
@@ -12,15 +12,25 @@
  *  \version 0.2.1
  */
 
+#include <climits>
+#include <cstring>
 #include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
 #include <linux/limits.h>
-#include <regex>
+#include <map>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <dlfcn.h>
 #include <unistd.h>
 #include <system_error>
 
+#include <chrono>
+
+#include "tftpBlockCache.h"
 #include "tftpDataMgrFile.h"
+#include "tftpMetrics.h"
+#include "tftpPreload.h"
 #include "tftpOptions.h"
 #include "tftpSmBufEx.h"
 
@@ -29,12 +39,116 @@ namespace tftp
 
 // -----------------------------------------------------------------------------
 
+auto file_id(const struct stat & st) -> FileId
+{
+  return {st.st_dev, st.st_ino, st.st_size,
+          st.st_mtim.tv_sec, st.st_mtim.tv_nsec};
+}
+
+// -----------------------------------------------------------------------------
+
+FileFd::FileFd(int fd, const FileId & id):
+    fd_{fd},
+    id_{id}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+FileFd::~FileFd()
+{
+  if(fd_ >= 0) ::close(fd_);
+}
+
+// -----------------------------------------------------------------------------
+
+auto FileFd::fd() const -> int
+{
+  return fd_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto FileFd::size() const -> size_t
+{
+  return (size_t) std::get<2>(id_);
+}
+
+// -----------------------------------------------------------------------------
+
+auto FileFd::id() const -> const FileId &
+{
+  return id_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto FileFd::get(const std::string & path) -> std::tuple<pFileFd, int>
+{
+  // Registry of opened files; entry erased by deleter of last owner
+  // (never destroyed - owners can outlive static objects)
+  static auto & mutex = * new std::mutex;
+  static auto & opened = * new std::map<FileId, std::weak_ptr<FileFd>>;
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd < 0) return {nullptr, errno};
+
+  struct stat st;
+  if(fstat(fd, & st) < 0)
+  {
+    int err = errno;
+    ::close(fd);
+    return {nullptr, err};
+  }
+
+  auto key = file_id(st);
+
+  pFileFd ret{nullptr};
+
+  std::lock_guard lk{mutex};
+
+  auto it = opened.find(key);
+  if(it != opened.end()) ret = it->second.lock();
+
+  if(ret)
+  {
+    ::close(fd); // use shared descriptor
+  }
+  else
+  {
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    ret = pFileFd{
+        new FileFd(fd, key),
+        [key](FileFd * p)
+        {
+          {
+            std::lock_guard lk_del{mutex};
+            auto it_del = opened.find(key);
+            // Entry can be replaced by new open of same file
+            if((it_del != opened.end()) && it_del->second.expired())
+            {
+              opened.erase(it_del);
+            }
+          }
+          delete p;
+        }};
+    opened[key] = ret; // replace stale entry (if was)
+  }
+
+  return {ret, 0};
+}
+
+// -----------------------------------------------------------------------------
+
 DataMgrFile::DataMgrFile():
     DataMgr(),
     Base(),
     filename_{},
-    file_in_{},
-    file_out_{}
+    file_in_{nullptr},
+    file_out_{-1},
+    block_cache_{nullptr},
+    preload_img_{nullptr}
 {
 }
 
@@ -42,14 +156,24 @@ DataMgrFile::DataMgrFile():
 
 DataMgrFile::~DataMgrFile()
 {
+  if(file_out_ >= 0) ::close(file_out_);
 }
 
 // -----------------------------------------------------------------------------
 
 bool DataMgrFile::active() const
 {
-  return ((request_type_ == SrvReq::read)  && file_in_ .is_open()) ||
-         ((request_type_ == SrvReq::write) && file_out_.is_open());
+  return ((request_type_ == SrvReq::read)  && (file_in_ || preload_img_)) ||
+         ((request_type_ == SrvReq::write) && (file_out_ >= 0));
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::errno_str(int err) -> std::string
+{
+  Buf err_msg_buf(1024, 0);
+
+  return std::string{strerror_r(err, err_msg_buf.data(), err_msg_buf.size())};
 }
 
 // -----------------------------------------------------------------------------
@@ -69,93 +193,37 @@ bool DataMgrFile::init(
   switch(request_type_)
   {
     case SrvReq::read:
-      // ... try find by md5
-      if(match_md5(opt.filename())) // name is md5 sum ?
-      {
-        L_INF("Match file as pure md5 request");
-
-        std::tie(ret, filename_) = full_search_md5(opt.filename());
-        if(ret)
-        {
-          L_INF("Find file via his md5 sum '"+filename_.string()+"'");
-        }
-      }
-
-      // ... Try find by filename
-      if(!ret)
-      {
-        std::tie(ret, filename_) = full_search_name(opt.filename());
-        if(ret)
-        {
-          L_INF("Find file via his name '"+filename_.string()+"'");
-        }
-      }
+      ret = search_file(opt.filename()) && (open_preload() || open_read());
+      break;
+    case SrvReq::write:
+      filename_ = get_root_dir();
+      filename_ /= opt.filename();
 
-      // ... Check result
-      if(!ret)
-      {
-        L_ERR("File not found '" + opt.filename() + "'");
-        set_error_if_first(1U, "File not found");
-      }
+      // ... Create file only if not exist
+      file_out_ = open(
+          filename_.c_str(),
+          O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+          0666);
 
-      // ... Try open
-      if(ret)
+      if((ret = (file_out_ >= 0)))
       {
-        auto backup_val = file_in_.exceptions();
-        file_in_.exceptions(std::ios::failbit);
-        try
-        {
-          file_in_.open(filename_, std::ios_base::in | std::ios::binary);
-        }
-        catch (const std::system_error & e)
+        // ... Forget cached lookup result of this name
+        if(auto cache = get_lookup_cache(); cache)
         {
-          ret = false;
-          L_ERR(std::string{"Error: "}+e.what()+" ("+
-                std::to_string(e.code().value())+")");
-          set_error_if_first(0U, e.what());
+          cache->erase(opt.filename());
         }
-        file_in_.close();
-        file_in_.exceptions(backup_val);
-        file_in_.open(filename_, std::ios_base::in | std::ios::binary);
       }
-
-      // ... Other
-      if(ret)
-      {
-        file_size_ = filesystem::file_size(filename_);
-      }
-
-      break;
-    case SrvReq::write:
-      // ... Check file exist
-      filename_ = get_root_dir();
-      filename_ /= opt.filename();
-      ret = !filesystem::exists(filename_);
-
-      // ... Result is wrong (file exist)
-      if(!ret)
+      else
+      if(errno == EEXIST)
       {
         L_ERR("File already exists '"+filename_.string()+"'");
         set_error_if_first(6U, "File already exists");
       }
-
-      // ... File not exist
-      if(ret)
+      else
       {
-        file_out_.exceptions(file_out_.exceptions() | std::ios::failbit);
-        try
-        {
-          file_out_.open(filename_, std::ios_base::out | std::ios::binary);
-          file_out_.write(nullptr, 0U);
-        }
-        catch (const std::system_error & e)
-        {
-          ret = false;
-          L_ERR(std::string{"Error: "}+e.what()+" ("+
-                std::to_string(e.code().value())+")");
-          set_error_if_first(0U, e.what());
-        }
-
+        auto err_msg = errno_str(errno);
+        L_ERR("Error: "+err_msg+" ("+filename_.string()+")");
+        set_error_if_first(0U, err_msg);
       }
       break;
     default:
@@ -169,9 +237,167 @@ bool DataMgrFile::init(
 
 // -----------------------------------------------------------------------------
 
+bool DataMgrFile::search_file(const std::string & name)
+{
+  bool ret = false;
+
+  auto start = std::chrono::steady_clock::now();
+
+  // ... try find by md5
+  if(match_md5(name)) // name is md5 sum ?
+  {
+    L_INF("Match file as pure md5 request");
+
+    std::tie(ret, filename_) = full_search_md5(name);
+    if(ret)
+    {
+      L_INF("Find file via his md5 sum '"+filename_.string()+"'");
+    }
+  }
+
+  // ... Try find by filename
+  if(!ret)
+  {
+    std::tie(ret, filename_) = full_search_name(name);
+    if(ret)
+    {
+      L_INF("Find file via his name '"+filename_.string()+"'");
+    }
+  }
+
+  Metrics::observe(
+      Hist::lookup,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start).count());
+
+  // ... Check result
+  if(!ret)
+  {
+    L_ERR("File not found '" + name + "'");
+    set_error_if_first(1U, "File not found");
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::locate(
+    pSettings & sett,
+    const std::string & name) -> std::tuple<bool, Path>
+{
+  settings_ = sett;
+  request_type_ = SrvReq::read;
+
+  bool ret = search_file(name);
+
+  return {ret, filename_};
+}
+
+// -----------------------------------------------------------------------------
+
+bool DataMgrFile::open_preload()
+{
+  auto preload = get_preload();
+  if(!preload) return false;
+
+  struct stat st;
+  if(stat(filename_.c_str(), & st) < 0) return false;
+
+  preload_img_ = preload->find(filename_.string(), file_id(st));
+  if(!preload_img_) return false;
+
+  L_DBG("Use preloaded file '"+filename_.string()+"'");
+  file_size_ = preload_img_->size();
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::read_memory(
+    const char * data,
+    SmBufEx::iterator buf_begin,
+    SmBufEx::iterator buf_end,
+    const size_t & position) -> ssize_t
+{
+  // Past end of file - no data (as pread); wrapped position - error
+  if(position >= file_size_) return (position > SSIZE_MAX) ? -1 : 0;
+
+  auto buf_size = std::distance(buf_begin, buf_end);
+  auto ret_size = static_cast<ssize_t>(file_size_ - position);
+  if(ret_size > 0)
+  {
+    if(ret_size > buf_size) ret_size = buf_size;
+
+    std::copy(data + position,
+              data + position + ret_size,
+              buf_begin);
+  }
+
+  return ret_size;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::read_blocks_memory(
+    const char * data,
+    const std::vector<BlkSlot> & slots,
+    const size_t & position) -> ssize_t
+{
+  // Past end of file - no data (as preadv); wrapped position - error
+  if(position >= file_size_) return (position > SSIZE_MAX) ? -1 : 0;
+
+  ssize_t ret = 0;
+  ssize_t left_size = static_cast<ssize_t>(file_size_ - position);
+  for(auto & [slot_begin, slot_end] : slots)
+  {
+    if(left_size <= 0) break;
+
+    ssize_t slot_size = std::distance(slot_begin, slot_end);
+    if(slot_size > left_size) slot_size = left_size;
+
+    std::copy(data + position + ret,
+              data + position + ret + slot_size,
+              slot_begin);
+
+    ret += slot_size;
+    left_size -= slot_size;
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+bool DataMgrFile::open_read()
+{
+  int err;
+  std::tie(file_in_, err) = FileFd::get(filename_.string());
+
+  if(!file_in_)
+  {
+    auto err_msg = errno_str(err);
+    L_ERR("Error: "+err_msg+" ("+filename_.string()+")");
+    set_error_if_first(0U, err_msg);
+    return false;
+  }
+
+  file_size_ = file_in_->size();
+
+  if(auto cache = get_block_cache(); cache && cache->enabled())
+  {
+    block_cache_ = cache;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
 auto DataMgrFile::write(
-    SmBufEx::const_iterator buf_begin,
-    SmBufEx::const_iterator buf_end,
+    const char * data,
+    size_t data_size,
     const size_t & position) -> ssize_t
 {
   if(request_type_ != SrvReq::write)
@@ -180,54 +406,174 @@ auto DataMgrFile::write(
         "Wrong use method (can't use rx() when request type != write");
   }
 
-  if(file_out_.is_open())
+  if(file_out_ < 0)
   {
-    if(auto buf_size=std::distance(buf_begin, buf_end); buf_size > 0)
-    {
-      ssize_t begin_pos=file_out_.tellp();
-      if(begin_pos != (ssize_t)position)
-      {
-        L_WRN("Change write position "+std::to_string(file_out_.tellp())+
-              " -> "+std::to_string(position));
-        file_out_.seekp(position);
-      }
+    L_ERR("File stream not opened");
+    set_error_if_first(0, "Server write stream not opened");
+    return -1;
+  }
 
-      begin_pos=file_out_.tellp();
-      if(file_out_.tellp() != (ssize_t)position)
-      {
-        L_ERR("File stream wrong seek position "+std::to_string(position));
-        set_error_if_first(0, "Server write stream seek failed");
-        return -1;
-      }
+  ssize_t buf_size = (ssize_t) data_size;
+  if((data == nullptr) || (buf_size <= 0))
+  {
+    L_WRN("Nothing to write (no data)");
+    return 0;
+  }
 
-      file_out_.write(& * buf_begin, buf_size);
-      ssize_t end_pos = file_out_.tellp();
-      if(end_pos < 0)
-      {
-        L_ERR("File stream wrong write at pos "+std::to_string(position));
-        set_error_if_first(0, "Server write stream failed - no writed data");
-        return -1;
-      }
+  ssize_t done = 0;
+  while(done < buf_size)
+  {
+    ssize_t ret = pwrite(
+        file_out_,
+        data + done,
+        buf_size - done,
+        position + done);
+
+    if(ret < 0)
+    {
+      if(errno == EINTR) continue;
 
-      return end_pos - begin_pos;
+      L_ERR("File wrong write at pos "+std::to_string(position + done)+
+            ": "+errno_str(errno));
+      set_error_if_first(0, "Server write stream failed - no writed data");
+      return -1;
     }
+
+    done += ret;
   }
-  else
+
+  return done;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::read(
+    SmBufEx::iterator buf_begin,
+    SmBufEx::iterator buf_end,
+    const size_t & position) -> ssize_t
+{
+  if(request_type_ != SrvReq::read)
+  {
+    throw std::runtime_error(
+        "Wrong use method (can't use tx() when request type != read");
+  }
+
+  if(preload_img_)
+  {
+    return read_memory(preload_img_->data(), buf_begin, buf_end, position);
+  }
+
+  if(!file_in_)
   {
     L_ERR("File stream not opened");
-    set_error_if_first(0, "Server write stream not opened");
+    set_error_if_first(0, "Server read stream not opened");
     return -1;
   }
 
-  L_WRN("Nothing to write (no data)");
-  return 0;
+  // Past end of file - no data (as pread); wrapped position - error
+  if(position >= file_size_) return (position > SSIZE_MAX) ? -1 : 0;
+
+  auto buf_size = std::distance(buf_begin, buf_end);
+  auto ret_size = static_cast<ssize_t>(file_size_ - position);
+  if(ret_size > 0)
+  {
+    if(ret_size > buf_size) ret_size = buf_size;
+
+    if(block_cache_)
+    {
+      ret_size = read_cached(& *buf_begin, (size_t) ret_size, position);
+    }
+    else
+    {
+      ret_size = read_fd(& *buf_begin, (size_t) ret_size, position);
+    }
+  }
+
+  return ret_size;
 }
 
 // -----------------------------------------------------------------------------
 
-auto DataMgrFile::read(
-    SmBufEx::iterator buf_begin,
-    SmBufEx::iterator buf_end,
+auto DataMgrFile::read_fd(
+    char * buf,
+    const size_t & size,
+    const size_t & position) -> ssize_t
+{
+  size_t done = 0U;
+  while(done < size)
+  {
+    ssize_t ret = pread(
+        file_in_->fd(),
+        buf + done,
+        size - done,
+        position + done);
+
+    if(ret < 0)
+    {
+      if(errno == EINTR) continue;
+
+      L_ERR("File wrong read at pos "+std::to_string(position + done)+
+            ": "+errno_str(errno));
+      set_error_if_first(0, "Server read stream failed");
+      return -1;
+    }
+
+    if(ret == 0) break; // file was truncated
+
+    done += (size_t) ret;
+  }
+
+  return (ssize_t) done;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::read_cached(
+    char * buf,
+    const size_t & size,
+    const size_t & position) -> ssize_t
+{
+  constexpr size_t chunk_size = constants::block_cache_chunk_size;
+
+  size_t done = 0U;
+  while(done < size)
+  {
+    size_t chunk = (position + done) / chunk_size;
+    size_t chunk_pos = chunk * chunk_size;
+
+    auto data = block_cache_->find(file_in_->id(), chunk);
+    if(!data)
+    {
+      ArenaBuf new_data(std::min(chunk_size, file_size_ - chunk_pos)); // not zeroed
+
+      ssize_t ret = read_fd(new_data.data(), new_data.size(), chunk_pos);
+      if(ret < 0) return -1;
+
+      bool whole = ((size_t) ret == new_data.size());
+      new_data.resize((size_t) ret);
+      data = std::make_shared<const ArenaBuf>(std::move(new_data));
+
+      // Not cache data of truncated file
+      if(whole) block_cache_->insert(file_in_->id(), chunk, data);
+    }
+
+    size_t offset = position + done - chunk_pos;
+    if(offset >= data->size()) break; // file was truncated
+
+    size_t part = std::min(size - done, data->size() - offset);
+    std::copy(data->cbegin() + offset,
+              data->cbegin() + offset + part,
+              buf + done);
+    done += part;
+  }
+
+  return (ssize_t) done;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::read_blocks(
+    const std::vector<BlkSlot> & slots,
     const size_t & position) -> ssize_t
 {
   if(request_type_ != SrvReq::read)
@@ -236,55 +582,124 @@ auto DataMgrFile::read(
         "Wrong use method (can't use tx() when request type != read");
   }
 
-  if(file_in_.is_open())
+  if(preload_img_)
+  {
+    return read_blocks_memory(preload_img_->data(), slots, position);
+  }
+
+  if(!file_in_)
   {
-    auto buf_size = std::distance(buf_begin, buf_end);
-    L_DBG("Generate block (buf size "+std::to_string(buf_size)+
-          "; position "+std::to_string(position)+")");
+    L_ERR("File stream not opened");
+    set_error_if_first(0, "Server read stream not opened");
+    return -1;
+  }
 
-    if(ssize_t curr_pos=file_in_.tellg(); curr_pos != (ssize_t)position)
+  // Copy from block cache to every slot
+  if(block_cache_)
+  {
+    ssize_t ret = 0;
+    for(auto & [slot_begin, slot_end] : slots)
     {
-      if(curr_pos >=0)
-      {
-        L_WRN("Change read position "+std::to_string(curr_pos)+
-              " -> "+std::to_string(position));
-      }
-      file_in_.seekg(position, std::ios_base::beg);
+      ssize_t slot_size = std::distance(slot_begin, slot_end);
+      ssize_t left_size = static_cast<ssize_t>(file_size_) -
+                          (ssize_t)(position + ret);
+      if(left_size <= 0) break;
+      if(slot_size > left_size) slot_size = left_size;
+
+      ssize_t blk_size = read_cached(& *slot_begin, slot_size, position + ret);
+      if(blk_size < 0) return -1;
+
+      ret += blk_size;
+      if(blk_size < slot_size) break; // file was truncated
     }
-    auto ret_size = static_cast<ssize_t>(file_size_) - (ssize_t)position;
-    if(ret_size > 0)
+
+    return ret;
+  }
+
+  // Prepare vector of slots clipped by file size
+  std::vector<struct iovec> iov;
+  iov.reserve(slots.size());
+
+  ssize_t need_size = 0;
+  ssize_t left_size = static_cast<ssize_t>(file_size_) - (ssize_t)position;
+  for(auto & [slot_begin, slot_end] : slots)
+  {
+    if(left_size <= 0) break;
+
+    ssize_t slot_size = std::distance(slot_begin, slot_end);
+    if(slot_size > left_size) slot_size = left_size;
+
+    iov.push_back({& *slot_begin, (size_t) slot_size});
+    need_size += slot_size;
+    left_size -= slot_size;
+  }
+
+  // Read with continue after interrupt or partial read
+  ssize_t done = 0;
+  size_t iov_idx = 0U;
+  while((done < need_size) && (iov_idx < iov.size()))
+  {
+    ssize_t ret = preadv(
+        file_in_->fd(),
+        iov.data() + iov_idx,
+        (int) std::min(iov.size() - iov_idx, (size_t) IOV_MAX),
+        position + done);
+
+    if(ret < 0)
     {
+      if(errno == EINTR) continue;
+
+      L_ERR("File wrong read at pos "+std::to_string(position + done)+
+            ": "+errno_str(errno));
+      set_error_if_first(0, "Server read stream failed");
+      return -1;
+    }
+
+    if(ret == 0) break; // file was truncated
+
+    done += ret;
 
-      try
+    // Skip processed slots
+    while((ret > 0) && (iov_idx < iov.size()))
+    {
+      auto & curr = iov[iov_idx];
+      if((size_t) ret >= curr.iov_len)
       {
-        file_in_.read(& *buf_begin, buf_size);
+        ret -= curr.iov_len;
+        ++iov_idx;
       }
-      catch (const std::system_error & e)
+      else
       {
-        if(file_in_.fail())
-        {
-          L_ERR(std::string{"Error: "}+e.what()+" ("+
-                std::to_string(e.code().value())+")");
-        }
+        curr.iov_base = (char *) curr.iov_base + ret;
+        curr.iov_len -= ret;
+        ret = 0;
       }
-
-      if(ret_size > buf_size) ret_size = buf_size;
     }
-    return ret_size;
   }
 
-  // not opened
-  L_ERR("File stream not opened");
-  set_error_if_first(0, "Server read stream not opened");
-  return -1;
+  return done;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrFile::path() const -> std::string
+{
+  return filename_.string();
 }
 
 // -----------------------------------------------------------------------------
 
 void DataMgrFile::close()
 {
-  if(file_in_ .is_open()) file_in_ .close();
-  if(file_out_.is_open()) file_out_.close();
+  file_in_.reset();
+  block_cache_.reset();
+  preload_img_.reset();
+
+  if(file_out_ >= 0)
+  {
+    ::close(file_out_);
+    file_out_ = -1;
+  }
 
   if(request_type_ == SrvReq::write)
   {
@@ -351,11 +766,10 @@ auto DataMgrFile::search_by_md5(
       file_md5.getline(line1.data(), line1.size(), '\n');
 
       // check md5
-      std::regex regex_md5_sum(constants::regex_template_md5);
-      std::smatch sm_sum;
-      if(std::regex_search(line1, sm_sum, regex_md5_sum))
+      std::string_view line{line1.c_str()};
+      if(auto pos = find_md5(line); pos != std::string_view::npos)
       {
-        if(sm_sum[1].str() == md5sum) // md5 matched!
+        if(line.substr(pos, constants::md5_str_len) == md5sum) // matched!
         {
           L_DBG("Match md5 sum at file '"+curr.string()+"'");
 
@@ -363,10 +777,13 @@ auto DataMgrFile::search_by_md5(
           curr.replace_extension("");
           if(filesystem::exists(curr)) return {true, curr};
 
-          // Try filename from md5 file
-          if(sm_sum.suffix().str().size())
+          // Try filename from md5 file ("<md5> [*]<filename>")
+          auto suffix = line.substr(pos + constants::md5_str_len);
+          suffix.remove_prefix(
+              std::min(suffix.find_first_not_of(" \t*"), suffix.size()));
+          if(suffix.size())
           {
-            curr.replace_filename(sm_sum.suffix().str());
+            curr.replace_filename(std::string{suffix});
             if(filesystem::exists(curr)) return {true, curr};
           }
 
@@ -413,28 +830,60 @@ auto DataMgrFile::full_search_md5(std::string_view md5sum)
 auto DataMgrFile::full_search_name(std::string_view name)
     -> std::tuple<bool, Path>
 {
-  // Search in main dir
-  Path curr_file{get_root_dir()};
-  curr_file /= name;
-  if(filesystem::exists(curr_file) &&
-     filesystem::is_regular_file(curr_file))
+  std::string name_str{name};
+
+  // Try cached result
+  auto cache = get_lookup_cache();
+  if(cache)
   {
-    return {true, curr_file};
+    auto [res, path] = cache->find(name_str);
+    switch(res)
+    {
+      case TripleResult::ok:
+        L_DBG("Lookup cache hit '"+name_str+"'");
+        return {true, Path{path}};
+      case TripleResult::fail:
+        L_DBG("Lookup cache hit '"+name_str+"' (not found)");
+        return {false, Path()};
+      case TripleResult::nop:
+        break;
+    }
   }
 
-  // Search in secondary dirs
-  for(const auto & path : get_serach_dir())
+  // Taken before search - result not cached if directories changed meanwhile
+  uint64_t generation = cache ? cache->generation() : 0U;
+
+  std::vector<std::string> dirs; // watched before check
+
+  auto check_file = [&](const std::string & dir) -> std::tuple<bool, Path>
   {
-    Path curr_file{path};
+    Path curr_file{dir};
     curr_file /= name;
-    if(filesystem::exists(curr_file) &&
-       filesystem::is_regular_file(curr_file))
+    if(cache)
     {
-      return {true, curr_file};
+      dirs.push_back(curr_file.parent_path().string());
+      cache->watch(dirs.back());
+    }
+    return {filesystem::exists(curr_file) &&
+            filesystem::is_regular_file(curr_file), curr_file};
+  };
+
+  // Search in main dir
+  auto [res, file] = check_file(get_root_dir());
+
+  // Search in secondary dirs
+  if(!res)
+  {
+    for(const auto & path : get_serach_dir())
+    {
+      if(std::tie(res, file) = check_file(path); res) break;
     }
   }
 
-  return {false, Path()};
+  if(!res) file = Path();
+  if(cache) cache->insert(name_str, generation, res, file.string(), dirs);
+
+  return {res, file};
 }
 // -----------------------------------------------------------------------------
 
@@ -15,8 +15,8 @@
 #ifndef SOURCE_TFTP_DATA_MGR_H_
 #define SOURCE_TFTP_DATA_MGR_H_
 
-#include <fstream>
 #include <experimental/filesystem>
+#include <sys/stat.h>
 //#include <experimental/bits/fs_fwd.h>
 
 #include "tftpCommon.h"
@@ -33,16 +33,101 @@ using Path = filesystem::path;
 
 using Perms = filesystem::perms;
 
+/** \brief Get file identity from file status
+ *
+ *  \param [in] st File status
+ *  \return File identity
+ */
+auto file_id(const struct stat & st) -> FileId;
+
+// -----------------------------------------------------------------------------
+
+/** \brief Read only file descriptor
+ *
+ *  One descriptor shared by all sessions served the same file; read with
+ *  pread() not change descriptor position.
+ *  Create only from FileFd::get() as shared pointer.
+ */
+class FileFd
+{
+protected:
+
+  int    fd_; ///< File descriptor
+  FileId id_; ///< File identity at open moment
+
+  /** \brief Constructor
+   *
+   *  \param [in] fd Opened file descriptor
+   *  \param [in] id File identity
+   */
+  FileFd(int fd, const FileId & id);
+
+public:
+
+  FileFd(const FileFd &) = delete; ///< Deleted/unused
+
+  FileFd & operator=(const FileFd &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Close descriptor
+   */
+  virtual ~FileFd();
+
+  /** \brief Get opened descriptor of file
+   *
+   *  If file (device, inode, size, modify time) already opened,
+   *  then return exist descriptor, else open file
+   *  \param [in] path Path to file
+   *  \return Tuple<pointer to descriptor (nullptr on error); errno value>
+   */
+  static auto get(const std::string & path)
+      -> std::tuple<std::shared_ptr<FileFd>, int>;
+
+  /** \brief Get file descriptor
+   *
+   *  \return Descriptor
+   */
+  auto fd() const -> int;
+
+  /** \brief Get size of file
+   *
+   *  \return Size
+   */
+  auto size() const -> size_t;
+
+  /** \brief Get file identity
+   *
+   *  \return Identity
+   */
+  auto id() const -> const FileId &;
+};
+
+using pFileFd = std::shared_ptr<FileFd>;
+
 // -----------------------------------------------------------------------------
 
 /** \brief Data manage streams for files
+ *
+ *  Files read with pread() and write with pwrite() at block position;
+ *  if block cache enabled, then read data served from cache;
+ *  preloaded files served from memory
  */
 class DataMgrFile: public DataMgr, public Base
 {
 protected:
-  Path          filename_; ///< File path with name; constructed after init()
-  std::ifstream file_in_;  ///< Input file stream
-  std::ofstream file_out_; ///< Output file stream
+  Path    filename_; ///< File path with name; constructed after init()
+  pFileFd file_in_;  ///< Input file descriptor (shared)
+  int     file_out_; ///< Output file descriptor (-1 if closed)
+  pBlockCache block_cache_; ///< Block cache for read (nullptr if not used)
+  pPreloadImage preload_img_; ///< Preloaded file (nullptr if not used)
+
+  /** \brief Get text of system error
+   *
+   *  \param [in] err Value of errno
+   *  \return Error text
+   */
+  static auto errno_str(int err) -> std::string;
 
   /** \brief Recursive search file by md5 in directory
    *
@@ -71,12 +156,88 @@ protected:
    *
    *  If finded OK, then open input file stream
    *  Used main server directory and search directories
+   *  Result (found or not found) is cached in lookup cache
    *  \param [in] name Root search directory
    *  \return Tuple<found/not found; Path to real file>
    */
   auto full_search_name(std::string_view name)
       -> std::tuple<bool, Path>;
 
+  /** \brief Search requested file by md5 sum or by name
+   *
+   *  If found, then set filename_; else forward error "File not found"
+   *  \param [in] name Requested name (md5 sum or file name)
+   *  \return True if found, else - false
+   */
+  bool search_file(const std::string & name);
+
+  /** \brief Copy data from memory with whole file content
+   *
+   *  \param [in] data Begin of file content
+   *  \param [in] buf_begin Buffer begin iterator
+   *  \param [in] buf_end Buffer end iterator
+   *  \param [in] position Position in file
+   *  \return Processed size; 0 - position at or past end of file;
+   *          -1 - wrong (wrapped) position
+   */
+  auto read_memory(
+      const char * data,
+      SmBufEx::iterator buf_begin,
+      SmBufEx::iterator buf_end,
+      const size_t & position) -> ssize_t;
+
+  /** \brief Copy data of sequential blocks from memory with file content
+   *
+   *  \param [in] data Begin of file content
+   *  \param [in] slots Slots for data of blocks
+   *  \param [in] position Position of first block (offset)
+   *  \return Total processed size; 0 - position at or past end of file;
+   *          -1 - wrong (wrapped) position
+   */
+  auto read_blocks_memory(
+      const char * data,
+      const std::vector<BlkSlot> & slots,
+      const size_t & position) -> ssize_t;
+
+  /** \brief Use preloaded content of found file (filename_) for read
+   *
+   *  Used only if file not changed after preload; set file_size_ on success
+   *  \return True if preloaded file used, else - false
+   */
+  bool open_preload();
+
+  /** \brief Read data from input file descriptor
+   *
+   *  \param [out] buf Buffer for data
+   *  \param [in] size Size of data to read
+   *  \param [in] position Position in file
+   *  \return Processed size (less if file truncated), -1 on error
+   */
+  auto read_fd(
+      char * buf,
+      const size_t & size,
+      const size_t & position) -> ssize_t;
+
+  /** \brief Read data through block cache
+   *
+   *  Missed chunks read from input file descriptor and stored to cache
+   *  \param [out] buf Buffer for data
+   *  \param [in] size Size of data to read
+   *  \param [in] position Position in file
+   *  \return Processed size (less if file truncated), -1 on error
+   */
+  auto read_cached(
+      char * buf,
+      const size_t & size,
+      const size_t & position) -> ssize_t;
+
+  /** \brief Open found file (filename_) for read
+   *
+   *  Set file_size_ on success; use block cache if enabled
+   *  \return True if success, else - false
+   */
+  virtual bool open_read();
+
 public:
 
   /** \brief Default constructor
@@ -101,6 +262,16 @@ public:
    */
   virtual ~DataMgrFile() override;
 
+  /** \brief Search file by md5 sum or by name without open
+   *
+   *  \param [in] sett Settings of tftp server
+   *  \param [in] name Requested name (md5 sum or file name)
+   *  \return Tuple<found/not found; Path to real file>
+   */
+  auto locate(
+      pSettings & sett,
+      const std::string & name) -> std::tuple<bool, Path>;
+
   /** Check active (opened stream)
    *
    *  Overrided virtual method for file streams
@@ -123,14 +294,14 @@ public:
   /** \brief Pull data from network (receive)
    *
    *  Overrided virtual method for file streams
-   *  \param [in] buf_begin Buffer begin iterator
-   *  \param [in] buf_end Buffer end iterator
+   *  \param [in] data Pointer to received data
+   *  \param [in] data_size Size of received data
    *  \param [in] position Position received block
-   *  \return 0 on success, -1 on error
+   *  \return Processed size, -1 on error
    */
   virtual auto write(
-      SmBufEx::const_iterator buf_begin,
-      SmBufEx::const_iterator buf_end,
+      const char * data,
+      size_t data_size,
       const size_t & position) -> ssize_t override;
 
   /** \brief Push data to network (transmit)
@@ -146,11 +317,29 @@ public:
       SmBufEx::iterator buf_end,
       const size_t & position) -> ssize_t override;
 
+  /** \brief Read data of sequential blocks
+   *
+   *  Overrided virtual method for files; one preadv() for all slots
+   *  \param [in] slots Slots for data of blocks
+   *  \param [in] position Position of first block (offset)
+   *  \return Total processed size, -1 on error
+   */
+  virtual auto read_blocks(
+      const std::vector<BlkSlot> & slots,
+      const size_t & position) -> ssize_t override;
+
   /**  Close all opened steams
    *
    *  Overrided virtual method for file streams
    */
   virtual void close() override;
+
+  /** \brief Get resolved path of served file
+   *
+   *  Overrided virtual method for file streams
+   *  \return Path
+   */
+  virtual auto path() const -> std::string override;
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,223 @@
+/**
+ * \file tftpDataMgrMmap.cpp
+ * \brief Data manager class for memory mapped files module
+ *
+ *  Data manager for read files via memory mapping
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tftpDataMgrMmap.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Size of file head advised to read ahead right after mapping
+  constexpr size_t mmap_willneed_size = 4U*1024U*1024U;
+}
+
+// -----------------------------------------------------------------------------
+
+MmapFile::MmapFile(const char * data, size_t size):
+    data_{data},
+    size_{size}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+MmapFile::~MmapFile()
+{
+  if(data_ != nullptr) munmap((void *) data_, size_);
+}
+
+// -----------------------------------------------------------------------------
+
+auto MmapFile::data() const -> const char *
+{
+  return data_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto MmapFile::size() const -> size_t
+{
+  return size_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto MmapFile::get(const std::string & path) -> std::tuple<pMmapFile, int>
+{
+  // Registry of mappings in use; entry erased by deleter of last owner
+  // (never destroyed - owners can outlive static objects)
+  static auto & mutex = * new std::mutex;
+  static auto & mapped = * new std::map<FileId, std::weak_ptr<MmapFile>>;
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd < 0) return {nullptr, errno};
+
+  struct stat st;
+  if(fstat(fd, & st) < 0)
+  {
+    int err = errno;
+    ::close(fd);
+    return {nullptr, err};
+  }
+
+  auto key = file_id(st);
+
+  pMmapFile ret{nullptr};
+
+  std::lock_guard lk{mutex};
+
+  auto it = mapped.find(key);
+  if(it != mapped.end()) ret = it->second.lock();
+
+  if(!ret)
+  {
+    void * addr = nullptr;
+    size_t size = (size_t) st.st_size;
+    if(size > 0U) // can't map empty file
+    {
+      addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if(addr == MAP_FAILED)
+      {
+        int err = errno;
+        ::close(fd);
+        return {nullptr, err};
+      }
+
+      madvise(addr, size, MADV_SEQUENTIAL);
+      madvise(addr,
+              std::min(size, constants::mmap_willneed_size),
+              MADV_WILLNEED);
+    }
+
+    ret = pMmapFile{
+        new MmapFile((const char *) addr, size),
+        [key](MmapFile * p)
+        {
+          {
+            std::lock_guard lk_del{mutex};
+            auto it_del = mapped.find(key);
+            // Entry can be replaced by new mapping of same file
+            if((it_del != mapped.end()) && it_del->second.expired())
+            {
+              mapped.erase(it_del);
+            }
+          }
+          delete p;
+        }};
+    mapped[key] = ret; // replace stale entry (if was)
+  }
+
+  ::close(fd); // mapping still valid
+
+  return {ret, 0};
+}
+
+// -----------------------------------------------------------------------------
+
+DataMgrMmap::DataMgrMmap():
+    DataMgrFile(),
+    map_{nullptr}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+DataMgrMmap::~DataMgrMmap()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+bool DataMgrMmap::active() const
+{
+  return ((request_type_ == SrvReq::read) && map_) || DataMgrFile::active();
+}
+
+// -----------------------------------------------------------------------------
+
+bool DataMgrMmap::open_read()
+{
+  auto [new_map, err] = MmapFile::get(filename_.string());
+
+  if(!new_map)
+  {
+    L_WRN("Can't map file '"+filename_.string()+"' ("+errno_str(err)+
+          "); use file descriptor");
+
+    return DataMgrFile::open_read();
+  }
+
+  map_ = new_map;
+  file_size_ = map_->size();
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrMmap::read(
+    SmBufEx::iterator buf_begin,
+    SmBufEx::iterator buf_end,
+    const size_t & position) -> ssize_t
+{
+  if(!map_) return DataMgrFile::read(buf_begin, buf_end, position);
+
+  if(request_type_ != SrvReq::read)
+  {
+    throw std::runtime_error(
+        "Wrong use method (can't use tx() when request type != read");
+  }
+
+  return read_memory(map_->data(), buf_begin, buf_end, position);
+}
+
+// -----------------------------------------------------------------------------
+
+auto DataMgrMmap::read_blocks(
+    const std::vector<BlkSlot> & slots,
+    const size_t & position) -> ssize_t
+{
+  if(!map_) return DataMgrFile::read_blocks(slots, position);
+
+  if(request_type_ != SrvReq::read)
+  {
+    throw std::runtime_error(
+        "Wrong use method (can't use tx() when request type != read");
+  }
+
+  return read_blocks_memory(map_->data(), slots, position);
+}
+
+// -----------------------------------------------------------------------------
+
+void DataMgrMmap::close()
+{
+  map_.reset();
+
+  DataMgrFile::close();
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
@@ -0,0 +1,154 @@
+/**
+ * \file tftpDataMgrMmap.h
+ * \brief Data manager class for memory mapped files header
+ *
+ *  Data manager for read files via memory mapping
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPDATAMGRMMAP_H_
+#define SOURCE_TFTPDATAMGRMMAP_H_
+
+#include <sys/types.h>
+
+#include "tftpDataMgrFile.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+/** \brief Read only memory mapping of whole file
+ *
+ *  One mapping shared by all sessions served the same file.
+ *  Create only from MmapFile::get() as shared pointer.
+ */
+class MmapFile
+{
+protected:
+
+  const char * data_; ///< Begin of mapped memory (nullptr for empty file)
+  size_t       size_; ///< Size of mapped file
+
+  /** \brief Constructor
+   *
+   *  \param [in] data Begin of mapped memory
+   *  \param [in] size Size of mapped memory
+   */
+  MmapFile(const char * data, size_t size);
+
+public:
+
+  MmapFile(const MmapFile &) = delete; ///< Deleted/unused
+
+  MmapFile & operator=(const MmapFile &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Unmap memory
+   */
+  virtual ~MmapFile();
+
+  /** \brief Get mapping of file
+   *
+   *  If file (device, inode, size, modify time) already mapped,
+   *  then return exist mapping, else map file
+   *  \param [in] path Path to file
+   *  \return Tuple<pointer to mapping (nullptr on error); errno value>
+   */
+  static auto get(const std::string & path)
+      -> std::tuple<std::shared_ptr<MmapFile>, int>;
+
+  /** \brief Get begin of mapped memory
+   *
+   *  \return Pointer
+   */
+  auto data() const -> const char *;
+
+  /** \brief Get size of mapped file
+   *
+   *  \return Size
+   */
+  auto size() const -> size_t;
+};
+
+using pMmapFile = std::shared_ptr<MmapFile>;
+
+// -----------------------------------------------------------------------------
+
+/** \brief Data manager for read files via memory mapping
+ *
+ *  Read requests served from read only memory mapping of file (shared with
+ *  other sessions); block read is a memcpy from mapping.
+ *  If mapping failed, then used pread() (DataMgrFile).
+ *  Write requests served by DataMgrFile.
+ *  Warning! Truncate of mapped file by other process cause SIGBUS;
+ *  enabled only by option "--mmap" - use it if files in server directories
+ *  never changed while served.
+ */
+class DataMgrMmap: public DataMgrFile
+{
+protected:
+
+  pMmapFile map_; ///< Mapping of file (for read request)
+
+  /** \brief Open found file (filename_) for read
+   *
+   *  Try map file, if fail then open file descriptor
+   *  \return True if success, else - false
+   */
+  virtual bool open_read() override;
+
+public:
+
+  /** \brief Default constructor
+   */
+  DataMgrMmap();
+
+  /** \brief Destructor
+   */
+  virtual ~DataMgrMmap() override;
+
+  /** Check active (opened mapping or stream)
+   */
+  virtual bool active() const override;
+
+  /** \brief Push data to network (transmit)
+   *
+   *  \param [in] buf_begin Buffer begin iterator
+   *  \param [in] buf_end Buffer end iterator
+   *  \param [in] position Position transmitted block
+   *  \return Processed size, -1 on error
+   */
+  virtual auto read(
+      SmBufEx::iterator buf_begin,
+      SmBufEx::iterator buf_end,
+      const size_t & position) -> ssize_t override;
+
+  /** \brief Read data of sequential blocks
+   *
+   *  Copy from mapping to each slot
+   *  \param [in] slots Slots for data of blocks
+   *  \param [in] position Position of first block (offset)
+   *  \return Total processed size, -1 on error
+   */
+  virtual auto read_blocks(
+      const std::vector<BlkSlot> & slots,
+      const size_t & position) -> ssize_t override;
+
+  /** \brief Close mapping and all opened steams
+   */
+  virtual void close() override;
+};
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPDATAMGRMMAP_H_ */
@@ -0,0 +1,308 @@
+/**
+ * \file tftpLogRing.cpp
+ * \brief Asynchronous log writer class module
+ *
+ *  Per-thread lock-free log rings drained to syslog by one writer thread
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <syslog.h>
+#include <unistd.h>
+
+#include "tftpLogRing.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+
+/// Rings of current thread for all writers
+///
+/// Ring owned by writer; thread hold only weak reference (ring memory
+/// released with writer, expired entries removed on next registration)
+struct ThreadRings
+{
+  std::vector<std::tuple<size_t, LogWriter::Ring *, std::weak_ptr<LogWriter::Ring>>> rings;
+
+  ~ThreadRings()
+  {
+    for(auto & [id, ptr, weak] : rings)
+    {
+      if(auto ring = weak.lock(); ring) ring->closed = true;
+    }
+  }
+};
+
+thread_local ThreadRings thread_rings;
+
+thread_local const int thread_tid = (int) syscall(SYS_gettid);
+
+std::atomic<size_t> writer_count{0U};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+LogWriter::LogWriter():
+    id_{++writer_count},
+    mutex_{},
+    drain_mutex_{},
+    rings_{},
+    thread_{},
+    stop_{false},
+    written_{0U},
+    dropped_{0U},
+    event_fd_{eventfd(0U, EFD_CLOEXEC)},
+    signaled_{false}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+LogWriter::~LogWriter()
+{
+  stop_writer();
+
+  // Release rings (thread-local references of threads are weak)
+  {
+    std::lock_guard lk{mutex_};
+    rings_.clear();
+  }
+
+  if(event_fd_ >= 0) close(event_fd_);
+}
+
+// -----------------------------------------------------------------------------
+
+void LogWriter::stop_writer()
+{
+  stop_ = true;
+  wake();
+  if(thread_.joinable()) thread_.join();
+
+  std::lock_guard lk{drain_mutex_};
+  drain();
+}
+
+// -----------------------------------------------------------------------------
+
+void LogWriter::wake()
+{
+  if(event_fd_ < 0) return;
+
+  uint64_t val = 1U;
+  if(::write(event_fd_, & val, sizeof(val))) {};
+}
+
+// -----------------------------------------------------------------------------
+
+auto LogWriter::ring() -> Ring &
+{
+  auto & rings = thread_rings.rings;
+  for(auto & [id, ptr, weak] : rings)
+  {
+    if(id == id_) return * ptr; // alive while writer alive
+  }
+
+  // Forget rings of destroyed writers
+  rings.erase(std::remove_if(rings.begin(), rings.end(),
+                             [](const auto & item)
+                             {
+                               return std::get<2>(item).expired();
+                             }),
+              rings.end());
+
+  pRing ret{new Ring}; // not make_shared: weak reference not hold memory
+  rings.emplace_back(id_, ret.get(), ret);
+
+  std::lock_guard lk{mutex_};
+  rings_.push_back(ret);
+  if(!thread_.joinable() && !stop_)
+  {
+    thread_ = std::thread(& LogWriter::writer_loop, this);
+  }
+
+  return * ret;
+}
+
+// -----------------------------------------------------------------------------
+
+bool LogWriter::push(LogLvl lvl, std::string_view msg)
+{
+  Ring & r = ring();
+
+  size_t head = r.head.load(std::memory_order_relaxed);
+  if(head - r.tail.load(std::memory_order_acquire) >= r.entries.size())
+  {
+    r.dropped.fetch_add(1U, std::memory_order_relaxed);
+    return false;
+  }
+
+  Entry & e = r.entries[head % r.entries.size()];
+  e.lvl = lvl;
+  e.tid = thread_tid;
+  e.size = (uint16_t) std::min(msg.size(), e.text.size() - 1U);
+  memcpy(e.text.data(), msg.data(), e.size);
+  e.text[e.size] = 0;
+
+  r.head.store(head + 1U, std::memory_order_release);
+
+  // Pair with fence of writer loop: either writer see new head or
+  // producer see cleared flag and wake it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(!signaled_.load(std::memory_order_relaxed) && !signaled_.exchange(true))
+  {
+    wake();
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+auto LogWriter::drain() -> size_t
+{
+  std::vector<pRing> curr_rings;
+  {
+    std::lock_guard lk{mutex_};
+    curr_rings.assign(rings_.begin(), rings_.end());
+  }
+
+  size_t ret = 0U;
+  for(auto & r : curr_rings)
+  {
+    bool was_closed = r->closed; // check before read - no new messages after
+
+    size_t tail = r->tail.load(std::memory_order_relaxed);
+    while(tail != r->head.load(std::memory_order_acquire))
+    {
+      write(r->entries[tail % r->entries.size()]);
+      r->tail.store(++tail, std::memory_order_release);
+      ++ret;
+    }
+
+    if(was_closed)
+    {
+      dropped_ += r->dropped;
+      std::lock_guard lk{mutex_};
+      rings_.remove(r);
+    }
+  }
+
+  written_ += ret;
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void LogWriter::writer_loop()
+{
+  while(!stop_)
+  {
+    signaled_.store(false, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    size_t cnt;
+    {
+      std::lock_guard lk{drain_mutex_};
+      cnt = drain();
+    }
+
+    if(cnt || stop_) continue;
+
+    if(event_fd_ >= 0)
+    {
+      uint64_t val;
+      if(read(event_fd_, & val, sizeof(val))) {}; // wait producer or stop
+    }
+    else
+    {
+      usleep(constants::log_ring_idle_us);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void LogWriter::write(const Entry & entry)
+{
+  syslog((int) entry.lvl,
+         "[%d] %s %s",
+         entry.tid,
+         to_string(entry.lvl).data(),
+         entry.text.data());
+}
+
+// -----------------------------------------------------------------------------
+
+void LogWriter::flush()
+{
+  std::lock_guard lk{drain_mutex_};
+  drain();
+}
+
+// -----------------------------------------------------------------------------
+
+auto LogWriter::stat() const -> std::tuple<size_t, size_t>
+{
+  size_t dropped = dropped_;
+  {
+    std::lock_guard lk{mutex_};
+    for(auto & r : rings_) dropped += r->dropped;
+  }
+
+  return {written_.load(), dropped};
+}
+
+// -----------------------------------------------------------------------------
+
+LogFileWriter::LogFileWriter(const std::string & path):
+    LogWriter(),
+    file_{fopen(path.c_str(), "ae")}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+LogFileWriter::~LogFileWriter()
+{
+  stop_writer();
+
+  if(file_) fclose(file_);
+}
+
+// -----------------------------------------------------------------------------
+
+void LogFileWriter::write(const Entry & entry)
+{
+  if(!file_) return;
+
+  fwrite(entry.text.data(), 1U, entry.size, file_);
+  fputc('\n', file_);
+  fflush(file_);
+}
+
+// -----------------------------------------------------------------------------
+
+bool LogFileWriter::is_open() const
+{
+  return file_ != nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
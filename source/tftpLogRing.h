@@ -0,0 +1,222 @@
+/**
+ * \file tftpLogRing.h
+ * \brief Asynchronous log writer class header
+ *
+ *  Per-thread lock-free log rings drained to syslog by one writer thread
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPLOGRING_H_
+#define SOURCE_TFTPLOGRING_H_
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Count of messages in ring of one thread
+  constexpr size_t log_ring_entries = 128U;
+
+  /// Maximum size of one message in ring (longer messages truncated)
+  constexpr size_t log_ring_msg_size = 600U;
+
+  /// Sleep time of idle writer thread if eventfd not available (microseconds)
+  constexpr int log_ring_idle_us = 2000;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Asynchronous log writer
+ *
+ *  Each logging thread push messages to own single-producer ring without
+ *  locks; one writer thread drain rings to syslog. If ring full, message
+ *  dropped and counted. Ring registered once per thread (under mutex) and
+ *  released after thread exit when drained or on writer destruction.
+ *  Idle writer thread sleep on eventfd; producer wake it only once per
+ *  drain (first message after writer went idle).
+ *  Writer thread started on first message; rest messages written on
+ *  destruction.
+ */
+class LogWriter
+{
+public:
+
+  /// Message in ring
+  struct Entry
+  {
+    LogLvl   lvl;  ///< Level of message
+    int      tid;  ///< Thread id of producer
+    uint16_t size; ///< Size of text
+    std::array<char, constants::log_ring_msg_size> text; ///< Text (zero end)
+  };
+
+  /// Single-producer single-consumer ring of one thread
+  struct Ring
+  {
+    std::array<Entry, constants::log_ring_entries> entries; ///< Messages
+    std::atomic<size_t> head{0U};     ///< Next write position (producer)
+    std::atomic<size_t> tail{0U};     ///< Next read position (writer)
+    std::atomic<size_t> dropped{0U};  ///< Count of dropped messages
+    std::atomic_bool    closed{false}; ///< Flag: producer thread finished
+  };
+
+  using pRing = std::shared_ptr<Ring>;
+
+protected:
+
+  const size_t id_; ///< Unique writer id (for thread-local rings)
+
+  mutable std::mutex mutex_; ///< Mutex for rings list and writer thread start
+
+  std::mutex drain_mutex_; ///< Mutex for single consumer of rings
+
+  std::list<pRing> rings_; ///< Rings of producer threads
+
+  std::thread thread_; ///< Writer thread
+
+  std::atomic_bool stop_; ///< Flag: stop writer thread
+
+  std::atomic<size_t> written_; ///< Count of written messages
+
+  std::atomic<size_t> dropped_; ///< Count of dropped messages (released rings)
+
+  int event_fd_; ///< Wakeup of writer thread (-1 if not available)
+
+  std::atomic_bool signaled_; ///< Flag: wakeup sent after last drain
+
+  /** \brief Wake writer thread
+   */
+  void wake();
+
+  /** \brief Get ring of current thread
+   *
+   *  Register new ring on first call in thread
+   *  \return Reference to ring
+   */
+  auto ring() -> Ring &;
+
+  /** \brief Write all messages from rings
+   *
+   *  Released rings of finished threads removed.
+   *  Need locked drain_mutex_
+   *  \return Count of written messages
+   */
+  auto drain() -> size_t;
+
+  /** \brief Writer thread loop
+   */
+  void writer_loop();
+
+  /** \brief Stop writer thread and write rest of messages
+   *
+   *  Call from destructor of child class (virtual write() of child not
+   *  available in destructor of this class)
+   */
+  void stop_writer();
+
+  /** \brief Write one message to syslog
+   *
+   *  \param [in] entry Message
+   */
+  virtual void write(const Entry & entry);
+
+public:
+
+  /** \brief Default constructor
+   */
+  LogWriter();
+
+  LogWriter(const LogWriter &) = delete; ///< Deleted/unused
+
+  LogWriter & operator=(const LogWriter &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Stop writer thread and write rest of messages
+   */
+  virtual ~LogWriter();
+
+  /** \brief Push message (never blocks)
+   *
+   *  \param [in] lvl Level of message
+   *  \param [in] msg Text of message
+   *  \return True if pushed, false if dropped (ring full)
+   */
+  bool push(LogLvl lvl, std::string_view msg);
+
+  /** \brief Write all pushed messages now
+   *
+   *  Wait while writer thread drain rings
+   */
+  void flush();
+
+  /** \brief Get count of written and dropped messages
+   *
+   *  \return Tuple<written; dropped>
+   */
+  auto stat() const -> std::tuple<size_t, size_t>;
+};
+
+// -----------------------------------------------------------------------------
+
+/** \brief Asynchronous writer of lines to file
+ *
+ *  Same rings as LogWriter; each message written to file as one line
+ *  (level and thread id not written)
+ */
+class LogFileWriter: public LogWriter
+{
+protected:
+
+  FILE * file_; ///< Opened file (nullptr if not opened)
+
+  /** \brief Write one message as line to file
+   *
+   *  \param [in] entry Message
+   */
+  virtual void write(const Entry & entry) override;
+
+public:
+
+  /** \brief Constructor
+   *
+   *  Open file for append
+   *  \param [in] path Path to file
+   */
+  LogFileWriter(const std::string & path);
+
+  /** \brief Destructor
+   *
+   *  Stop writer thread, write rest of messages and close file
+   */
+  virtual ~LogFileWriter() override;
+
+  /** \brief Check file opened
+   *
+   *  \return True if opened, else - false
+   */
+  bool is_open() const;
+};
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPLOGRING_H_ */
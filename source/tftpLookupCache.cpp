@@ -0,0 +1,357 @@
+/**
+ * \file tftpLookupCache.cpp
+ * \brief Lookup cache class module
+ *
+ *  Cache of resolved (and not found) requested file names
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "tftpLookupCache.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+LookupCache::LookupCache(size_t max_size, int ttl):
+    mutex_{},
+    items_{},
+    order_{},
+    watched_{},
+    wd_names_{},
+    max_size_{max_size},
+    ttl_{ttl > 0 ? ttl : 0},
+    inotify_fd_{-1},
+    stop_fd_{-1},
+    watcher_{},
+    generation_{0U},
+    hits_{0U},
+    misses_{0U}
+{
+  if(ttl_.count() == 0) max_size_ = 0U; // no sense cache without time to live
+}
+
+// -----------------------------------------------------------------------------
+
+LookupCache::~LookupCache()
+{
+  if(watcher_.joinable())
+  {
+    uint64_t val = 1U;
+    if(write(stop_fd_, & val, sizeof(val)) == sizeof(val)) watcher_.join();
+    else watcher_.detach(); // never do it
+  }
+
+  if(inotify_fd_ >= 0) close(inotify_fd_);
+  if(stop_fd_ >= 0) close(stop_fd_);
+}
+
+// -----------------------------------------------------------------------------
+
+bool LookupCache::enabled() const
+{
+  return max_size_ > 0U;
+}
+
+// -----------------------------------------------------------------------------
+
+auto LookupCache::find(const std::string & name)
+    -> std::tuple<TripleResult, std::string>
+{
+  if(!enabled()) return {TripleResult::nop, ""};
+
+  std::lock_guard lk{mutex_};
+
+  auto it = items_.find(name);
+  if(it != items_.end())
+  {
+    if(Clock::now() < it->second.expire)
+    {
+      ++hits_;
+      return {it->second.found ? TripleResult::ok : TripleResult::fail,
+              it->second.path};
+    }
+
+    erase_item(it); // expired
+  }
+
+  ++misses_;
+  return {TripleResult::nop, ""};
+}
+
+// -----------------------------------------------------------------------------
+
+auto LookupCache::generation() const -> uint64_t
+{
+  return generation_.load();
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::insert(
+    const std::string & name,
+    const uint64_t & generation,
+    bool found,
+    const std::string & path,
+    const std::vector<std::string> & dirs)
+{
+  if(!enabled()) return;
+
+  std::lock_guard lk{mutex_};
+
+  if(generation != generation_) return; // dropped while lookup - can be stale
+
+  // Changes of not watched directory not seen - result can become stale
+  std::vector<int> wds;
+  for(auto & dir : dirs)
+  {
+    if(auto it = watched_.find(dir); it != watched_.end())
+    {
+      wds.push_back(it->second);
+    }
+    else
+    if(watcher_.joinable())
+    {
+      return;
+    }
+  }
+
+  if(auto it = items_.find(name); it != items_.end()) erase_item(it);
+
+  // Drop oldest entries if full
+  while(items_.size() >= max_size_)
+  {
+    erase_item(items_.find(order_.front()));
+  }
+
+  order_.push_back(name);
+  for(auto wd : wds) wd_names_[wd].insert(name);
+  items_.emplace(
+      name,
+      Item{found, found ? path : "", Clock::now() + ttl_, --order_.end(),
+           std::move(wds)});
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::erase(const std::string & name)
+{
+  std::lock_guard lk{mutex_};
+
+  ++generation_;
+  if(auto it = items_.find(name); it != items_.end()) erase_item(it);
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::erase_item(decltype(items_)::iterator it)
+{
+  for(auto wd : it->second.wds)
+  {
+    if(auto names = wd_names_.find(wd); names != wd_names_.end())
+    {
+      names->second.erase(it->first);
+      if(!names->second.size()) wd_names_.erase(names);
+    }
+  }
+  order_.erase(it->second.order);
+  items_.erase(it);
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::clear()
+{
+  std::lock_guard lk{mutex_};
+
+  ++generation_;
+  items_.clear();
+  order_.clear();
+  wd_names_.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+auto LookupCache::size() const -> size_t
+{
+  std::lock_guard lk{mutex_};
+
+  return items_.size();
+}
+
+// -----------------------------------------------------------------------------
+
+auto LookupCache::names() const -> std::vector<std::string>
+{
+  std::lock_guard lk{mutex_};
+
+  std::vector<std::string> ret;
+  for(auto & name : order_)
+  {
+    if(items_.at(name).found) ret.push_back(name);
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+auto LookupCache::stat() const -> std::tuple<size_t, size_t>
+{
+  return {hits_.load(), misses_.load()};
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::watch(const std::string & dir)
+{
+  if(!enabled() || !dir.size()) return;
+
+  std::lock_guard lk{mutex_};
+
+  if(watched_.count(dir) ||
+     (watched_.size() >= constants::max_lookup_cache_watch)) return;
+
+  if(!watcher_start()) return;
+
+  int wd = inotify_add_watch(
+      inotify_fd_,
+      dir.c_str(),
+      IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+      IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+
+  if(wd >= 0) watched_.emplace(dir, wd); // not exist - not cached, retry
+}
+
+// -----------------------------------------------------------------------------
+
+bool LookupCache::watcher_start()
+{
+  if(watcher_.joinable()) return true;
+
+  if(inotify_fd_ < 0) inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if(stop_fd_ < 0) stop_fd_ = eventfd(0, EFD_CLOEXEC);
+
+  if((inotify_fd_ < 0) || (stop_fd_ < 0)) return false; // use only TTL
+
+  watcher_ = std::thread(& LookupCache::watcher_loop, this);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::watcher_loop()
+{
+  alignas(struct inotify_event) char buf[4096];
+
+  struct pollfd fds[2]
+  {
+    {inotify_fd_, POLLIN, 0},
+    {stop_fd_,    POLLIN, 0},
+  };
+
+  while(true)
+  {
+    if(poll(fds, 2, -1) < 0)
+    {
+      if(errno == EINTR) continue;
+      break;
+    }
+
+    if(fds[1].revents) break; // stop
+
+    if(fds[0].revents & POLLIN)
+    {
+      ssize_t size;
+      while((size = read(inotify_fd_, buf, sizeof(buf))) > 0)
+      {
+        std::lock_guard lk{mutex_};
+
+        for(char * ptr = buf; ptr < buf + size;)
+        {
+          auto ev = reinterpret_cast<struct inotify_event *>(ptr);
+          ptr += sizeof(struct inotify_event) + ev->len;
+
+          if(ev->mask & IN_Q_OVERFLOW) // events lost - drop all
+          {
+            ++generation_;
+            items_.clear();
+            order_.clear();
+            wd_names_.clear();
+            continue;
+          }
+
+          if(ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+          {
+            drop_watch(ev->wd); // watch again - directory can be recreated
+          }
+          else
+          if(ev->len)
+          {
+            drop_changed(ev->wd, std::string_view{ev->name});
+          }
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::drop_changed(int wd, std::string_view file)
+{
+  auto names = wd_names_.find(wd);
+  if(names == wd_names_.end()) return;
+
+  ++generation_;
+
+  std::vector<std::string> dropped;
+  for(auto & name : names->second)
+  {
+    auto pos = name.find_last_of('/');
+    std::string_view last{name};
+    if(pos != std::string::npos) last.remove_prefix(pos + 1U);
+    if(!file.size() || (last == file)) dropped.push_back(name);
+  }
+
+  for(auto & name : dropped)
+  {
+    if(auto it = items_.find(name); it != items_.end()) erase_item(it);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void LookupCache::drop_watch(int wd)
+{
+  drop_changed(wd, "");
+
+  for(auto it = watched_.begin(); it != watched_.end();)
+  {
+    if(it->second == wd)
+    {
+      inotify_rm_watch(inotify_fd_, wd);
+      it = watched_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
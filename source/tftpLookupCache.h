@@ -0,0 +1,239 @@
+/**
+ * \file tftpLookupCache.h
+ * \brief Lookup cache class header
+ *
+ *  Cache of resolved (and not found) requested file names
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPLOOKUPCACHE_H_
+#define SOURCE_TFTPLOOKUPCACHE_H_
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Default maximum count of names in lookup cache (0 - cache disabled)
+  constexpr size_t default_lookup_cache_size = 4096U;
+
+  /// Default time to live (seconds) of lookup cache entry
+  constexpr int    default_lookup_cache_ttl  = 30;
+
+  /// Maximum count of directories watched for changes by one cache
+  constexpr size_t max_lookup_cache_watch    = 1024U;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Cache of file name lookup results
+ *
+ *  Store positive (resolved path) and negative (not found) results of
+ *  searching requested file names in server directories.
+ *  Cache bounded by count of entries and time to live of every entry.
+ *  Directories used for search are watched with inotify; change of entry
+ *  (create/delete/move) in directory drops only cached names looked up
+ *  in this directory with same file name. Result of lookup in directory
+ *  that can't be watched not stored (only if inotify used at all).
+ *  Every drop increase generation; result of lookup started before drop
+ *  not stored (it can be stale).
+ *  Thread safe.
+ */
+class LookupCache
+{
+protected:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// Cache entry
+  struct Item
+  {
+    bool              found;  ///< Flag: file was found
+    std::string       path;   ///< Resolved path (if found)
+    Clock::time_point expire; ///< Time when entry expired
+    std::list<std::string>::iterator order; ///< Position in order list
+    std::vector<int>  wds;    ///< Watches of directories used for lookup
+  };
+
+  mutable std::mutex mutex_; ///< Mutex for entries and watches
+
+  std::unordered_map<std::string, Item> items_; ///< Cached entries
+
+  std::list<std::string> order_; ///< Entries names, oldest first
+
+  std::unordered_map<std::string, int> watched_; ///< Watches by directory
+
+  /// Names of entries by watch of directory used for lookup
+  std::unordered_map<int, std::unordered_set<std::string>> wd_names_;
+
+  size_t max_size_; ///< Maximum count of entries
+
+  std::chrono::seconds ttl_; ///< Time to live of entry
+
+  int inotify_fd_; ///< Inotify descriptor (-1 if not used)
+
+  int stop_fd_; ///< Event descriptor for stop watcher thread
+
+  std::thread watcher_; ///< Watcher thread
+
+  std::atomic<uint64_t> generation_; ///< Counter of drops (changed under mutex_)
+
+  std::atomic<size_t> hits_;   ///< Counter of cache hits
+
+  std::atomic<size_t> misses_; ///< Counter of cache misses
+
+  /** \brief Start inotify watcher thread if need
+   *
+   *  Need locked mutex_
+   *  \return True if watcher is running, else - false
+   */
+  bool watcher_start();
+
+  /** \brief Watcher thread loop
+   */
+  void watcher_loop();
+
+  /** \brief Drop entries affected by change in watched directory
+   *
+   *  Need locked mutex_
+   *  \param [in] wd Watch of directory
+   *  \param [in] file Changed entry name; empty - directory itself changed
+   */
+  void drop_changed(int wd, std::string_view file);
+
+  /** \brief Forget watch of directory and drop all entries used it
+   *
+   *  Need locked mutex_
+   *  \param [in] wd Watch of directory
+   */
+  void drop_watch(int wd);
+
+  /** \brief Erase entry by iterator
+   *
+   *  Need locked mutex_
+   *  \param [in] it Iterator of entry
+   */
+  void erase_item(decltype(items_)::iterator it);
+
+public:
+
+  /** \brief Constructor
+   *
+   *  \param [in] max_size Maximum count of entries; 0 - cache disabled
+   *  \param [in] ttl Time to live of entry in seconds
+   */
+  LookupCache(
+      size_t max_size = constants::default_lookup_cache_size,
+      int ttl = constants::default_lookup_cache_ttl);
+
+  LookupCache(const LookupCache &) = delete; ///< Deleted/unused
+
+  LookupCache & operator=(const LookupCache &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Stop watcher thread
+   */
+  virtual ~LookupCache();
+
+  /** \brief Check cache enabled
+   *
+   *  \return True if enabled, else - false
+   */
+  bool enabled() const;
+
+  /** \brief Find cached result of lookup
+   *
+   *  \param [in] name Requested file name
+   *  \return Tuple<nop - not cached, ok - found, fail - not found; Path>
+   */
+  auto find(const std::string & name) -> std::tuple<TripleResult, std::string>;
+
+  /** \brief Get generation of cache
+   *
+   *  Take before lookup in file system and pass to insert()
+   *  \return Generation
+   */
+  auto generation() const -> uint64_t;
+
+  /** \brief Store result of lookup
+   *
+   *  If cache full, then drop oldest entry. Result not stored if cache was
+   *  dropped (or entry erased) after lookup start, or any directory of
+   *  lookup not watched (while inotify used).
+   *  \param [in] name Requested file name
+   *  \param [in] generation Generation of cache taken before lookup
+   *  \param [in] found Flag: file was found
+   *  \param [in] path Resolved path (if found)
+   *  \param [in] dirs Directories used for lookup (watched by watch())
+   */
+  void insert(
+      const std::string & name,
+      const uint64_t & generation,
+      bool found,
+      const std::string & path = "",
+      const std::vector<std::string> & dirs = {});
+
+  /** \brief Drop cached result of lookup
+   *
+   *  \param [in] name Requested file name
+   */
+  void erase(const std::string & name);
+
+  /** \brief Drop all cached results
+   */
+  void clear();
+
+  /** \brief Watch directory for changes
+   *
+   *  Call before lookup in directory. Change of entry in directory drop
+   *  cached results of this entry name looked up in directory.
+   *  Silent ignore if directory not exist or can't watch (retry next time)
+   *  \param [in] dir Path to directory
+   */
+  void watch(const std::string & dir);
+
+  /** \brief Get count of cached entries
+   *
+   *  \return Count
+   */
+  auto size() const -> size_t;
+
+  /** \brief Get names of cached found entries
+   *
+   *  Use for warm up other cache
+   *  \return Names, oldest first
+   */
+  auto names() const -> std::vector<std::string>;
+
+  /** \brief Get counters of cache hits and misses
+   *
+   *  \return Tuple<hits; misses>
+   */
+  auto stat() const -> std::tuple<size_t, size_t>;
+};
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPLOOKUPCACHE_H_ */
@@ -0,0 +1,428 @@
+/**
+ * \file tftpMetrics.cpp
+ * \brief Metrics classes module
+ *
+ *  Server and sessions counters exported in Prometheus text format
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "tftpMetrics.h"
+#include "tftpAddr.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+  /// Value in microseconds as seconds (without trailing zeros)
+  auto us_to_sec(const uint64_t & val_us) -> std::string
+  {
+    std::string frac = std::to_string(val_us % 1000000U);
+    frac.insert(0U, 6U - frac.size(), '0');
+    frac.erase(frac.find_last_not_of('0') + 1U);
+
+    return std::to_string(val_us / 1000000U) +
+           (frac.size() ? "."+frac : std::string{});
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+Metrics::Metrics():
+    mutex_{},
+    shards_{},
+    retired_{}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+Metrics::~Metrics()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+auto Metrics::global() -> Metrics &
+{
+  static Metrics metrics;
+
+  return metrics;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Metrics::shard() -> Shard &
+{
+  thread_local struct Holder
+  {
+    pShard sh;
+
+    Holder():
+        sh{std::make_shared<Shard>()}
+    {
+      auto & self = global();
+      std::lock_guard lk{self.mutex_};
+      self.shards_.push_back(sh);
+    }
+
+    ~Holder()
+    {
+      global().release(sh);
+    }
+  } holder;
+
+  return * holder.sh;
+}
+
+// -----------------------------------------------------------------------------
+
+void Metrics::release(const pShard & sh)
+{
+  std::lock_guard lk{mutex_};
+
+  accumulate(retired_, * sh);
+  shards_.remove(sh);
+}
+
+// -----------------------------------------------------------------------------
+
+void Metrics::accumulate(Values & dst, const Shard & src)
+{
+  for(size_t iter = 0U; iter < dst.counters.size(); ++iter)
+  {
+    dst.counters[iter] += src.counters[iter].load(std::memory_order_relaxed);
+  }
+
+  for(size_t h_iter = 0U; h_iter < dst.hists.size(); ++h_iter)
+  {
+    auto & hist = dst.hists[h_iter];
+    for(size_t iter = 0U; iter < bucket_count; ++iter)
+    {
+      hist.buckets[iter] +=
+          src.buckets[h_iter][iter].load(std::memory_order_relaxed);
+    }
+    hist.sum_us += src.sums_us[h_iter].load(std::memory_order_relaxed);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void Metrics::observe(Hist hist, const uint64_t & val_us)
+{
+  auto & sh = shard();
+
+  bump(sh.buckets[(size_t) hist][bucket(val_us)], 1U);
+  bump(sh.sums_us[(size_t) hist], val_us);
+}
+
+// -----------------------------------------------------------------------------
+
+void Metrics::out_head(
+    std::string & out,
+    std::string_view name,
+    std::string_view type,
+    std::string_view help)
+{
+  out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+  out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+// -----------------------------------------------------------------------------
+
+void Metrics::out_value(
+    std::string & out,
+    std::string_view name,
+    std::string_view labels,
+    const std::string & value)
+{
+  out.append(name);
+  if(labels.size()) out.append("{").append(labels).append("}");
+  out.append(" ").append(value).append("\n");
+}
+
+// -----------------------------------------------------------------------------
+
+auto Metrics::transfer_hist(const size_t & size) -> Hist
+{
+  size_t iter = 0U;
+  while((iter < constants::metrics_transfer_sizes.size()) &&
+        (size > constants::metrics_transfer_sizes[iter])) ++iter;
+
+  return (Hist) ((size_t) Hist::transfer_64k + iter);
+}
+
+// -----------------------------------------------------------------------------
+
+auto Metrics::values() const -> Values
+{
+  std::lock_guard lk{mutex_};
+
+  Values ret{retired_};
+  for(auto & sh : shards_) accumulate(ret, * sh);
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Metrics::text() const -> std::string
+{
+  /// Name, labels and help of histogram (same names follow each other)
+  struct HistInfo
+  {
+    std::string_view name;
+    std::string_view labels;
+    std::string_view help;
+  };
+
+  static const std::array<HistInfo, (size_t) Hist::count_> hist_info{{
+      {"tftp_lookup_duration_seconds", "", "Latency of requested file lookup"},
+      {"tftp_block_rtt_seconds", "", "Time from block send to matching reply"},
+      {"tftp_disk_read_seconds", "", "Time of data read per block"},
+      {"tftp_disk_write_seconds", "", "Time of data write per block"},
+      {"tftp_first_reply_seconds", "", "Time from request to first DATA/OACK/ACK"},
+      {"tftp_transfer_duration_seconds", "size=\"64KiB\"", "Transfer time by file size"},
+      {"tftp_transfer_duration_seconds", "size=\"1MiB\"", ""},
+      {"tftp_transfer_duration_seconds", "size=\"16MiB\"", ""},
+      {"tftp_transfer_duration_seconds", "size=\"+Inf\"", ""}}};
+
+  auto val = values();
+  auto cnt = [&](Metric m) { return std::to_string(val.counters[(size_t) m]); };
+
+  std::string ret;
+
+  out_head(ret, "tftp_sessions_started_total", "counter", "Sessions started");
+  out_value(ret, "tftp_sessions_started_total", "", cnt(Metric::sessions_started));
+
+  out_head(ret, "tftp_sessions_active", "gauge", "Sessions running now");
+  out_value(ret, "tftp_sessions_active", "", std::to_string(
+      val.counters[(size_t) Metric::sessions_started] -
+      val.counters[(size_t) Metric::sessions_finished]));
+
+  out_head(ret, "tftp_requests_total", "counter", "Initial packets by opcode");
+  out_value(ret, "tftp_requests_total", "op=\"rrq\"", cnt(Metric::requests_rrq));
+  out_value(ret, "tftp_requests_total", "op=\"wrq\"", cnt(Metric::requests_wrq));
+  out_value(ret, "tftp_requests_total", "op=\"fake\"", cnt(Metric::requests_fake));
+
+  out_head(ret, "tftp_sent_bytes_total", "counter", "Bytes sent by sessions");
+  out_value(ret, "tftp_sent_bytes_total", "", cnt(Metric::bytes_tx));
+
+  out_head(ret, "tftp_received_bytes_total", "counter", "Bytes received by sessions");
+  out_value(ret, "tftp_received_bytes_total", "", cnt(Metric::bytes_rx));
+
+  out_head(ret, "tftp_retransmits_total", "counter", "Retransmits");
+  out_value(ret, "tftp_retransmits_total", "", cnt(Metric::retransmits));
+
+  out_head(ret, "tftp_timeouts_total", "counter", "Receive timeouts");
+  out_value(ret, "tftp_timeouts_total", "", cnt(Metric::timeouts));
+
+  out_head(ret, "tftp_errors_total", "counter", "ERROR packets sent by code");
+  for(uint16_t code = 0U; code <= constants::metrics_max_error_code; ++code)
+  {
+    out_value(ret, "tftp_errors_total", "code=\""+std::to_string(code)+"\"",
+              cnt((Metric) ((size_t) Metric::error_0 + code)));
+  }
+
+  for(size_t h_iter = 0U; h_iter < val.hists.size(); ++h_iter)
+  {
+    const auto & hist = val.hists[h_iter];
+    const auto & info = hist_info[h_iter];
+    const std::string name{info.name};
+    const std::string labels{info.labels};
+    const std::string prefix{labels.size() ? labels+"," : labels};
+
+    if(!h_iter || (hist_info[h_iter - 1U].name != info.name))
+    {
+      out_head(ret, name, "histogram", info.help);
+    }
+
+    // Only not empty buckets (hundreds of fine buckets) and +Inf
+    uint64_t total = 0U;
+    for(size_t iter = 0U; iter < bucket_count; ++iter)
+    {
+      total += hist.buckets[iter];
+      bool inf = iter == bucket_count - 1U;
+      if(!hist.buckets[iter] && !inf) continue;
+
+      out_value(ret, name+"_bucket",
+                prefix+"le=\""+(inf ? std::string{"+Inf"} :
+                                      us_to_sec(bucket_bound(iter)))+"\"",
+                std::to_string(total));
+    }
+    out_value(ret, name+"_sum", labels, us_to_sec(hist.sum_us));
+    out_value(ret, name+"_count", labels, std::to_string(total));
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+MetricsServer::MetricsServer(std::string_view listen):
+    listen_{listen},
+    socket_{-1},
+    client_{-1},
+    exchange_{},
+    sent_{0U},
+    replying_{false},
+    deadline_{}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+MetricsServer::~MetricsServer()
+{
+  close_socket();
+}
+
+// -----------------------------------------------------------------------------
+
+void MetricsServer::close_socket()
+{
+  close_client();
+
+  if(socket_ < 0) return;
+
+  close(socket_);
+  socket_ = -1;
+
+  if(listen_.size() && (listen_[0U] == '/')) unlink(listen_.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+void MetricsServer::close_client()
+{
+  if(client_ < 0) return;
+
+  close(client_);
+  client_ = -1;
+  exchange_.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+auto MetricsServer::open() -> std::tuple<bool, int>
+{
+  close_socket();
+
+  int bind_result = -1;
+  if(listen_.size() && (listen_[0U] == '/'))
+  {
+    struct sockaddr_un addr{};
+    if(listen_.size() >= sizeof(addr.sun_path)) return {false, ENAMETOOLONG};
+
+    addr.sun_family = AF_UNIX;
+    listen_.copy(addr.sun_path, listen_.size());
+
+    socket_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(socket_ < 0) return {false, errno};
+
+    unlink(listen_.c_str());
+    bind_result = bind(socket_, (struct sockaddr *) & addr, sizeof(addr));
+  }
+  else
+  {
+    Addr addr;
+    if(!std::get<0>(addr.set_string(listen_))) return {false, EINVAL};
+
+    socket_ = socket(addr.family(), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(socket_ < 0) return {false, errno};
+
+    int val = 1;
+    setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, & val, sizeof(val));
+    bind_result = bind(socket_, addr.as_sockaddr_ptr(), addr.data_size());
+  }
+
+  if((bind_result != 0) || (listen(socket_, 8) != 0))
+  {
+    int err = errno;
+    close(socket_);
+    socket_ = -1;
+    return {false, err};
+  }
+
+  return {true, 0};
+}
+
+// -----------------------------------------------------------------------------
+
+auto MetricsServer::serve(const std::function<std::string()> & extra) -> size_t
+{
+  if(socket_ < 0) return 0U;
+
+  auto now = std::chrono::steady_clock::now();
+
+  if(client_ < 0)
+  {
+    client_ = accept4(socket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if(client_ < 0) return 0U;
+
+    sent_ = 0U;
+    replying_ = false;
+    deadline_ = now + std::chrono::milliseconds{constants::metrics_client_timeout_ms};
+  }
+
+  bool timeout = now >= deadline_;
+
+  // Read request while ready (any request get metrics)
+  if(!replying_)
+  {
+    std::array<char, 1024U> buf;
+    ssize_t res = 0;
+    while((exchange_.size() < constants::metrics_max_request_size) &&
+          ((res = recv(client_, buf.data(), buf.size(), MSG_DONTWAIT)) > 0))
+    {
+      exchange_.append(buf.data(), (size_t) res);
+    }
+
+    bool request_end = (res == 0) ||
+                       (exchange_.size() >= constants::metrics_max_request_size) ||
+                       (exchange_.find("\r\n\r\n") != std::string::npos) ||
+                       (exchange_.find("\n\n") != std::string::npos);
+    if(!request_end && !timeout) return 0U;
+
+    std::string body = Metrics::global().text();
+    if(extra) body.append(extra());
+
+    exchange_ = "HTTP/1.0 200 OK\r\n"
+                "Content-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: "+std::to_string(body.size())+"\r\n"
+                "Connection: close\r\n\r\n"+body;
+    replying_ = true;
+  }
+
+  // Send response while ready
+  while(sent_ < exchange_.size())
+  {
+    ssize_t res = send(client_, exchange_.data() + sent_, exchange_.size() - sent_,
+                       MSG_DONTWAIT | MSG_NOSIGNAL);
+    if(res <= 0) break;
+    sent_ += (size_t) res;
+  }
+
+  if((sent_ < exchange_.size()) && !timeout && (errno == EAGAIN)) return 0U;
+
+  close_client();
+  return 1U;
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
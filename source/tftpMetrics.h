@@ -0,0 +1,392 @@
+/**
+ * \file tftpMetrics.h
+ * \brief Metrics classes header
+ *
+ *  Server and sessions counters exported in Prometheus text format
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPMETRICS_H_
+#define SOURCE_TFTPMETRICS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Size of cache line (per-thread counters aligned to it)
+  constexpr size_t metrics_cacheline = 64U;
+
+  /// Maximum TFTP error code counted separately (greater counted as 0)
+  constexpr uint16_t metrics_max_error_code = 8U;
+
+  /// Bits of linear sub-buckets in each power of 2 of histogram values
+  /// (HDR-style: 16 sub-buckets, relative error of bucket not more 1/16)
+  constexpr size_t metrics_sub_bucket_bits = 4U;
+
+  /// Power of 2 of histogram range (microseconds); greater values counted
+  /// in +Inf bucket (2^27 us ~ 134 s)
+  constexpr size_t metrics_max_pow2 = 27U;
+
+  /// Upper bounds of file size for transfer time histograms (bytes)
+  constexpr std::array<size_t, 3U> metrics_transfer_sizes{
+      64U * 1024U, 1024U * 1024U, 16U * 1024U * 1024U};
+
+  /// Timeout of exchange with metrics client (milliseconds)
+  constexpr int metrics_client_timeout_ms = 100;
+
+  /// Maximum size of metrics request read (rest ignored)
+  constexpr size_t metrics_max_request_size = 4096U;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Counters
+enum class Metric: size_t
+{
+  sessions_started = 0U, ///< Sessions started
+  sessions_finished,     ///< Sessions finished
+  requests_rrq,          ///< Initial RRQ packets
+  requests_wrq,          ///< Initial WRQ packets
+  requests_fake,         ///< Initial packets not RRQ/WRQ
+  bytes_tx,              ///< Bytes sent by sessions
+  bytes_rx,              ///< Bytes received by sessions
+  retransmits,           ///< Retransmits
+  timeouts,              ///< Receive timeouts
+  error_0,               ///< ERROR packets sent with code 0 (first of codes)
+  count_ = error_0 + constants::metrics_max_error_code + 1U, ///< Count
+};
+
+/// Histograms
+enum class Hist: size_t
+{
+  lookup = 0U,  ///< Latency of requested file lookup
+  block_rtt,    ///< Time from block send to matching reply
+  disk_read,    ///< Time of data manager read (per block)
+  disk_write,   ///< Time of data manager write (per block)
+  first_reply,  ///< Time from request to first DATA/OACK/ACK
+  transfer_64k, ///< Transfer time of file up to 64 KiB (first of sizes)
+  transfer_1m,  ///< Transfer time of file up to 1 MiB
+  transfer_16m, ///< Transfer time of file up to 16 MiB
+  transfer_max, ///< Transfer time of file greater than 16 MiB
+  count_,       ///< Count
+};
+
+// -----------------------------------------------------------------------------
+
+/** \brief Process-wide metrics
+ *
+ *  Every thread update own counters aligned to cache line (no locks, no
+ *  shared cache lines). Counters of finished threads added to totals.
+ *  Values summed only when exported.
+ */
+class Metrics
+{
+public:
+
+  /// Count of sub-buckets in each power of 2
+  static constexpr size_t sub_bucket_count =
+      size_t{1U} << constants::metrics_sub_bucket_bits;
+
+  /// Count of histogram buckets (exact values below sub_bucket_count, then
+  /// sub_bucket_count linear buckets for each power of 2, then +Inf)
+  static constexpr size_t bucket_count = sub_bucket_count +
+      (constants::metrics_max_pow2 - constants::metrics_sub_bucket_bits) *
+      sub_bucket_count + 1U;
+
+  /** \brief Get histogram bucket of value
+   *
+   *  \param [in] val_us Value (microseconds)
+   *  \return Index of bucket (bucket_count - 1 for +Inf)
+   */
+  static constexpr auto bucket(const uint64_t & val_us) -> size_t
+  {
+    if(val_us < sub_bucket_count) return (size_t) val_us;
+
+    size_t pow2 = 63U - (size_t) __builtin_clzll(val_us);
+    if(pow2 >= constants::metrics_max_pow2) return bucket_count - 1U;
+
+    size_t shift = pow2 - constants::metrics_sub_bucket_bits;
+    return sub_bucket_count + shift * sub_bucket_count +
+           (size_t) ((val_us >> shift) & (sub_bucket_count - 1U));
+  }
+
+  /** \brief Get upper bound of histogram bucket (inclusive)
+   *
+   *  \param [in] idx Index of bucket (less bucket_count - 1)
+   *  \return Maximum value in bucket (microseconds)
+   */
+  static constexpr auto bucket_bound(const size_t & idx) -> uint64_t
+  {
+    if(idx < sub_bucket_count) return idx;
+
+    size_t shift = (idx - sub_bucket_count) / sub_bucket_count;
+    size_t sub = (idx - sub_bucket_count) % sub_bucket_count;
+    return ((uint64_t) (sub_bucket_count + sub + 1U) << shift) - 1U;
+  }
+
+  /// Values of one histogram
+  struct HistValues
+  {
+    std::array<uint64_t, bucket_count> buckets; ///< Counts (not cumulative)
+    uint64_t sum_us;                            ///< Sum of values
+  };
+
+  /// Summed values
+  struct Values
+  {
+    std::array<uint64_t, (size_t) Metric::count_> counters; ///< Counters
+    std::array<HistValues, (size_t) Hist::count_> hists;    ///< Histograms
+  };
+
+protected:
+
+  using Cell = std::atomic<uint64_t>;
+
+  /// Counters of one thread
+  struct alignas(constants::metrics_cacheline) Shard
+  {
+    std::array<Cell, (size_t) Metric::count_> counters{}; ///< Counters
+    std::array<std::array<Cell, bucket_count>, (size_t) Hist::count_> buckets{}; ///< Buckets
+    std::array<Cell, (size_t) Hist::count_> sums_us{}; ///< Sums of histograms
+  };
+
+  using pShard = std::shared_ptr<Shard>;
+
+  mutable std::mutex mutex_; ///< Mutex for shards list and totals
+
+  std::list<pShard> shards_; ///< Shards of running threads
+
+  Values retired_; ///< Totals of finished threads
+
+  /** \brief Get shard of current thread
+   *
+   *  Register new shard on first call in thread
+   *  \return Reference to shard
+   */
+  static auto shard() -> Shard &;
+
+  /** \brief Add values of finished thread to totals
+   *
+   *  \param [in] sh Shard of thread
+   */
+  void release(const pShard & sh);
+
+  /** \brief Add values of shard
+   *
+   *  \param [in,out] dst Summed values
+   *  \param [in] src Shard
+   */
+  static void accumulate(Values & dst, const Shard & src);
+
+  /** \brief Single writer increment (no locked instruction)
+   *
+   *  \param [in,out] cell Counter
+   *  \param [in] val Added value
+   */
+  static void bump(Cell & cell, const uint64_t & val)
+  {
+    cell.store(cell.load(std::memory_order_relaxed) + val,
+               std::memory_order_relaxed);
+  }
+
+public:
+
+  /** \brief Default constructor
+   */
+  Metrics();
+
+  Metrics(const Metrics &) = delete; ///< Deleted/unused
+
+  Metrics & operator=(const Metrics &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   */
+  virtual ~Metrics();
+
+  /** \brief Get process-wide metrics
+   *
+   *  \return Reference to metrics
+   */
+  static auto global() -> Metrics &;
+
+  /** \brief Increment counter
+   *
+   *  \param [in] metric Counter
+   *  \param [in] val Added value
+   */
+  static void add(Metric metric, const uint64_t & val = 1U)
+  {
+    bump(shard().counters[(size_t) metric], val);
+  }
+
+  /** \brief Count sent ERROR packet
+   *
+   *  \param [in] code TFTP error code
+   */
+  static void error(const uint16_t & code)
+  {
+    add((Metric) ((size_t) Metric::error_0 +
+        (code > constants::metrics_max_error_code ? 0U : code)));
+  }
+
+  /** \brief Add value to histogram
+   *
+   *  \param [in] hist Histogram
+   *  \param [in] val_us Value (microseconds)
+   */
+  static void observe(Hist hist, const uint64_t & val_us);
+
+  /** \brief Add time to histogram
+   *
+   *  \param [in] hist Histogram
+   *  \param [in] from Start time (till now)
+   *  \param [in] divider Count of items (value divided)
+   */
+  template<typename TimePoint>
+  static void observe_since(
+      Hist hist,
+      const TimePoint & from,
+      const size_t & divider = 1U)
+  {
+    observe(hist, (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+        TimePoint::clock::now() - from).count() / (divider ? divider : 1U));
+  }
+
+  /** \brief Append header of one metric in Prometheus format
+   *
+   *  \param [in,out] out Text
+   *  \param [in] name Name of metric
+   *  \param [in] type Type of metric (counter, gauge, histogram)
+   *  \param [in] help Description of metric
+   */
+  static void out_head(
+      std::string & out,
+      std::string_view name,
+      std::string_view type,
+      std::string_view help);
+
+  /** \brief Append value of one metric in Prometheus format
+   *
+   *  \param [in,out] out Text
+   *  \param [in] name Name of metric
+   *  \param [in] labels Labels without braces (empty if none)
+   *  \param [in] value Value
+   */
+  static void out_value(
+      std::string & out,
+      std::string_view name,
+      std::string_view labels,
+      const std::string & value);
+
+  /** \brief Get transfer time histogram for file size
+   *
+   *  \param [in] size Size of file
+   *  \return Histogram
+   */
+  static auto transfer_hist(const size_t & size) -> Hist;
+
+  /** \brief Get summed values
+   *
+   *  \return Values
+   */
+  auto values() const -> Values;
+
+  /** \brief Make text in Prometheus format
+   *
+   *  \return Text
+   */
+  auto text() const -> std::string;
+};
+
+// -----------------------------------------------------------------------------
+
+/** \brief Endpoint of metrics (HTTP over TCP or Unix socket)
+ *
+ *  Polled from server main loop; every connection get one response
+ *  with text in Prometheus format and closed.
+ */
+class MetricsServer
+{
+protected:
+
+  std::string listen_; ///< Address "ip:port" or path to Unix socket
+
+  int socket_; ///< Listening socket (-1 if closed)
+
+  int client_; ///< Client in progress (-1 if none)
+
+  std::string exchange_; ///< Request (while reading), then response
+
+  size_t sent_; ///< Sent size of response
+
+  bool replying_; ///< Flag: request read, response sending
+
+  std::chrono::steady_clock::time_point deadline_; ///< End of client timeout
+
+  /** \brief Close listening socket
+   */
+  void close_socket();
+
+  /** \brief Close client in progress
+   */
+  void close_client();
+
+public:
+
+  /** \brief Constructor
+   *
+   *  \param [in] listen Address "ip:port" or path to Unix socket ('/' first)
+   */
+  MetricsServer(std::string_view listen);
+
+  MetricsServer(const MetricsServer &) = delete; ///< Deleted/unused
+
+  MetricsServer & operator=(const MetricsServer &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Close socket; remove Unix socket file
+   */
+  virtual ~MetricsServer();
+
+  /** \brief Open listening socket
+   *
+   *  \return Tuple<success; errno value>
+   */
+  auto open() -> std::tuple<bool, int>;
+
+  /** \brief Serve one client step by step (never blocks)
+   *
+   *  Called from server main loop each pass: accept one client, read its
+   *  request and send response as far as sockets ready; client not
+   *  finished in metrics_client_timeout_ms get response or closed.
+   *  \param [in] extra Callback for additional text (called only for client)
+   *  \return Count of served (finished) clients
+   */
+  auto serve(const std::function<std::string()> & extra) -> size_t;
+};
+
+using pMetricsServer = std::shared_ptr<MetricsServer>;
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPMETRICS_H_ */
@@ -116,8 +116,8 @@ bool Options::was_set_any() const
 
 //------------------------------------------------------------------------------
 
-#define OPT_L_INF(MSG) if(log != nullptr) L_INF(MSG);
-#define OPT_L_WRN(MSG) if(log != nullptr) L_WRN(MSG);
+#define OPT_L_INF(MSG) if(log != nullptr) LOG_FMSG(info,    CURR_MSG(MSG));
+#define OPT_L_WRN(MSG) if(log != nullptr) LOG_FMSG(warning, CURR_MSG(MSG));
 
 bool Options::buffer_parse(
     const SmBuf & buf,
@@ -0,0 +1,155 @@
+/**
+ * \file tftpPkt.cpp
+ * \brief TFTP packet encoders module
+ *
+ *  Fixed layouts of TFTP packets encoded/decoded directly in buffer memory
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <cstring>
+
+#include "tftpPkt.h"
+
+namespace tftp
+{
+
+namespace pkt
+{
+
+// -----------------------------------------------------------------------------
+
+auto to_string(const Rx & rx, const size_t & size) -> std::string
+{
+  std::string ret = "Rx pkt ["+std::to_string(size)+" octets]";
+
+  switch(rx.op)
+  {
+    case Op::data:
+      ret.append(": DATA blk "+std::to_string(rx.field)+
+                 "; data size "+std::to_string(rx.payload_size));
+      break;
+    case Op::ack:
+      ret.append(": ACK blk "+std::to_string(rx.field));
+      break;
+    case Op::error:
+      ret.append(": ERROR #"+std::to_string(rx.field)+" '").
+          append(rx.payload, strnlen(rx.payload, rx.payload_size)).
+          append("'");
+      break;
+    default:
+      ret.append(": FAKE tftp packet");
+      break;
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+OackCache::OackCache():
+    mutex_{},
+    packets_{}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+OackCache::~OackCache()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+auto OackCache::global() -> OackCache &
+{
+  static OackCache cache;
+
+  return cache;
+}
+
+// -----------------------------------------------------------------------------
+
+auto OackCache::key(const Options & opt) -> Key
+{
+  return {opt.was_set_blksize()    ? opt.blksize()    : -1,
+          opt.was_set_timeout()    ? opt.timeout()    : -1,
+          opt.was_set_tsize()      ? 0                : -1,
+          opt.was_set_windowsize() ? opt.windowsize() : -1};
+}
+
+// -----------------------------------------------------------------------------
+
+auto OackCache::make(const Key & key) -> Packet
+{
+  static const std::array<std::string_view, 4U> names{
+      constants::name_blksize,
+      constants::name_timeout,
+      constants::name_tsize,
+      constants::name_windowsize};
+
+  Packet ret;
+  std::string * curr = & ret.head;
+  for(size_t iter = 0U; iter < key.size(); ++iter)
+  {
+    if(key[iter] < 0) continue;
+
+    curr->append(names[iter]).push_back('\0');
+    if(iter == 2U) // tsize value written at encode time
+    {
+      ret.tsize = true;
+      curr = & ret.tail;
+      continue;
+    }
+    curr->append(std::to_string(key[iter])).push_back('\0');
+  }
+
+  if(ret.head.size())
+  {
+    const uint16_t opcode_be = htobe16((uint16_t) Op::oack);
+    ret.head.insert(0U, (const char *) & opcode_be, sizeof(uint16_t));
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+auto OackCache::get(const Options & opt) -> pPacket
+{
+  Key curr_key = key(opt);
+
+  std::lock_guard lk{mutex_};
+
+  if(auto it = packets_.find(curr_key); it != packets_.end())
+  {
+    return it->second;
+  }
+
+  if(packets_.size() >= constants::oack_cache_max_size) packets_.clear();
+
+  auto ret = std::make_shared<const Packet>(make(curr_key));
+  packets_.emplace(curr_key, ret);
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+auto OackCache::size() const -> size_t
+{
+  std::lock_guard lk{mutex_};
+
+  return packets_.size();
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace pkt
+
+} // namespace tftp
@@ -0,0 +1,359 @@
+/**
+ * \file tftpPkt.h
+ * \brief TFTP packet encoders header
+ *
+ *  Fixed layouts of TFTP packets encoded/decoded directly in buffer memory
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPPKT_H_
+#define SOURCE_TFTPPKT_H_
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <endian.h>
+#include <map>
+#include <mutex>
+
+#include "tftpCommon.h"
+#include "tftpOptions.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Size of fixed TFTP header (opcode and block number/error code)
+  constexpr size_t pkt_header_size = 4U;
+
+  /// Maximum count of cached OACK packets
+  constexpr size_t oack_cache_max_size = 1024U;
+}
+
+// -----------------------------------------------------------------------------
+
+namespace pkt
+{
+
+/// TFTP packet opcodes
+enum class Op: uint16_t
+{
+  unknown = 0U,
+  rrq   = 1U,
+  wrq   = 2U,
+  data  = 3U,
+  ack   = 4U,
+  error = 5U,
+  oack  = 6U,
+};
+
+/** \brief Convert opcode to string
+ *
+ *  \param [in] val Opcode
+ *  \return Name of opcode
+ */
+constexpr auto to_string(const Op & val) -> std::string_view
+{
+  switch(val)
+  {
+    case Op::rrq:   return "RRQ";
+    case Op::wrq:   return "WRQ";
+    case Op::data:  return "DATA";
+    case Op::ack:   return "ACK";
+    case Op::error: return "ERROR";
+    case Op::oack:  return "OACK";
+    default:        return "FAKE";
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Layout of packet with fixed header (opcode, 16-bit field)
+ *
+ *  Opcode is compile time constant; header stored by plain byte stores.
+ *  \tparam OP Opcode of packet
+ */
+template<Op OP>
+struct Fixed
+{
+  static constexpr uint16_t opcode = (uint16_t) OP;
+
+  /** \brief Store header to memory
+   *
+   *  Memory must have at least pkt_header_size bytes (not checked)
+   *  \param [out] dst Begin of packet
+   *  \param [in] field Block number or error code
+   */
+  static void encode(char * dst, const uint16_t & field) noexcept
+  {
+    dst[0U] = (char) (opcode >> 8U);
+    dst[1U] = (char) (opcode & 0xFFU);
+    dst[2U] = (char) (field >> 8U);
+    dst[3U] = (char) (field & 0xFFU);
+  }
+};
+
+using Data  = Fixed<Op::data>;
+using Ack   = Fixed<Op::ack>;
+using Error = Fixed<Op::error>;
+
+// -----------------------------------------------------------------------------
+
+/** \brief Decode fixed header of packet
+ *
+ *  \param [in] src Begin of packet
+ *  \param [in] size Size of packet
+ *  \return Tuple<opcode (0 if packet too small); block number/error code>
+ */
+inline auto decode_header(const char * src, const size_t & size) noexcept
+    -> std::tuple<uint16_t, uint16_t>
+{
+  if(size < constants::pkt_header_size) return {0U, 0U};
+
+  uint16_t op;
+  uint16_t field;
+  memcpy(& op, src, sizeof(uint16_t));
+  memcpy(& field, src + sizeof(uint16_t), sizeof(uint16_t));
+
+  return {be16toh(op), be16toh(field)};
+}
+
+// -----------------------------------------------------------------------------
+
+/// Received packet classified in place (points to receive buffer)
+struct Rx
+{
+  Op           op;           ///< Opcode (Op::unknown if not TFTP packet)
+  uint16_t     field;        ///< Block number or error code
+  const char * payload;      ///< Begin of data after fixed header
+  size_t       payload_size; ///< Size of data after fixed header
+};
+
+/** \brief Classify received packet
+ *
+ *  Length checked once; no allocation, no exceptions
+ *  \param [in] src Begin of packet
+ *  \param [in] size Size of packet
+ *  \return Classified packet
+ */
+inline auto classify(const char * src, const size_t & size) noexcept -> Rx
+{
+  auto [op, field] = decode_header(src, size);
+
+  if((op < (uint16_t) Op::rrq) || (op > (uint16_t) Op::oack))
+  {
+    return {Op::unknown, 0U, nullptr, 0U};
+  }
+
+  return {(Op) op,
+          field,
+          src + constants::pkt_header_size,
+          size - constants::pkt_header_size};
+}
+
+/** \brief Make diagnostic message about received packet
+ *
+ *  Use only when message logged
+ *  \param [in] rx Classified packet
+ *  \param [in] size Size of packet
+ *  \return Message
+ */
+auto to_string(const Rx & rx, const size_t & size) -> std::string;
+
+// -----------------------------------------------------------------------------
+
+/** \brief Encode ACK packet to buffer
+ *
+ *  \param [in,out] buf Buffer (SmBufEx or SmBufView)
+ *  \param [in] blk Block number
+ *  \return True if success, else - false (buffer too small)
+ */
+template<typename T>
+bool encode_ack(T & buf, const uint16_t & blk)
+{
+  if(buf.size() < constants::pkt_header_size) return false;
+
+  Ack::encode(buf.data(), blk);
+  buf.data_size_reset(constants::pkt_header_size);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Encode ERROR packet to buffer
+ *
+ *  \param [in,out] buf Buffer (SmBufEx or SmBufView)
+ *  \param [in] code Error code
+ *  \param [in] msg Error message (zero end added)
+ *  \return True if success, else - false (buffer too small)
+ */
+template<typename T>
+bool encode_error(T & buf, const uint16_t & code, std::string_view msg)
+{
+  const size_t pkt_size = constants::pkt_header_size + msg.size() + 1U;
+  if(buf.size() < pkt_size) return false;
+
+  char * dst = buf.data();
+  Error::encode(dst, code);
+  memcpy(dst + constants::pkt_header_size, msg.data(), msg.size());
+  dst[pkt_size - 1U] = 0;
+  buf.data_size_reset(pkt_size);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Encode DATA packet header to buffer
+ *
+ *  Data itself placed by data manager after header
+ *  \param [in,out] buf Buffer (SmBufEx or SmBufView)
+ *  \param [in] blk Block number
+ *  \return True if success, else - false (buffer too small)
+ */
+template<typename T>
+bool encode_data_header(T & buf, const uint16_t & blk)
+{
+  if(buf.size() < constants::pkt_header_size) return false;
+
+  Data::encode(buf.data(), blk);
+  buf.data_size_reset(constants::pkt_header_size);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Cache of prepared OACK packets
+ *
+ *  Packet layout prepared once for each distinct set of acknowledged options,
+ *  then only copied. Value of tsize differs per file, so only its name cached
+ *  and digits written at encode time. Thread safe.
+ */
+class OackCache
+{
+public:
+
+  /// Acknowledged options: blksize, timeout, tsize (0 if set), windowsize (-1 if not set)
+  using Key = std::array<int, 4U>;
+
+  /// Prepared packet layout
+  struct Packet
+  {
+    std::string head;  ///< Opcode and options up to tsize value (empty if nothing to ack)
+    std::string tail;  ///< Options after tsize value
+    bool tsize{false}; ///< True if tsize value placed between head and tail
+  };
+
+  /// Prepared packet
+  using pPacket = std::shared_ptr<const Packet>;
+
+protected:
+
+  mutable std::mutex mutex_; ///< Mutex for packets
+
+  std::map<Key, pPacket> packets_; ///< Packets by options set
+
+  /** \brief Make OACK packet layout
+   *
+   *  \param [in] key Options set
+   *  \return Packet layout (empty head if no one option set)
+   */
+  static auto make(const Key & key) -> Packet;
+
+public:
+
+  /** \brief Default constructor
+   */
+  OackCache();
+
+  OackCache(const OackCache &) = delete; ///< Deleted/unused
+
+  OackCache & operator=(const OackCache &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   */
+  virtual ~OackCache();
+
+  /** \brief Get process-wide cache
+   *
+   *  \return Reference to cache
+   */
+  static auto global() -> OackCache &;
+
+  /** \brief Get key of acknowledged options
+   *
+   *  \param [in] opt Options of session
+   *  \return Key
+   */
+  static auto key(const Options & opt) -> Key;
+
+  /** \brief Get OACK packet layout for options
+   *
+   *  \param [in] opt Options of session
+   *  \return Packet layout (empty head if no one option set)
+   */
+  auto get(const Options & opt) -> pPacket;
+
+  /** \brief Get count of cached packets
+   *
+   *  \return Count
+   */
+  auto size() const -> size_t;
+};
+
+// -----------------------------------------------------------------------------
+
+/** \brief Encode OACK packet to buffer
+ *
+ *  \param [in,out] buf Buffer (SmBufEx or SmBufView)
+ *  \param [in] opt Options of session
+ *  \return True if success, else - false (buffer too small or nothing to ack)
+ */
+template<typename T>
+bool encode_oack(T & buf, const Options & opt)
+{
+  auto packet = OackCache::global().get(opt);
+  if(packet->head.empty()) return false;
+
+  std::array<char, 16U> digits;
+  size_t digits_size = 0U;
+  if(packet->tsize)
+  {
+    digits_size = (size_t)
+        (std::to_chars(digits.data(), digits.data() + digits.size() - 1U,
+                       opt.tsize()).ptr - digits.data());
+    digits[digits_size++] = '\0';
+  }
+
+  const size_t size = packet->head.size() + digits_size + packet->tail.size();
+  if(buf.size() < size) return false;
+
+  char * ptr = buf.data();
+  memcpy(ptr, packet->head.data(), packet->head.size());
+  ptr += packet->head.size();
+  memcpy(ptr, digits.data(), digits_size);
+  ptr += digits_size;
+  memcpy(ptr, packet->tail.data(), packet->tail.size());
+  buf.data_size_reset(size);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace pkt
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPPKT_H_ */
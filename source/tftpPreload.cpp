@@ -0,0 +1,282 @@
+/**
+ * \file tftpPreload.cpp
+ * \brief Preloaded files class module
+ *
+ *  Files loaded to locked memory at server start
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tftpPreload.h"
+#include "tftpDataMgrFile.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+PreloadImage::PreloadImage():
+    data_{nullptr},
+    size_{0U},
+    alloc_size_{0U},
+    id_{},
+    huge_{false},
+    locked_{false}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+PreloadImage::~PreloadImage()
+{
+  if(data_ != nullptr)
+  {
+    if(locked_) munlock(data_, alloc_size_);
+    munmap(data_, alloc_size_);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+auto PreloadImage::create(const std::string & path)
+    -> std::tuple<std::shared_ptr<PreloadImage>, int>
+{
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd < 0) return {nullptr, errno};
+
+  auto err_exit = [&](int err)
+      -> std::tuple<std::shared_ptr<PreloadImage>, int>
+      {
+        ::close(fd);
+        return {nullptr, err};
+      };
+
+  struct stat st;
+  if(fstat(fd, & st) < 0) return err_exit(errno);
+
+  std::shared_ptr<PreloadImage> ret{new PreloadImage()};
+  ret->id_ = file_id(st);
+  ret->size_ = (size_t) st.st_size;
+
+  if(ret->size_ > 0U)
+  {
+    void * addr = MAP_FAILED;
+
+    // Try huge pages (no sense for small file)
+    constexpr size_t huge_page = constants::preload_huge_page_size;
+    if(ret->size_ >= huge_page)
+    {
+      ret->alloc_size_ = (ret->size_ + huge_page - 1U) /
+                         huge_page * huge_page;
+      addr = mmap(nullptr, ret->alloc_size_, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      ret->huge_ = (addr != MAP_FAILED);
+    }
+
+    // ... else use normal pages
+    if(!ret->huge_)
+    {
+      size_t page = (size_t) sysconf(_SC_PAGESIZE);
+      ret->alloc_size_ = (ret->size_ + page - 1U) / page * page;
+      addr = mmap(nullptr, ret->alloc_size_, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if(addr == MAP_FAILED) return err_exit(errno);
+
+      if(ret->size_ >= huge_page)
+      {
+        madvise(addr, ret->alloc_size_, MADV_HUGEPAGE); // transparent
+      }
+    }
+    ret->data_ = (char *) addr;
+
+    // Read whole file
+    size_t done = 0U;
+    while(done < ret->size_)
+    {
+      ssize_t res = pread(fd, ret->data_ + done, ret->size_ - done, done);
+      if(res < 0)
+      {
+        if(errno == EINTR) continue;
+        return err_exit(errno);
+      }
+      if(res == 0) return err_exit(EIO); // file was truncated
+
+      done += (size_t) res;
+    }
+
+    ret->locked_ = (mlock(ret->data_, ret->alloc_size_) == 0);
+    mprotect(ret->data_, ret->alloc_size_, PROT_READ);
+  }
+  else
+  {
+    ret->locked_ = true; // nothing to lock
+  }
+
+  ::close(fd);
+
+  return {ret, 0};
+}
+
+// -----------------------------------------------------------------------------
+
+auto PreloadImage::data() const -> const char *
+{
+  return data_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto PreloadImage::size() const -> size_t
+{
+  return size_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto PreloadImage::alloc_size() const -> size_t
+{
+  return alloc_size_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto PreloadImage::id() const -> const FileId &
+{
+  return id_;
+}
+
+// -----------------------------------------------------------------------------
+
+bool PreloadImage::is_huge() const
+{
+  return huge_;
+}
+
+// -----------------------------------------------------------------------------
+
+bool PreloadImage::is_locked() const
+{
+  return locked_;
+}
+
+// -----------------------------------------------------------------------------
+
+Preload::Preload():
+    mutex_{},
+    images_{}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+Preload::~Preload()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+auto Preload::load(
+    const std::string & path,
+    const Preload * prev) -> std::tuple<pPreloadImage, int>
+{
+  {
+    std::lock_guard lk{mutex_};
+
+    if(auto it = images_.find(path); it != images_.end())
+    {
+      return {it->second, 0};
+    }
+  }
+
+  // Share image of unchanged file
+  if(struct stat st; prev && (::stat(path.c_str(), & st) == 0))
+  {
+    if(auto img = prev->find(path, file_id(st)); img)
+    {
+      std::lock_guard lk{mutex_};
+      images_[path] = img;
+      return {img, 0};
+    }
+  }
+
+  auto [img, err] = PreloadImage::create(path);
+
+  if(img)
+  {
+    std::lock_guard lk{mutex_};
+    images_[path] = img;
+  }
+
+  return {img, err};
+}
+
+// -----------------------------------------------------------------------------
+
+auto Preload::find(const std::string & path, const FileId & id) const
+    -> pPreloadImage
+{
+  std::lock_guard lk{mutex_};
+
+  auto it = images_.find(path);
+  if((it == images_.end()) || (it->second->id() != id)) return nullptr;
+
+  return it->second;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Preload::stat() const -> std::tuple<size_t, size_t, size_t>
+{
+  std::lock_guard lk{mutex_};
+
+  size_t data_size = 0U;
+  size_t alloc_size = 0U;
+  for(auto & [path, img] : images_)
+  {
+    data_size += img->size();
+    alloc_size += img->alloc_size();
+  }
+
+  return {images_.size(), data_size, alloc_size};
+}
+
+// -----------------------------------------------------------------------------
+
+auto read_preload_manifest(const std::string & path)
+    -> std::tuple<bool, std::vector<std::string>>
+{
+  std::vector<std::string> ret;
+
+  std::ifstream manifest{path, std::ios_base::in};
+  if(!manifest.is_open()) return {false, ret};
+
+  std::string line;
+  while(std::getline(manifest, line))
+  {
+    // Trim spaces
+    auto begin = line.find_first_not_of(" \t\r");
+    if(begin == std::string::npos) continue;
+    auto end = line.find_last_not_of(" \t\r");
+
+    if(line[begin] == '#') continue;
+
+    ret.push_back(line.substr(begin, end - begin + 1U));
+  }
+
+  return {true, ret};
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
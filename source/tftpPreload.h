@@ -0,0 +1,187 @@
+/**
+ * \file tftpPreload.h
+ * \brief Preloaded files class header
+ *
+ *  Files loaded to locked memory at server start
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPPRELOAD_H_
+#define SOURCE_TFTPPRELOAD_H_
+
+#include <map>
+#include <mutex>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Size of huge page used for align preloaded memory
+  constexpr size_t preload_huge_page_size = 2U*1024U*1024U;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Content of one file in memory
+ *
+ *  Memory allocated from huge pages if possible (MAP_HUGETLB, else
+ *  transparent huge pages advice) and locked in RAM if possible.
+ *  Create only from PreloadImage::create() as shared pointer.
+ */
+class PreloadImage
+{
+protected:
+
+  char * data_;       ///< Begin of memory (nullptr for empty file)
+  size_t size_;       ///< Size of file data
+  size_t alloc_size_; ///< Size of allocated memory
+  FileId id_;         ///< File identity at load moment
+  bool   huge_;       ///< Flag: memory from huge pages (MAP_HUGETLB)
+  bool   locked_;     ///< Flag: memory locked in RAM
+
+  /** \brief Default constructor
+   */
+  PreloadImage();
+
+public:
+
+  PreloadImage(const PreloadImage &) = delete; ///< Deleted/unused
+
+  PreloadImage & operator=(const PreloadImage &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Unlock and free memory
+   */
+  virtual ~PreloadImage();
+
+  /** \brief Load file to memory
+   *
+   *  \param [in] path Path to file
+   *  \return Tuple<pointer to image (nullptr on error); errno value>
+   */
+  static auto create(const std::string & path)
+      -> std::tuple<std::shared_ptr<PreloadImage>, int>;
+
+  /** \brief Get begin of file data
+   *
+   *  \return Pointer
+   */
+  auto data() const -> const char *;
+
+  /** \brief Get size of file data
+   *
+   *  \return Size
+   */
+  auto size() const -> size_t;
+
+  /** \brief Get size of allocated memory
+   *
+   *  \return Size
+   */
+  auto alloc_size() const -> size_t;
+
+  /** \brief Get file identity at load moment
+   *
+   *  \return Identity
+   */
+  auto id() const -> const FileId &;
+
+  /** \brief Check memory from huge pages
+   *
+   *  \return True if MAP_HUGETLB used, else - false
+   */
+  bool is_huge() const;
+
+  /** \brief Check memory locked in RAM
+   *
+   *  \return True if locked, else - false
+   */
+  bool is_locked() const;
+};
+
+using pPreloadImage = std::shared_ptr<PreloadImage>;
+
+// -----------------------------------------------------------------------------
+
+/** \brief Storage of preloaded files
+ *
+ *  Files found by path. Thread safe.
+ */
+class Preload
+{
+protected:
+
+  mutable std::mutex mutex_; ///< Mutex for images
+
+  std::map<std::string, pPreloadImage> images_; ///< Images by file path
+
+public:
+
+  /** \brief Default constructor
+   */
+  Preload();
+
+  Preload(const Preload &) = delete; ///< Deleted/unused
+
+  Preload & operator=(const Preload &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   */
+  virtual ~Preload();
+
+  /** \brief Load file to memory
+   *
+   *  If already loaded, then nothing to do
+   *  \param [in] path Path to file
+   *  \param [in] prev Previous storage; its image of unchanged file shared
+   *  \return Tuple<pointer to image (nullptr on error); errno value>
+   */
+  auto load(
+      const std::string & path,
+      const Preload * prev = nullptr) -> std::tuple<pPreloadImage, int>;
+
+  /** \brief Find preloaded file
+   *
+   *  \param [in] path Path to file
+   *  \param [in] id Actual file identity
+   *  \return Pointer to image (nullptr if not loaded or file changed)
+   */
+  auto find(const std::string & path, const FileId & id) const
+      -> pPreloadImage;
+
+  /** \brief Get count of images and memory used
+   *
+   *  \return Tuple<count; file data size; allocated memory size>
+   */
+  auto stat() const -> std::tuple<size_t, size_t, size_t>;
+};
+
+// -----------------------------------------------------------------------------
+
+/** \brief Read manifest of preloaded files
+ *
+ *  One entry (md5 sum, file name or path) per line;
+ *  empty lines and lines started with '#' are skipped
+ *  \param [in] path Path to manifest
+ *  \return Tuple<success read; entries>
+ */
+auto read_preload_manifest(const std::string & path)
+    -> std::tuple<bool, std::vector<std::string>>;
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPPRELOAD_H_ */
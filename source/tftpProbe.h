@@ -0,0 +1,60 @@
+/**
+ * \file tftpProbe.h
+ * \brief Static tracepoints header
+ *
+ *  USDT probes of provider "server_fw" for perf, bpftrace, systemtap.
+ *  Probes made by <sys/sdt.h> (package systemtap-sdt-dev); every probe is
+ *  one nop instruction and note in ELF. If header not found or defined
+ *  TFTP_NO_PROBES, then probes compiled to nothing.
+ *
+ *  Probes (arguments):
+ *  - request (session id, opcode, packet size, client port)
+ *  - state   (session id, old state, new state, stage)
+ *  - tx      (session id, stage, packet size, success flag)
+ *  - rx      (session id, opcode, block number, packet size)
+ *  - read    (session id, file position, blocks count, result size)
+ *  - write   (session id, file position, data size, result size)
+ *
+ *  Example: bpftrace -e 'usdt:./bin/server-fw:server_fw:state
+ *    { printf("%d %d->%d\n", arg0, arg1, arg2); }'
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPPROBE_H_
+#define SOURCE_TFTPPROBE_H_
+
+#if !defined(TFTP_NO_PROBES) && __has_include(<sys/sdt.h>)
+
+#include <sys/sdt.h>
+
+/// Flag: probes compiled in
+#define TFTP_PROBES_ENABLED 1
+
+#define TFTP_PROBE3(NAME, A1, A2, A3) \
+    DTRACE_PROBE3(server_fw, NAME, A1, A2, A3)
+
+#define TFTP_PROBE4(NAME, A1, A2, A3, A4) \
+    DTRACE_PROBE4(server_fw, NAME, A1, A2, A3, A4)
+
+#else
+
+/// Flag: probes compiled in
+#define TFTP_PROBES_ENABLED 0
+
+// Arguments not evaluated (only marked as used)
+#define TFTP_PROBE3(NAME, A1, A2, A3) \
+    do { (void) sizeof(A1); (void) sizeof(A2); (void) sizeof(A3); } while(false)
+
+#define TFTP_PROBE4(NAME, A1, A2, A3, A4) \
+    do { (void) sizeof(A1); (void) sizeof(A2); (void) sizeof(A3); \
+         (void) sizeof(A4); } while(false)
+
+#endif
+
+#endif /* SOURCE_TFTPPROBE_H_ */
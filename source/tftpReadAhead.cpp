@@ -0,0 +1,117 @@
+/**
+ * \file tftpReadAhead.cpp
+ * \brief Read-ahead workers class module
+ *
+ *  Background I/O threads for prepare next window of read requests
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "tftpReadAhead.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+ReadAhead::ReadAhead(size_t threads):
+    mutex_{},
+    cv_{},
+    tasks_{},
+    threads_{},
+    max_threads_{threads},
+    stop_{false},
+    hits_{0U},
+    misses_{0U}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+ReadAhead::~ReadAhead()
+{
+  {
+    std::lock_guard lk{mutex_};
+    stop_ = true;
+  }
+  cv_.notify_all();
+
+  for(auto & thr : threads_) thr.join();
+}
+
+// -----------------------------------------------------------------------------
+
+bool ReadAhead::enabled() const
+{
+  return max_threads_ > 0U;
+}
+
+// -----------------------------------------------------------------------------
+
+auto ReadAhead::submit(std::function<ssize_t()> task) -> std::future<ssize_t>
+{
+  if(!enabled()) return {};
+
+  Task new_task{std::move(task)};
+  auto ret = new_task.get_future();
+
+  {
+    std::lock_guard lk{mutex_};
+
+    // Lazy start of threads
+    while(threads_.size() < max_threads_)
+    {
+      threads_.emplace_back(& ReadAhead::worker_loop, this);
+    }
+
+    tasks_.push_back(std::move(new_task));
+  }
+  cv_.notify_one();
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void ReadAhead::worker_loop()
+{
+  for(;;)
+  {
+    Task curr_task;
+    {
+      std::unique_lock lk{mutex_};
+      cv_.wait(lk, [&]{ return stop_ || !tasks_.empty(); });
+
+      if(tasks_.empty()) return; // stop only when queue empty
+
+      curr_task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    curr_task();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ReadAhead::account(bool ready)
+{
+  if(ready) ++hits_;
+       else ++misses_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto ReadAhead::stat() const -> std::tuple<size_t, size_t>
+{
+  return {hits_.load(), misses_.load()};
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
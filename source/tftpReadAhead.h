@@ -0,0 +1,123 @@
+/**
+ * \file tftpReadAhead.h
+ * \brief Read-ahead workers class header
+ *
+ *  Background I/O threads for prepare next window of read requests
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPREADAHEAD_H_
+#define SOURCE_TFTPREADAHEAD_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Default count of read-ahead I/O threads (0 - read-ahead disabled)
+  constexpr size_t default_read_ahead_threads = 2U;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Pool of background I/O threads for read-ahead
+ *
+ *  Session submit read of next window while wait ACK of current window;
+ *  when ACK received, window already prepared in session buffers.
+ *  Threads started on first submit.
+ *  Thread safe.
+ */
+class ReadAhead
+{
+protected:
+
+  using Task = std::packaged_task<ssize_t()>;
+
+  std::mutex mutex_; ///< Mutex for tasks queue
+
+  std::condition_variable cv_; ///< Notify threads about new task or stop
+
+  std::deque<Task> tasks_; ///< Queue of tasks
+
+  std::vector<std::thread> threads_; ///< Working threads
+
+  size_t max_threads_; ///< Count of working threads
+
+  bool stop_; ///< Flag: stop working threads
+
+  std::atomic<size_t> hits_; ///< Counter of windows ready when need
+
+  std::atomic<size_t> misses_; ///< Counter of windows not ready when need
+
+  /** \brief Working thread loop
+   */
+  void worker_loop();
+
+public:
+
+  /** \brief Constructor
+   *
+   *  \param [in] threads Count of working threads; 0 - read-ahead disabled
+   */
+  ReadAhead(size_t threads = constants::default_read_ahead_threads);
+
+  ReadAhead(const ReadAhead &) = delete; ///< Deleted/unused
+
+  ReadAhead & operator=(const ReadAhead &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Finish queued tasks and stop working threads
+   */
+  virtual ~ReadAhead();
+
+  /** \brief Check read-ahead enabled
+   *
+   *  \return True if enabled, else - false
+   */
+  bool enabled() const;
+
+  /** \brief Submit read task
+   *
+   *  \param [in] task Read function; return processed size, -1 on error
+   *  \return Future of task result (invalid if read-ahead disabled)
+   */
+  auto submit(std::function<ssize_t()> task) -> std::future<ssize_t>;
+
+  /** \brief Count use of prepared window
+   *
+   *  \param [in] ready Flag: window was ready when need
+   */
+  void account(bool ready);
+
+  /** \brief Get counters of ready and not ready windows
+   *
+   *  \return Tuple<hits; misses>
+   */
+  auto stat() const -> std::tuple<size_t, size_t>;
+};
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPREADAHEAD_H_ */
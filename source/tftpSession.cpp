@@ -13,12 +13,17 @@
  *  \version 0.2.1
  */
 
-#include <regex>
+#include <cstring>
 #include <unistd.h>
 
 #include "tftpSession.h"
 #include "tftpSmBufEx.h"
+#include "tftpPkt.h"
 #include "tftpDataMgrFile.h"
+#include "tftpDataMgrMmap.h"
+#include "tftpBlockCache.h"
+#include "tftpMetrics.h"
+#include "tftpProbe.h"
 
 namespace tftp
 {
@@ -36,7 +41,25 @@ Session::Session(pSettings new_settings):
     error_code_{0U},
     error_message_{""},
     opt_{},
-    file_man_{nullptr}
+    file_man_{nullptr},
+    window_{},
+    window_stage_{0U},
+    window_count_{0U},
+    window_next_{},
+    window_next_stage_{0U},
+    window_next_count_{0U},
+    read_ahead_{},
+    gap_stage_{0U},
+    gap_ack_{false},
+    summary_{},
+    request_time_{},
+    id_{0U},
+    progress_bytes_{0U},
+    progress_blocks_{0U},
+    cancel_{false},
+    flight_{},
+    flight_count_{0U},
+    flight_dumped_{false}
 {
 }
 
@@ -58,6 +81,7 @@ Session::Session(const Base & base):
 
 Session::~Session()
 {
+  read_ahead_wait(); // task use file manager and window buffers
 }
 
 // -----------------------------------------------------------------------------
@@ -77,6 +101,24 @@ auto Session::operator=(Session && val) -> Session &
     std::swap(error_message_, val.error_message_);
     std::swap(opt_, val.opt_);
     std::swap(file_man_, val.file_man_);
+    std::swap(window_, val.window_);
+    window_stage_  = val.window_stage_;
+    window_count_  = val.window_count_;
+    std::swap(window_next_, val.window_next_);
+    window_next_stage_ = val.window_next_stage_;
+    window_next_count_ = val.window_next_count_;
+    std::swap(read_ahead_, val.read_ahead_);
+    gap_stage_     = val.gap_stage_;
+    gap_ack_       = val.gap_ack_;
+    summary_       = val.summary_;
+    request_time_  = val.request_time_;
+    id_            = val.id_;
+    progress_bytes_.store(val.progress_bytes_);
+    progress_blocks_.store(val.progress_blocks_);
+    cancel_.store(val.cancel_);
+    flight_        = val.flight_;
+    flight_count_  = val.flight_count_;
+    flight_dumped_ = val.flight_dumped_;
   }
 
   return *this;
@@ -114,7 +156,8 @@ bool Session::switch_to(const State & new_state)
         break;
       case State::data_rx:
         ret = (new_state == State::ack_tx) ||
-              (new_state == State::retransmit);
+              (new_state == State::retransmit) ||
+              (new_state == State::error_and_stop);
         break;
       case State::ack_tx:
         ret = (new_state == State::data_rx) ||
@@ -123,11 +166,13 @@ bool Session::switch_to(const State & new_state)
       case State::ack_rx:
         ret = (new_state == State::data_tx) ||
               (new_state == State::retransmit) ||
-              (new_state == State::finish);
+              (new_state == State::finish) ||
+              (new_state == State::error_and_stop);
         break;
       case State::retransmit:
-        ret = (new_state == State::data_tx) ||
-              (new_state == State::ack_tx ) ||
+        ret = (new_state == State::data_tx    ) ||
+              (new_state == State::ack_tx     ) ||
+              (new_state == State::ack_options) ||
               (new_state == State::error_and_stop);
         break;
       case State::finish: // no way to switch
@@ -135,6 +180,8 @@ bool Session::switch_to(const State & new_state)
     }
   }
 
+  TFTP_PROBE4(state, id_, (int) stat_.load(), (int) new_state, stage_);
+
   if(ret)
   {
     L_DBG("State: "+stat_+" -> "+new_state);
@@ -142,8 +189,11 @@ bool Session::switch_to(const State & new_state)
   }
   else
   {
-    L_ERR("Wrong switch state: "+stat_+" -> "+new_state+"! Switch to finish");
-    stat_.store(State::finish); // Skip any loop
+    L_ERR("Wrong switch state: "+stat_+" -> "+new_state+"! Stop session");
+    set_error_if_first(0U, "Internal server error");
+    // Skip any loop; error_and_stop -> finish always allowed
+    stat_.store(stat_ == State::error_and_stop ? State::finish :
+                                                  State::error_and_stop);
   }
 
   return ret;
@@ -158,6 +208,37 @@ bool Session::is_finished() const
 
 // -----------------------------------------------------------------------------
 
+auto Session::id() const -> uint64_t
+{
+  return id_;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Session::snapshot() const -> Snapshot
+{
+  // Address and options assigned in prepare() before session thread start
+  return Snapshot{
+      id_,
+      cl_addr_.str(),
+      opt_.request_type(),
+      opt_.filename(),
+      stat_.load(),
+      progress_bytes_.load(std::memory_order_relaxed),
+      progress_blocks_.load(std::memory_order_relaxed),
+      (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now() - request_time_).count()};
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::cancel()
+{
+  cancel_.store(true);
+}
+
+// -----------------------------------------------------------------------------
+
 auto Session::block_size() const -> uint16_t
 {
   return opt_.blksize();
@@ -184,6 +265,10 @@ bool Session::prepare(
     const SmBuf  & pkt_data,
     const size_t & pkt_data_size)
 {
+  static std::atomic<uint64_t> last_id{0U};
+  id_ = ++last_id;
+  request_time_ = Clock::now();
+
   L_INF("Session prepare started");
 
   bool ret=true;
@@ -234,7 +319,6 @@ bool Session::init()
   // Bind socket
   if(ret)
   {
-    begin_shared();
     ret = bind(
         socket_,
         (struct sockaddr *) my_addr_.data(),
@@ -261,11 +345,21 @@ bool Session::init()
     // TODO:: init() for DataMgrDB
     bool init_stream = false; // remove it!
 
-    // Try 2 - File
+    // Try 2 - File (memory mapped for read, if not used block cache)
     if(!init_stream)
     {
+      auto block_cache = get_block_cache();
+      bool use_cache = block_cache && block_cache->enabled();
+
       file_man_.release();
-      file_man_ = std::make_unique<DataMgrFile>();
+      if((opt_.request_type() == SrvReq::read) && get_use_mmap() && !use_cache)
+      {
+        file_man_ = std::make_unique<DataMgrMmap>();
+      }
+      else
+      {
+        file_man_ = std::make_unique<DataMgrFile>();
+      }
 
       init_stream = file_man_->init(
           settings_,
@@ -291,49 +385,22 @@ bool Session::init()
 
 // -----------------------------------------------------------------------------
 
-void Session::construct_opt_reply(SmBufEx & buf)
+void Session::construct_opt_reply(SmBufView & buf)
 {
-  buf.clear();
-
-  buf.push_data((uint16_t) 6U);
-
-  if(opt_.was_set_blksize())
-  {
-    buf.push_data(constants::name_blksize);
-    buf.push_data(std::to_string(opt_.blksize()));
-  }
-
-  if(opt_.was_set_timeout())
+  if(pkt::encode_oack(buf, opt_))
   {
-    buf.push_data(constants::name_timeout);
-    buf.push_data(std::to_string(opt_.timeout()));
-  }
-
-  if(opt_.was_set_tsize())
-  {
-    buf.push_data(constants::name_tsize);
-    buf.push_data(std::to_string(opt_.tsize()));
-  }
-  if(opt_.was_set_windowsize())
-  {
-    buf.push_data(constants::name_windowsize);
-    buf.push_data(std::to_string(opt_.windowsize()));
+    L_DBG("Construct confirm options pkt "+
+            std::to_string(buf.data_size())+" octets");
   }
-
-  if(buf.data_size() < 4)
+  else
   { // Nothing to do
     buf.clear();
   }
-  else
-  {
-    L_DBG("Construct confirm options pkt "+
-            std::to_string(buf.data_size())+" octets");
-  }
 }
 
 // -----------------------------------------------------------------------------
 
-void  Session::construct_error(SmBufEx & buf)
+void  Session::construct_error(SmBufView & buf)
 {
   if(!was_error())
   {
@@ -341,9 +408,7 @@ void  Session::construct_error(SmBufEx & buf)
     error_message_ = "Undefined error";
   }
 
-  buf.clear();
-
-  buf.push_data((uint16_t) 5U, error_code_, error_message_);
+  if(!pkt::encode_error(buf, error_code_, error_message_)) buf.clear();
 
   L_DBG("Construct error pkt #"+std::to_string(error_code_)+
         " '"+std::string(error_message_)+"'; "+
@@ -354,38 +419,167 @@ void  Session::construct_error(SmBufEx & buf)
 
 // -----------------------------------------------------------------------------
 
-void Session::construct_data(SmBufEx & buf)
+auto Session::window_slots(
+    std::vector<SmBufEx> & pkts,
+    const size_t & first_stage) -> std::vector<BlkSlot>
 {
-  buf.clear();
+  const size_t pkt_size = block_size() + 4U;
+
+  // Blocks from first to end of window
+  size_t count = windowsize() - (first_stage - 1U) % windowsize();
+  count = std::min(
+      count,
+      std::max((size_t) 1U, constants::max_window_read_size / block_size()));
 
-  buf.push_data((uint16_t) 3U, blk_num_local());
+  pkts.reserve(count);
+  while(pkts.size() < count) pkts.emplace_back(pkt_size);
 
-  ssize_t ret = file_man_->read(
-      buf.begin() + buf.data_size(),
-      buf.begin() + buf.data_size() + block_size(),
-      (stage_-1U) * block_size());
+  std::vector<BlkSlot> slots;
+  slots.reserve(count);
+  for(size_t iter = 0U; iter < count; ++iter)
+  {
+    auto & curr_pkt = pkts[iter];
+    pkt::encode_data_header(
+        curr_pkt,
+        (uint16_t) ((first_stage + iter) & 0xFFFFU));
+    slots.emplace_back(
+        curr_pkt.begin() + constants::pkt_header_size,
+        curr_pkt.begin() + pkt_size);
+  }
 
+  return slots;
+}
 
-  if(ret >=0)
+// -----------------------------------------------------------------------------
+
+void Session::window_sizes(
+    std::vector<SmBufEx> & pkts,
+    const size_t & count,
+    size_t data_size)
+{
+  for(size_t iter = 0U; iter < count; ++iter)
+  {
+    size_t curr_size = std::min(data_size, (size_t) block_size());
+    pkts[iter].data_size_reset(4U + curr_size);
+    data_size -= curr_size;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::construct_window()
+{
+  // Try use window prepared by read-ahead
+  if(read_ahead_.valid())
   {
-    L_DBG("Construct data pkt block "+std::to_string(stage_)+
+    bool ready = read_ahead_.wait_for(std::chrono::seconds(0)) ==
+                 std::future_status::ready;
+    ssize_t ret = read_ahead_.get();
+
+    if(auto ra = get_read_ahead(); ra)
+    {
+      ra->account(ready && (window_next_stage_ == stage_) && (ret >= 0));
+    }
+
+    if((window_next_stage_ == stage_) && (ret >= 0))
+    {
+      L_DBG("Use read-ahead data pkt blocks "+std::to_string(stage_)+
+            ".."+std::to_string(stage_ + window_next_count_ - 1U)+
             "; data size "+std::to_string(ret)+" bytes");
-    buf.data_size_reset(buf.data_size() + ret);
+
+      std::swap(window_, window_next_);
+      window_sizes(window_, window_next_count_, (size_t) ret);
+      window_stage_ = stage_;
+      window_count_ = window_next_count_;
+
+      read_ahead_start((size_t) ret);
+      return;
+    }
+  }
+
+  auto slots = window_slots(window_, stage_);
+
+  window_stage_ = stage_;
+  window_count_ = 0U;
+
+  auto read_start = Clock::now();
+  ssize_t ret = file_man_->read_blocks(slots, (stage_-1U) * block_size());
+  Metrics::observe_since(Hist::disk_read, read_start, slots.size());
+  TFTP_PROBE4(read, id_, (stage_-1U) * block_size(), slots.size(), ret);
+
+  if(ret >=0)
+  {
+    L_DBG("Construct data pkt blocks "+std::to_string(stage_)+
+          ".."+std::to_string(stage_ + slots.size() - 1U)+
+          "; data size "+std::to_string(ret)+" bytes");
+
+    window_sizes(window_, slots.size(), (size_t) ret);
+    window_count_ = slots.size();
+
+    read_ahead_start((size_t) ret);
   }
   else // error prepare data
   {
     L_ERR("Error prepare data");
     set_error_if_first(0, "Failed prepare data to send");
+    window_[0U].clear();
   }
 }
 
 // -----------------------------------------------------------------------------
 
-void Session::construct_ack(SmBufEx & buf)
+void Session::read_ahead_start(const size_t & data_size)
 {
-  buf.clear();
+  // Not need if end of data reached
+  if(data_size < window_count_ * block_size()) return;
 
-  buf.push_data((uint16_t)4U, blk_num_local()); // tftp header
+  auto ra = get_read_ahead();
+  if(!ra || !ra->enabled()) return;
+
+  window_next_stage_ = window_stage_ + window_count_;
+  auto slots = window_slots(window_next_, window_next_stage_);
+  window_next_count_ = slots.size();
+
+  read_ahead_ = ra->submit(
+      [dm = file_man_.get(),
+       slots = std::move(slots),
+       position = (window_next_stage_ - 1U) * block_size(),
+       id = id_]()
+      {
+        auto read_start = Clock::now();
+        ssize_t ret = dm->read_blocks(slots, position);
+        Metrics::observe_since(Hist::disk_read, read_start, slots.size());
+        TFTP_PROBE4(read, id, position, slots.size(), ret);
+        return ret;
+      });
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::read_ahead_wait()
+{
+  if(read_ahead_.valid()) read_ahead_.wait();
+}
+
+// -----------------------------------------------------------------------------
+
+auto Session::construct_data() -> const SmBufEx &
+{
+  if((stage_ < window_stage_) ||
+     (stage_ >= (window_stage_ + window_count_)))
+  {
+    construct_window();
+    if(!window_count_) return window_[0U];
+  }
+
+  return window_[stage_ - window_stage_];
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::construct_ack(SmBufView & buf)
+{
+  pkt::encode_ack(buf, blk_num_local());
 
   L_DBG("Construct ACK pkt block "+std::to_string(blk_num_local()));
 }
@@ -394,11 +588,15 @@ void Session::construct_ack(SmBufEx & buf)
 void Session::run()
 {
   L_INF("Running session");
+  Metrics::add(Metric::sessions_started);
+  summary_ = Summary{};
+  summary_.start = Clock::now();
 
   // Prepare
   bool last_blk_processed_{false};
   uint16_t retr_count{0U};
-  SmBufEx local_buf{0xFFFFU};
+  std::unique_ptr<char[]> local_mem{new char[0xFFFFU]}; // not initialised
+  SmBufView local_buf{local_mem.get(), 0xFFFFU};
   time_t oper_time_{0};
 
   auto timeout_pass = [&]()
@@ -411,6 +609,15 @@ void Session::run()
   stage_ = 0U;
   while(!is_finished())
   {
+    if(cancel_.load(std::memory_order_relaxed) &&
+       (stat_ != State::need_init) &&
+       !was_error())
+    {
+      L_WRN("Session cancelled by administrator");
+      set_error_if_first(0U, "Session cancelled by administrator");
+      stat_.store(State::error_and_stop); // from any state
+    }
+
     switch(stat_)
     {
       case State::need_init: // ------------------------------------------------
@@ -432,11 +639,14 @@ void Session::run()
         break;
 
       case State::error_and_stop: // -------------------------------------------
+        read_ahead_wait();
         if(was_error())
         {
           construct_error(local_buf);
           transmit_no_wait(local_buf);
+          Metrics::error(error_code_);
         }
+        flight_dump("session stopped by error", stop_dump_level());
         switch_to(State::finish);
         break;
 
@@ -445,6 +655,7 @@ void Session::run()
         {
           construct_opt_reply(local_buf);
           transmit_no_wait(local_buf);
+          summary_rtt_begin();
         }
         timeout_reset();
         switch(opt_.request_type())
@@ -481,18 +692,23 @@ void Session::run()
 
       case State::data_tx: // --------------------------------------------------
         {
-          construct_data(local_buf);
-          if(!was_error() && (local_buf.data_size() > 0U))
+          auto & data_pkt = construct_data();
+          if(!was_error() && (data_pkt.data_size() > 0U))
           {
-            transmit_no_wait(local_buf);
-            //++stage_;
-            last_blk_processed_ = local_buf.data_size() != (block_size()+4U);
+            transmit_no_wait(data_pkt);
+            last_blk_processed_ = data_pkt.data_size() != (block_size()+4U);
+            summary_block(data_pkt.data_size() - 4U);
 
             if(is_window_close(stage_) || last_blk_processed_)
             {
+              summary_rtt_begin();
               timeout_reset();
               switch_to(State::ack_rx);
             }
+            else
+            {
+              ++stage_;
+            }
           }
           else
           {
@@ -505,14 +721,26 @@ void Session::run()
         switch(receive_no_wait(local_buf))
         {
           case TripleResult::nop:
+            if(gap_ack_)
+            {
+              // Repeat ACK of last received block
+              gap_ack_ = false;
+              --stage_;
+              switch_to(State::ack_tx);
+            }
+            else
             if(!timeout_pass())
             {
+              Metrics::add(Metric::timeouts);
+              flight_record(FlightDir::timeout, Clock::now());
               switch_to(State::retransmit);
             }
             break;
           case TripleResult::ok:
             last_blk_processed_ = local_buf.data_size() != (block_size()+4U);
-            if(is_window_close(stage_))
+            summary_rtt_end();
+            summary_block(local_buf.data_size() - 4U);
+            if(is_window_close(stage_) || last_blk_processed_)
             {
               switch_to(State::ack_tx);
             }
@@ -539,6 +767,7 @@ void Session::run()
         else
         {
           switch_to(State::data_rx);
+          summary_rtt_begin();
           timeout_reset();
         }
         break;
@@ -549,10 +778,13 @@ void Session::run()
           case TripleResult::nop:
             if(!timeout_pass())
             {
+              Metrics::add(Metric::timeouts);
+              flight_record(FlightDir::timeout, Clock::now());
               switch_to(State::retransmit);
             }
             break;
           case TripleResult::ok:
+            summary_rtt_end();
             if(last_blk_processed_)
             {
               switch_to(State::finish);
@@ -575,10 +807,15 @@ void Session::run()
         {
           L_WRN("Retransmit count exceeded ("+std::to_string(retr_count)+
                 "); Break session");
+          summary_.timed_out = true;
           switch_to(State::error_and_stop);
         }
         else
         {
+          Metrics::add(Metric::retransmits);
+          ++summary_.retransmits;
+          summary_.rtt_wait = false;
+          summary_.rtt_skip = true; // ambiguous reply of retransmitted packet
           //step_back_window(stage_);
           switch(opt_.request_type())
           {
@@ -586,10 +823,20 @@ void Session::run()
               switch_to(State::error_and_stop);
               break;
             case SrvReq::read:
-              switch_to(State::data_tx);
+              // OACK not acknowledged yet (stage 0) - repeat it, not DATA
+              switch_to(stage_ ? State::data_tx : State::ack_options);
               break;
             case SrvReq::write:
-              switch_to(State::ack_tx);
+              // No DATA yet - repeat OACK; else ACK of last received block
+              if((stage_ == 1U) && opt_.was_set_any())
+              {
+                switch_to(State::ack_options);
+              }
+              else
+              {
+                --stage_;
+                switch_to(State::ack_tx);
+              }
               break;
           }
           timeout_reset();
@@ -602,8 +849,16 @@ void Session::run()
   } // end main loop
 
   socket_close();
+  read_ahead_wait();
   file_man_->close();
 
+  Metrics::add(Metric::sessions_finished);
+  if(!was_error() && !summary_.timed_out)
+  {
+    Metrics::observe_since(Metrics::transfer_hist(summary_.data_bytes),
+                           summary_.start);
+  }
+  summary_write();
   L_INF("Finish session");
 }
 
@@ -616,7 +871,9 @@ void Session::set_error_if_first(
   L_DBG("Try register error #"+std::to_string(e_cod)+
         " '"+std::string(e_msg)+"'");
 
-  if(!was_error())
+  std::lock_guard lk{error_mutex_};
+
+  if((error_code_ == 0U) && (error_message_.size() == 0U))
   {
     L_DBG("Rememver it");
     error_code_ = e_cod;
@@ -628,30 +885,45 @@ void Session::set_error_if_first(
 
 bool Session::was_error()
 {
+  std::lock_guard lk{error_mutex_};
+
   return (error_code_ > 0U) || (error_message_.size() > 0U);
 }
 
 // -----------------------------------------------------------------------------
 
-bool Session::transmit_no_wait(const SmBufEx & buf)
+bool Session::transmit_no_wait(const char * data, const size_t & data_size)
 {
   bool ret = false;
 
-  if(buf.data_size() > 0U)
+  if(data_size > 0U)
   {
+    summary_.last_tx = Clock::now();
     ssize_t tx_result_size = sendto(
         socket_,
-        buf.data(),
-        buf.data_size(),
+        data,
+        data_size,
         0,
         cl_addr_.as_sockaddr_ptr(),
         cl_addr_.data_size());
 
-    ret = (tx_result_size == (ssize_t)buf.data_size());
+    ret = (tx_result_size == (ssize_t)data_size);
+    const pkt::Rx tx = pkt::classify(data, data_size);
+    flight_record(FlightDir::tx, summary_.last_tx, (uint16_t) tx.op, tx.field,
+                  data_size);
+    TFTP_PROBE4(tx, id_, stage_, data_size, ret);
 
     if(ret) // Good send
     {
-      L_DBG("Success send packet "+std::to_string(buf.data_size())+
+      Metrics::add(Metric::bytes_tx, data_size);
+      summary_.wire_bytes += data_size;
+      if(!summary_.replied &&
+         ((data_size < 2U) || (data[1U] != (char) pkt::Op::error)))
+      {
+        summary_.replied = true;
+        Metrics::observe_since(Hist::first_reply, request_time_);
+      }
+      L_DBG("Success send packet "+std::to_string(data_size)+
             " octets");
     }
     else // Fail send
@@ -664,7 +936,7 @@ bool Session::transmit_no_wait(const SmBufEx & buf)
       {
         L_ERR("sendto() lost data error: sended "+
               std::to_string(tx_result_size)+
-              " from "+std::to_string(buf.data_size()));
+              " from "+std::to_string(data_size));
       }
     }
   }
@@ -678,7 +950,21 @@ bool Session::transmit_no_wait(const SmBufEx & buf)
 
 // -----------------------------------------------------------------------------
 
-auto Session::receive_no_wait(SmBufEx & buf) -> TripleResult
+bool Session::transmit_no_wait(const SmBufEx & buf)
+{
+  return transmit_no_wait(buf.data(), buf.data_size());
+}
+
+// -----------------------------------------------------------------------------
+
+bool Session::transmit_no_wait(const SmBufView & buf)
+{
+  return transmit_no_wait(buf.data(), buf.data_size());
+}
+
+// -----------------------------------------------------------------------------
+
+auto Session::receive_no_wait(SmBufView & buf) -> TripleResult
 {
   Addr rx_client;
   rx_client.data_size() = rx_client.size();
@@ -706,40 +992,28 @@ auto Session::receive_no_wait(SmBufEx & buf) -> TripleResult
 
   buf.data_size_reset((size_t) rx_pkt_size);
 
-  // Extract meta info
-  uint16_t rx_op  = (rx_pkt_size > 3) ? buf.get_be<uint16_t>(0U) : 0U;
-  uint16_t rx_blk = (rx_pkt_size > 3) ? buf.get_be<uint16_t>(2U) : 0U;
-  uint16_t rx_data_size = (rx_pkt_size > 3) ? (uint16_t)(rx_pkt_size - 4) : 0U;
-
-  // Make debug message
-  std::string rx_msg = "Rx pkt ["+std::to_string(rx_pkt_size)+" octets]";
-  switch(rx_op)
-  {
-    case 3U: // DATA
-      rx_msg.append(": DATA blk "+std::to_string(rx_blk)+
-                    "; data size "+std::to_string(rx_data_size));
-      break;
-    case 4U: // ACK
-      rx_msg.append(": ACK blk "+std::to_string(rx_blk));
-      break;
-    case 5U: // ERROR
-      rx_msg.append(": ERROR #"+std::to_string(rx_blk)+
-                    " '"+buf.get_string(4U)+"'");
-      break;
-    default:
-      rx_msg.append(": FAKE tftp packet");
-      break;
-  }
+  // Classify packet (diagnostic message made only if logged)
+  const pkt::Rx rx = pkt::classify(buf.data(), (size_t) rx_pkt_size);
+  const uint16_t rx_blk = rx.field;
+  TFTP_PROBE4(rx, id_, (uint16_t) rx.op, rx_blk, rx_pkt_size);
+  auto rx_msg = [&]() { return pkt::to_string(rx, (size_t) rx_pkt_size); };
 
   // Check client address is right
   if(rx_client == cl_addr_)
   {
-    L_DBG(rx_msg+" from client");
+    flight_record(FlightDir::rx, Clock::now(), (uint16_t) rx.op, rx_blk,
+                  (size_t) rx_pkt_size);
+    Metrics::add(Metric::bytes_rx, (uint64_t) rx_pkt_size);
+    summary_.wire_bytes += (size_t) rx_pkt_size;
+    L_DBG(rx_msg()+" from client");
   }
   else
   {
     L_WRN("Alarm! Intrusion detect from addr "+cl_addr_.str()+
-          " with data: "+rx_msg+". Ignore pkt!");
+          " with data: "+rx_msg()+". Ignore pkt!");
+    flight_record(FlightDir::alien, Clock::now(), (uint16_t) rx.op, rx_blk,
+                  (size_t) rx_pkt_size);
+    if(!flight_dumped_) flight_dump("intrusion detected");
     return TripleResult::nop;
   }
 
@@ -747,37 +1021,31 @@ auto Session::receive_no_wait(SmBufEx & buf) -> TripleResult
                       (ssize_t)rx_blk - (ssize_t)blk_num_local();
 
   // Parse packet if need and do receive DATA
-  if((rx_op == 3U) && (stat_ == State::data_rx)) // DATA
+  if((rx.op == pkt::Op::data) && (stat_ == State::data_rx))
   {
-    if(rx_stage < 0)
+    // Old block (ACK lost) or lost blocks - repeat ACK of last received
+    // block once, client restart window from next block
+    if(rx_stage != (ssize_t)stage_)
     {
-      L_WRN("Wrong Data blk! rx #"+std::to_string(rx_blk)+
-            " need #"+std::to_string(blk_num_local())+
-            "; calculated stage="+std::to_string(rx_stage)+". Break session!");
-      set_error_if_first(0, "Error received number data block");
-      return  TripleResult::fail;
-    }
-
-    if(rx_stage > (ssize_t)(stage_+1U))
-    {
-      L_WRN("Skip (lost) data blocks! rx #"+std::to_string(rx_blk)+
-            " need #"+std::to_string(blk_num_local())+
-            "; calculated stage="+std::to_string(rx_stage)+". Break session!");
-      set_error_if_first(0, "Error received number data block");
-      return  TripleResult::fail;
-    }
-
-    if(blk_num_local() != rx_blk)
-    {
-      L_INF("Switch blk #"+std::to_string(blk_num_local())+
-            " -> #"+std::to_string(rx_blk));
-      stage_ = (size_t) rx_stage;
+      L_INF(std::string{rx_stage < (ssize_t)stage_ ? "Old" : "Lost"}+
+            " data blocks! rx #"+std::to_string(rx_blk)+
+            " need #"+std::to_string(blk_num_local())+". Ignore pkt!");
+      if(gap_stage_ != stage_)
+      {
+        gap_stage_ = stage_;
+        gap_ack_ = true;
+      }
+      return TripleResult::nop;
     }
 
+    auto write_start = Clock::now();
     ssize_t stored_data_size =  file_man_->write(
-        buf.cbegin() + 2*sizeof(uint16_t),
-        buf.cbegin() + rx_pkt_size,
+        rx.payload,
+        rx.payload_size,
         (stage_ - 1) * block_size());
+    Metrics::observe_since(Hist::disk_write, write_start);
+    TFTP_PROBE4(write, id_, (stage_ - 1) * block_size(), rx.payload_size,
+                stored_data_size);
     if(stored_data_size < 0)
     {
       L_ERR("Error from store data manager");
@@ -788,7 +1056,7 @@ auto Session::receive_no_wait(SmBufEx & buf) -> TripleResult
   }
 
   // Parse packet if need and do receive ACK
-  if((rx_op == 4U) && (stat_ == State::ack_rx)) // ACK
+  if((rx.op == pkt::Op::ack) && (stat_ == State::ack_rx))
   {
     if(rx_stage < 0)
     {
@@ -859,5 +1127,246 @@ auto Session::windowsize() const -> size_t
 
 // -----------------------------------------------------------------------------
 
-} // namespace tftp
+void Session::summary_block(const size_t & data_size)
+{
+  if(!stage_) return;
+
+  summary_.blocks = std::max(summary_.blocks, stage_);
+  summary_.data_bytes = std::max(summary_.data_bytes,
+                                 (stage_ - 1U) * block_size() + data_size);
+
+  progress_bytes_.store(summary_.data_bytes, std::memory_order_relaxed);
+  progress_blocks_.store(summary_.blocks, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::summary_rtt_begin()
+{
+  summary_.rtt_wait = !summary_.rtt_skip;
+  summary_.rtt_skip = false;
+  summary_.rtt_start = summary_.last_tx;
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::summary_rtt_end()
+{
+  if(!summary_.rtt_wait) return;
+
+  summary_.rtt_wait = false;
+
+  uint64_t rtt_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - summary_.rtt_start).count();
+
+  summary_.rtt_min_us = summary_.rtt_count ?
+      std::min(summary_.rtt_min_us, rtt_us) : rtt_us;
+  summary_.rtt_max_us = std::max(summary_.rtt_max_us, rtt_us);
+  summary_.rtt_sum_us += rtt_us;
+  ++summary_.rtt_count;
+
+  Metrics::observe(Hist::block_rtt, rtt_us);
+}
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+  /// Size of character escaped for JSON string
+  auto json_char_size(char ch) -> size_t
+  {
+    if((ch == '"') || (ch == '\\')) return 2U;
+    if((unsigned char) ch < 0x20U) return 6U;
+    return 1U;
+  }
+
+  /// String as JSON value; escaped value longer max_size cut from begin
+  auto json_str(std::string_view val, const size_t & max_size) -> std::string
+  {
+    size_t escaped_size = 0U;
+    size_t pos = val.size();
+    while((pos > 0U) &&
+          (escaped_size + json_char_size(val[pos - 1U]) <= max_size))
+    {
+      escaped_size += json_char_size(val[--pos]);
+    }
+
+    std::string ret{"\""};
+    if(pos > 0U)
+    {
+      ret.append("...");
+      val.remove_prefix(pos);
+    }
+
+    for(auto ch : val)
+    {
+      if((ch == '"') || (ch == '\\'))
+      {
+        ret.push_back('\\');
+        ret.push_back(ch);
+      }
+      else
+      if((unsigned char) ch < 0x20U)
+      {
+        constexpr std::string_view hex{"0123456789abcdef"};
+        ret.append("\\u00");
+        ret.push_back(hex[(ch >> 4U) & 0x0FU]);
+        ret.push_back(hex[ch & 0x0FU]);
+      }
+      else
+      {
+        ret.push_back(ch);
+      }
+    }
+
+    return ret.append("\"");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::flight_record(
+    FlightDir dir,
+    const Clock::time_point & time,
+    const uint16_t & opcode,
+    const uint16_t & field,
+    const size_t & size)
+{
+  flight_[flight_count_ % flight_.size()] = FlightEvent{
+      (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+          time - request_time_).count(),
+      (uint32_t) size,
+      opcode,
+      field,
+      dir,
+      stat_.load(std::memory_order_relaxed)};
+
+  ++flight_count_;
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::flight_dump(std::string_view reason, LogLvl lvl)
+{
+  flight_dumped_ = true;
 
+  if(!is_log_enabled(lvl)) return;
+
+  static constexpr std::array<std::string_view, 4U> dir_names{
+      "tx", "rx", "alien rx", "timeout"};
+
+  size_t count = std::min(flight_count_, flight_.size());
+  log(lvl, CURR_MSG("Flight recorder ("+std::string{reason}+"): last "+
+                    std::to_string(count)+" of "+std::to_string(flight_count_)+
+                    " packet events"));
+
+  for(size_t iter = flight_count_ - count; iter < flight_count_; ++iter)
+  {
+    const auto & ev = flight_[iter % flight_.size()];
+    std::string msg{"  +"+std::to_string(ev.time_us)+" us "};
+    msg.append(dir_names[(size_t) ev.dir]);
+    if(ev.dir != FlightDir::timeout)
+    {
+      msg.append(" ").append(pkt::to_string((pkt::Op) ev.opcode)).
+          append(" #").append(std::to_string(ev.field)).
+          append(" [").append(std::to_string(ev.size)).append(" octets]");
+    }
+    msg.append("; state ").append(to_string(ev.state));
+    log(lvl, CURR_MSG(msg));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+auto Session::stop_dump_level() -> LogLvl
+{
+  uint16_t err_code;
+  {
+    std::lock_guard lk{error_mutex_};
+    err_code = error_code_;
+  }
+
+  // Abnormal stop (timeout, cancel, internal error) - warning;
+  // usual protocol ERROR reply (file not found, ...) - debug only
+  return (summary_.timed_out || (err_code == 0U)) ?
+      LogLvl::warning : LogLvl::debug;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Session::summary_record(const size_t & max_size) -> std::string
+{
+  auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - summary_.start).count();
+
+  uint64_t goodput = duration_us > 0 ?
+      summary_.data_bytes * 1000000U / (uint64_t) duration_us : 0U;
+
+  std::string result{"ok"};
+  if(was_error()) result = "error";
+  else
+  if(summary_.timed_out) result = "timeout";
+
+  std::string err_msg;
+  uint16_t err_code;
+  {
+    std::lock_guard lk{error_mutex_};
+    err_code = error_code_;
+    err_msg = error_message_;
+  }
+
+  auto num = [](const auto & val) { return std::to_string(val); };
+
+  auto record = [&](const size_t & name_size) -> std::string
+  {
+    return "{\"client\":"+json_str(cl_addr_.str(), name_size)+
+        ",\"op\":\""+(opt_.request_type() == SrvReq::write ? "wrq" : "rrq")+"\""+
+        ",\"file\":"+json_str(opt_.filename(), name_size)+
+        ",\"path\":"+json_str(file_man_ ? file_man_->path() : "", name_size)+
+        ",\"bytes\":"+num(summary_.data_bytes)+
+        ",\"blocks\":"+num(summary_.blocks)+
+        ",\"blksize\":"+num(block_size())+
+        ",\"windowsize\":"+num(windowsize())+
+        ",\"wire_bytes\":"+num(summary_.wire_bytes)+
+        ",\"duration_ms\":"+num(duration_us / 1000)+
+        ",\"goodput_bps\":"+num(goodput)+
+        ",\"retransmits\":"+num(summary_.retransmits)+
+        ",\"rtt_us\":{\"min\":"+num(summary_.rtt_min_us)+
+        ",\"avg\":"+num(summary_.rtt_count ?
+                         summary_.rtt_sum_us / summary_.rtt_count : 0U)+
+        ",\"max\":"+num(summary_.rtt_max_us)+
+        ",\"samples\":"+num(summary_.rtt_count)+"}"+
+        ",\"result\":\""+result+"\""+
+        ",\"error_code\":"+num(err_code)+
+        ",\"error_msg\":"+json_str(err_msg, name_size)+"}";
+  };
+
+  // Names shortened while record not fit (4 names in record)
+  size_t name_size = constants::summary_max_name_size;
+  std::string ret = record(name_size);
+  while((ret.size() > max_size) && (name_size > 0U))
+  {
+    name_size -= std::min(name_size, (ret.size() - max_size + 3U) / 4U);
+    ret = record(name_size);
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+void Session::summary_write()
+{
+  if(auto writer = get_transfer_log(); writer)
+  {
+    writer->push(LogLvl::info, summary_record());
+  }
+  else
+  {
+    L_INF("Transfer summary "+summary_record());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
@@ -15,19 +15,36 @@
 #ifndef SOURCE_TFTP_SESSION_H_
 #define SOURCE_TFTP_SESSION_H_
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
 
 #include "tftpCommon.h"
 #include "tftpBase.h"
 #include "tftpDataMgr.h"
 #include "tftpOptions.h"
 #include "tftpAddr.h"
+#include "tftpSmBufView.h"
 
 namespace tftp
 {
 
 // -----------------------------------------------------------------------------
 
+namespace constants
+{
+  /// Maximum size of escaped names in transfer summary record (longer cut
+  /// from begin; shortened more if record not fit to log ring message)
+  constexpr size_t summary_max_name_size = 48U;
+
+  /// Count of last packet events kept by flight recorder of session
+  constexpr size_t flight_recorder_size = 32U;
+}
+
+// -----------------------------------------------------------------------------
+
 /**
  * \brief TFTP session class 'tftp::Session'
  *
@@ -52,8 +69,77 @@ protected:
   //DataMgr            manager_;       ///< Data manager
   uint16_t           error_code_;    ///< First error info - code
   std::string        error_message_; ///< First error info - message
+  std::mutex         error_mutex_;   ///< Mutex for error info
   Options            opt_;           ///< TFTP protocol options
   pDataMgr           file_man_;
+  std::vector<SmBufEx> window_;      ///< Prepared data packets of window
+  size_t             window_stage_;  ///< Full number of first block in window_
+  size_t             window_count_;  ///< Count of prepared packets in window_
+  std::vector<SmBufEx> window_next_; ///< Data packets of next window
+  size_t             window_next_stage_; ///< Full number of first block in window_next_
+  size_t             window_next_count_; ///< Count of packets in window_next_
+  std::future<ssize_t> read_ahead_;  ///< Result of read-ahead next window
+  size_t             gap_stage_;     ///< Expected block when lost DATA detected
+  bool               gap_ack_;       ///< Flag: need ACK of last received block
+
+  using Clock = std::chrono::steady_clock;
+
+  /// Statistic of transfer for summary record
+  struct Summary
+  {
+    Clock::time_point start;       ///< Time of session run
+    size_t            data_bytes;  ///< Size of file data transferred
+    size_t            blocks;      ///< Count of data blocks
+    size_t            wire_bytes;  ///< Size of all sent and received packets
+    size_t            retransmits; ///< Count of retransmits
+    bool              timed_out;   ///< Flag: retransmit count exceeded
+    size_t            rtt_count;   ///< Count of round-trip time samples
+    uint64_t          rtt_sum_us;  ///< Sum of round-trip times
+    uint64_t          rtt_min_us;  ///< Minimum round-trip time
+    uint64_t          rtt_max_us;  ///< Maximum round-trip time
+    Clock::time_point last_tx;     ///< Time of last packet send
+    Clock::time_point rtt_start;   ///< Time when reply waiting started
+    bool              rtt_wait;    ///< Flag: reply waiting
+    bool              rtt_skip;    ///< Flag: skip sample after retransmit
+    bool              replied;     ///< Flag: first reply to request sent
+  };
+
+  Summary summary_; ///< Statistic of transfer
+
+  Clock::time_point request_time_; ///< Time of request receive (prepare)
+
+  uint64_t id_; ///< Unique session id (for tracepoints and control)
+
+  std::atomic<size_t> progress_bytes_;  ///< Data transferred (for snapshot)
+  std::atomic<size_t> progress_blocks_; ///< Blocks transferred (for snapshot)
+  std::atomic_bool    cancel_;          ///< Flag: cancel requested
+
+  /// Kind of flight recorder event
+  enum class FlightDir: uint8_t
+  {
+    tx,      ///< Packet sent
+    rx,      ///< Packet received from client
+    alien,   ///< Packet received from other address
+    timeout, ///< Reply waiting timeout
+  };
+
+  /// Event of flight recorder
+  struct FlightEvent
+  {
+    uint64_t  time_us; ///< Time from request
+    uint32_t  size;    ///< Size of packet
+    uint16_t  opcode;  ///< Opcode of packet
+    uint16_t  field;   ///< Block number or error code
+    FlightDir dir;     ///< Kind of event
+    State     state;   ///< State of session
+  };
+
+  /// Ring of last packet events (dumped to log on error)
+  std::array<FlightEvent, constants::flight_recorder_size> flight_;
+
+  size_t flight_count_; ///< Count of recorded events (ring position)
+
+  bool flight_dumped_; ///< Flag: ring dumped (intrusion dumped once)
 
   /** \brief Main constructor
    *
@@ -65,26 +151,69 @@ protected:
    *
    *  \param [in,out] buf Buffer for data packet
    */
-  void construct_opt_reply(SmBufEx & buf);
+  void construct_opt_reply(SmBufView & buf);
 
   /** \brief Construct error block
    *
    *  Default use: code=0, message="Undefined error"
    *  \param [in,out] buf Buffer for data packet
    */
-  void construct_error(SmBufEx & buf);
+  void construct_error(SmBufView & buf);
+
+  /** \brief Prepare headers of window packets and slots for data
+   *
+   *  Packets from first block to end of window
+   *  (count limited by max_window_read_size)
+   *  \param [in,out] pkts Packets of window
+   *  \param [in] first_stage Full number of first block
+   *  \return Slots for data of blocks
+   */
+  auto window_slots(
+      std::vector<SmBufEx> & pkts,
+      const size_t & first_stage) -> std::vector<BlkSlot>;
+
+  /** \brief Set size of window packets by size of read data
+   *
+   *  \param [in,out] pkts Packets of window
+   *  \param [in] count Count of packets
+   *  \param [in] data_size Size of read data of all packets
+   */
+  void window_sizes(
+      std::vector<SmBufEx> & pkts,
+      const size_t & count,
+      size_t data_size);
+
+  /** \brief Construct data packets of window
+   *
+   *  Use window prepared by read-ahead if exist, else read data of blocks
+   *  from current block to end of window by one call of data manager.
+   *  Then start read-ahead of next window.
+   */
+  void construct_window();
+
+  /** \brief Start read-ahead of next window if need
+   *
+   *  \param [in] data_size Size of read data of current window
+   */
+  void read_ahead_start(const size_t & data_size);
+
+  /** \brief Wait finish of read-ahead if started
+   */
+  void read_ahead_wait();
 
   /** \brief Construct data block
    *
-   *  \param [in,out] buf Buffer for data packet
+   *  Get packet of current block from prepared window; if not prepared,
+   *  then construct window
+   *  \return Buffer with data packet
    */
-  void construct_data(SmBufEx & buf);
+  auto construct_data() -> const SmBufEx &;
 
   /** \brief Construct data block acknowledge
    *
    *  \param [in,out] buf Buffer for data packet
    */
-  void construct_ack(SmBufEx & buf);
+  void construct_ack(SmBufView & buf);
 
   /** \brief Get tftp block size
    *
@@ -121,19 +250,35 @@ protected:
    */
   bool was_error();
 
-  /** \brief Try to receive packet if need
+  /** \brief Try to transmit packet data
+   *
+   *  No wait - not blocking.
+   *  \param [in] data Begin of packet data
+   *  \param [in] data_size Size of packet data
+   *  \return True if continue loop, False for break loop
+   */
+  bool transmit_no_wait(const char * data, const size_t & data_size);
+
+  /** \brief Try to transmit packet if need
    *
    *  No wait - not blocking.
    *  \return True if continue loop, False for break loop
    */
   bool transmit_no_wait(const SmBufEx & buf);
 
+  /** \brief Try to transmit packet from view if need
+   *
+   *  No wait - not blocking.
+   *  \return True if continue loop, False for break loop
+   */
+  bool transmit_no_wait(const SmBufView & buf);
+
   /** \brief Try to receive packet if exist
    *
    *  No wait - not blocking.
    *  \return True if continue loop, False for break loop
    */
-  auto receive_no_wait(SmBufEx & buf) -> TripleResult;
+  auto receive_no_wait(SmBufView & buf) -> TripleResult;
 
   /** \brief Switch state machine no new state
    *
@@ -160,6 +305,64 @@ protected:
    */
   auto windowsize() const -> size_t;
 
+  /** \brief Account transferred data block
+   *
+   *  \param [in] data_size Size of data in block
+   */
+  void summary_block(const size_t & data_size);
+
+  /** \brief Start wait reply for round-trip time sample
+   */
+  void summary_rtt_begin();
+
+  /** \brief Reply received; account round-trip time sample
+   */
+  void summary_rtt_end();
+
+  /** \brief Record packet event to flight recorder
+   *
+   *  \param [in] dir Kind of event
+   *  \param [in] time Time of event
+   *  \param [in] opcode Opcode of packet
+   *  \param [in] field Block number or error code
+   *  \param [in] size Size of packet
+   */
+  void flight_record(
+      FlightDir dir,
+      const Clock::time_point & time,
+      const uint16_t & opcode = 0U,
+      const uint16_t & field = 0U,
+      const size_t & size = 0U);
+
+  /** \brief Write events of flight recorder to log
+   *
+   *  \param [in] reason Reason of dump
+   *  \param [in] lvl Level of log messages
+   */
+  void flight_dump(std::string_view reason, LogLvl lvl = LogLvl::warning);
+
+  /** \brief Get level of flight recorder dump when session stopped by error
+   *
+   *  \return Warning for timeout, cancel and internal errors (code 0);
+   *          debug for protocol ERROR replies (file not found, ...)
+   */
+  auto stop_dump_level() -> LogLvl;
+
+  /** \brief Make transfer summary record
+   *
+   *  Names (escaped) shortened if record longer max_size
+   *  \param [in] max_size Maximum size of record (fit to log ring message)
+   *  \return Record as JSON object in one line
+   */
+  auto summary_record(
+      const size_t & max_size = constants::log_ring_msg_size - 1U) -> std::string;
+
+  /** \brief Write transfer summary record
+   *
+   *  To transfer log if used, else to syslog
+   */
+  void summary_write();
+
 public:
 
   /** \brief Default Constructor
@@ -222,6 +425,39 @@ public:
    */
   bool is_finished() const;
 
+  /** \brief Get unique session id
+   *
+   *  Assigned in prepare()
+   *  \return Session id (0 if not prepared)
+   */
+  auto id() const -> uint64_t;
+
+  /// State of session for inspection from other thread
+  struct Snapshot
+  {
+    uint64_t    id;         ///< Session id
+    std::string client;     ///< Client address
+    SrvReq      request;    ///< Request type
+    std::string filename;   ///< Requested file
+    State       state;      ///< State machine
+    size_t      bytes;      ///< Data transferred
+    size_t      blocks;     ///< Blocks transferred
+    uint64_t    elapsed_us; ///< Time from request
+  };
+
+  /** \brief Get state of session
+   *
+   *  Safe use from other thread (no locks; session thread not slowed)
+   *  \return Snapshot
+   */
+  auto snapshot() const -> Snapshot;
+
+  /** \brief Request cancel session
+   *
+   *  Session send ERROR to client and finish. Safe use from other thread
+   */
+  void cancel();
+
 };
 
 // -----------------------------------------------------------------------------
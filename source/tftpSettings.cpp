@@ -13,9 +13,13 @@
  */
 
 #include <getopt.h>
+#include <limits.h>
+#include <stdlib.h>
 #include <syslog.h>
+#include <array>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-#include <regex>
 
 #include "tftpSettings.h"
 
@@ -26,7 +30,14 @@ namespace tftp
 
 auto Settings::create() -> pSettings
 {
-  return std::make_shared<Settings>(Settings{});
+  return pSettings{new Settings}; // constructor protected, no temporary copy
+}
+
+//------------------------------------------------------------------------------
+
+auto Settings::create(const Settings & src) -> pSettings
+{
+  return std::make_shared<Settings>(src);
 }
 
 //------------------------------------------------------------------------------
@@ -45,10 +56,29 @@ Settings::Settings():
   dialect{constants::default_fb_dialect},
   use_syslog{constants::default_tftp_syslog_lvl},
   log_{nullptr},
+  log_async{true},
+  log_writer_{nullptr},
   retransmit_count_{constants::default_retransmit_count},
   file_chown_user{},
   file_chown_grp{},
-  file_chmod{constants::default_file_chmod}
+  file_chmod{constants::default_file_chmod},
+  use_mmap{false},
+  lookup_cache_size{constants::default_lookup_cache_size},
+  lookup_cache_ttl{constants::default_lookup_cache_ttl},
+  lookup_cache_{nullptr},
+  read_ahead_threads{constants::default_read_ahead_threads},
+  read_ahead_{nullptr},
+  block_cache_size{constants::default_block_cache_size},
+  block_cache_{nullptr},
+  preload_manifest{},
+  preload_{nullptr},
+  use_huge_pages{false},
+  metrics_listen{},
+  control_path{},
+  transfer_log{},
+  transfer_log_{nullptr},
+  config_file{},
+  cmd_args{}
 {
   local_base_.set_family(AF_INET);
   local_base_.set_port(constants::default_tftp_port);
@@ -63,6 +93,86 @@ Settings::~Settings()
 //------------------------------------------------------------------------------
 
 bool Settings::load_options(int argc, char * argv[])
+{
+  return load_options(VecStr{argv, argv + argc});
+}
+
+//------------------------------------------------------------------------------
+
+bool Settings::load_options(const VecStr & args)
+{
+  cmd_args = args;
+
+  bool ret = parse_options(args);
+
+  // Configuration file options first, then command line options again
+  if(ret && config_file.size())
+  {
+    auto [file_ok, file_args] = read_config_file(config_file);
+    ret = file_ok;
+    if(ret)
+    {
+      VecStr all_args{args.size() ? args[0U] : std::string{}};
+      all_args.insert(all_args.end(), file_args.begin(), file_args.end());
+      if(args.size())
+      {
+        all_args.insert(all_args.end(), args.begin() + 1, args.end());
+      }
+
+      auto curr_config = config_file;
+      ret = parse_options(all_args);
+      config_file = curr_config; // no nested configuration files
+    }
+  }
+
+  // New cache with actual limits
+  lookup_cache_ = std::make_shared<LookupCache>(
+      lookup_cache_size,
+      lookup_cache_ttl);
+
+  // New read-ahead with actual count of threads
+  read_ahead_ = std::make_shared<ReadAhead>(read_ahead_threads);
+
+  // New block cache with actual memory budget
+  block_cache_ = std::make_shared<BlockCache>(block_cache_size);
+
+  // New storage of preloaded files if need
+  // (no storage - no lookup of preloaded image on each read request)
+  preload_.reset();
+  if(preload_manifest.size()) preload_ = std::make_shared<Preload>();
+
+  // Asynchronous syslog writer if need
+  log_writer_.reset();
+  if(log_async) log_writer_ = std::make_shared<LogWriter>();
+
+  // Writer of transfer summary records if need
+  // (file not opened - options not loaded; records never lost silently)
+  transfer_log_.reset();
+  if(transfer_log.size())
+  {
+    auto writer = std::make_shared<LogFileWriter>(transfer_log);
+    int err = errno;
+    if(writer->is_open())
+    {
+      transfer_log_ = writer;
+    }
+    else
+    {
+      std::array<char, 256U> err_buf{};
+      std::string msg{"Can't open transfer log '"+transfer_log+"': "+
+                      strerror_r(err, err_buf.data(), err_buf.size())};
+      syslog(LOG_ERR, "%s", msg.c_str());
+      std::cerr << msg << std::endl;
+      ret = false;
+    }
+  }
+
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+
+bool Settings::parse_options(const VecStr & args)
 {
   bool ret = true;
 
@@ -88,16 +198,36 @@ bool Settings::load_options(int argc, char * argv[])
       { "file-chuser",required_argument, NULL,  0  }, // 15
       { "file-chgrp", required_argument, NULL,  0  }, // 16
       { "file-chmod", required_argument, NULL,  0  }, // 17
+      { "lookup-cache",required_argument,NULL,  0  }, // 18
+      { "lookup-ttl", required_argument, NULL,  0  }, // 19
+      { "no-mmap",          no_argument, NULL,  0  }, // 20
+      { "read-ahead", required_argument, NULL,  0  }, // 21
+      { "block-cache",required_argument, NULL,  0  }, // 22
+      { "preload",    required_argument, NULL,  0  }, // 23
+      { "huge-pages",       no_argument, NULL,  0  }, // 24
+      { "log-sync",         no_argument, NULL,  0  }, // 25
+      { "config",     required_argument, NULL,  0  }, // 26
+      { "metrics",    required_argument, NULL,  0  }, // 27
+      { "transfer-log",required_argument,NULL,  0  }, // 28
+      { "control",    required_argument, NULL,  0  }, // 29
+      { "mmap",             no_argument, NULL,  0  }, // 30
       { NULL,               no_argument, NULL,  0  }  // always last
   };
 
   backup_dirs.clear();
 
+  // getopt need modifiable array
+  VecStr args_copy{args};
+  std::vector<char *> argv;
+  for(auto & arg : args_copy) argv.push_back(arg.data());
+  argv.push_back(nullptr);
+  int argc = (int) args_copy.size();
+
   optind=1;
   while(argc > 1)
   {
     int longIndex;
-    int opt = getopt_long(argc, argv, optString, longOpts, & longIndex);
+    int opt = getopt_long(argc, argv.data(), optString, longOpts, & longIndex);
     if(opt == -1) break; // end parsing
     switch(opt)
     {
@@ -187,6 +317,90 @@ bool Settings::load_options(int argc, char * argv[])
           file_chmod = std::stoi(tmp_str, pos, 8);
         }
         break;
+      case 18: // --lookup-cache
+        if(optarg)
+        {
+          try
+          {
+            lookup_cache_size = std::stoul(optarg);
+          } catch (...) { };
+        }
+        break;
+      case 19: // --lookup-ttl
+        if(optarg)
+        {
+          try
+          {
+            lookup_cache_ttl = std::stoi(optarg);
+          } catch (...) { };
+        }
+        break;
+      case 20: // --no-mmap
+        use_mmap = false;
+        break;
+      case 21: // --read-ahead
+        if(optarg)
+        {
+          try
+          {
+            read_ahead_threads = std::stoul(optarg);
+          } catch (...) { };
+        }
+        break;
+      case 22: // --block-cache
+        if(optarg)
+        {
+          try
+          {
+            block_cache_size = std::stoul(optarg) * 1024U * 1024U;
+          } catch (...) { };
+        }
+        break;
+      case 23: // --preload
+        if(optarg) preload_manifest.assign(optarg);
+        break;
+      case 24: // --huge-pages
+        use_huge_pages = true;
+        break;
+      case 25: // --log-sync
+        log_async = false;
+        break;
+      case 26: // --config
+        if(optarg)
+        {
+          // Absolute path - working directory changed for daemon
+          char full_path[PATH_MAX];
+          config_file.assign(realpath(optarg, full_path) ? full_path : optarg);
+        }
+        break;
+      case 27: // --metrics
+        if(optarg) metrics_listen.assign(optarg);
+        break;
+      case 28: // --transfer-log
+        if(optarg) transfer_log.assign(optarg);
+        break;
+      case 29: // --control
+        if(optarg)
+        {
+          // Absolute path - working directory changed for daemon
+          // (socket file not exist yet - resolve directory)
+          std::string path{optarg};
+          size_t slash = path.rfind('/');
+          std::string dir{slash == std::string::npos ? "." :
+                          (slash ? path.substr(0U, slash) : "/")};
+          char full_path[PATH_MAX];
+          if(realpath(dir.c_str(), full_path))
+          {
+            std::string full{full_path};
+            if(full.back() != '/') full.push_back('/');
+            path = full + path.substr(slash == std::string::npos ? 0U : slash + 1U);
+          }
+          control_path.assign(path);
+        }
+        break;
+      case 30: // --mmap
+        use_mmap = true;
+        break;
 
       } // case (for long option)
       break;
@@ -198,6 +412,46 @@ bool Settings::load_options(int argc, char * argv[])
 
 //------------------------------------------------------------------------------
 
+auto Settings::adopt(const Settings & prev) -> VecStr
+{
+  VecStr ret;
+
+  if(local_base_.str() != prev.local_base_.str()) ret.emplace_back("listen");
+  if(is_daemon != prev.is_daemon) ret.emplace_back("daemon");
+  if(use_huge_pages != prev.use_huge_pages) ret.emplace_back("huge-pages");
+  if(log_async != prev.log_async) ret.emplace_back("log-sync");
+  if(metrics_listen != prev.metrics_listen) ret.emplace_back("metrics");
+  if(control_path != prev.control_path) ret.emplace_back("control");
+
+  local_base_    = prev.local_base_;
+  is_daemon      = prev.is_daemon;
+  use_huge_pages = prev.use_huge_pages;
+  log_async      = prev.log_async;
+  metrics_listen = prev.metrics_listen;
+  control_path   = prev.control_path;
+  log_writer_    = prev.log_writer_;
+  log_           = prev.log_;
+
+  if(read_ahead_threads == prev.read_ahead_threads)
+  {
+    read_ahead_ = prev.read_ahead_;
+  }
+
+  if(block_cache_size == prev.block_cache_size)
+  {
+    block_cache_ = prev.block_cache_;
+  }
+
+  if(transfer_log == prev.transfer_log)
+  {
+    transfer_log_ = prev.transfer_log_;
+  }
+
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+
 void Settings::out_help(std::ostream & stream, std::string_view app) const
 {
   out_id(stream);
@@ -228,7 +482,24 @@ void Settings::out_help(std::ostream & stream, std::string_view app) const
   << "  --file-chgrp <group name> Set group owner for created files (default root)" << std::endl
   << "    Warning: if user/group not exist then use root" << std::endl
   << "  --file-chmod <permissions> Set permissions for created files (default 0664)" << std::endl
-  << "    Warning: can set only r/w bits - maximum 0666; can't set x-bits and superbits" << std::endl;
+  << "    Warning: can set only r/w bits - maximum 0666; can't set x-bits and superbits" << std::endl
+  << "  --lookup-cache <N> Maximum count of cached file name lookups; 0 - disable (default " << constants::default_lookup_cache_size << ")" << std::endl
+  << "  --lookup-ttl <seconds> Time to live of cached file name lookup (default " << constants::default_lookup_cache_ttl << ")" << std::endl
+  << "  --mmap Read files via memory mapping instead of file streams" << std::endl
+  << "    Warning: truncate of served file while reading crash server (SIGBUS)" << std::endl
+  << "  --no-mmap Read files via file streams (default)" << std::endl
+  << "  --read-ahead <N> Count of I/O threads for read-ahead next window; 0 - disable (default " << constants::default_read_ahead_threads << ")" << std::endl
+  << "  --block-cache <MiB> Memory budget of files data cache; 0 - disable (default " << constants::default_block_cache_size / (1024U * 1024U) << ")" << std::endl
+  << "    Note: if enabled, then read files via cache instead of memory mapping" << std::endl
+  << "  --preload <file> Manifest of files (md5 sum, name or path per line) loaded to locked memory at start" << std::endl
+  << "  --huge-pages Allocate packet buffers and cached blocks from huge pages arena" << std::endl
+  << "  --log-sync Write syslog messages directly from session threads (default - by writer thread)" << std::endl
+  << "  --config <file> Configuration file with long options (\"name value\" per line); re-read with command line options on SIGHUP" << std::endl
+  << "    Note: listen address, daemon, huge pages, log mode, metrics endpoint and control socket changed only by restart" << std::endl
+  << "  --metrics {<IPv4>|[<IPv6>]}:port|<socket path> Export metrics in Prometheus text format by HTTP (path - Unix socket)" << std::endl
+  << "  --transfer-log <file> Write summary record (JSON line) of every transfer to file (default - to syslog)" << std::endl
+  << "    Warning: if file can't be opened then options not loaded (server not started or not reloaded)" << std::endl
+  << "  --control <socket path> Unix socket for administration (list/kill sessions, drain, metrics); use server-fw-ctl" << std::endl;
 }
 
 // -----------------------------------------------------------------------------
@@ -241,4 +512,39 @@ void Settings::out_id(std::ostream & stream) const
 
 // -----------------------------------------------------------------------------
 
+auto read_config_file(const std::string & path)
+    -> std::tuple<bool, VecStr>
+{
+  VecStr ret;
+
+  std::ifstream config{path, std::ios_base::in};
+  if(!config.is_open()) return {false, ret};
+
+  std::string line;
+  while(std::getline(config, line))
+  {
+    // Trim spaces
+    auto begin = line.find_first_not_of(" \t\r");
+    if(begin == std::string::npos) continue;
+    auto end = line.find_last_not_of(" \t\r");
+
+    if(line[begin] == '#') continue;
+
+    line = line.substr(begin, end - begin + 1U);
+    if(line.compare(0U, 2U, "--") == 0) line.erase(0U, 2U);
+
+    // Split name and value
+    auto name_end = line.find_first_of(" \t=");
+    ret.push_back("--"+line.substr(0U, name_end));
+    if(name_end == std::string::npos) continue;
+
+    auto value_begin = line.find_first_not_of(" \t=", name_end);
+    if(value_begin != std::string::npos) ret.push_back(line.substr(value_begin));
+  }
+
+  return {true, ret};
+}
+
+// -----------------------------------------------------------------------------
+
 } // namespace tftp
@@ -17,6 +17,11 @@
 
 #include "tftpCommon.h"
 #include "tftpAddr.h"
+#include "tftpLookupCache.h"
+#include "tftpReadAhead.h"
+#include "tftpBlockCache.h"
+#include "tftpPreload.h"
+#include "tftpLogRing.h"
 
 
 namespace tftp
@@ -44,6 +49,8 @@ namespace constants
  *  Class for store server settings.
  *  Can't simple construct - make it shareable
  *  Create only from Settings::create() as shared pointer
+ *  Published instance is immutable snapshot (read without locks);
+ *  for change make copy by Settings::create(src), modify and publish it.
  */
 
 class Settings: public std::enable_shared_from_this<Settings>
@@ -72,6 +79,8 @@ public:
   //logger
   int use_syslog; ///< Syslog pass level logging message
   fLogMsg log_;   ///< External callback for logging message
+  bool log_async; ///< Flag: syslog written by writer thread (not blocking)
+  pLogWriter log_writer_; ///< Asynchronous syslog writer (nullptr if sync or options not loaded)
 
   // protocol
   uint16_t retransmit_count_;
@@ -80,12 +89,57 @@ public:
   std::string file_chown_grp;
   int         file_chmod;
 
+  // data managers
+  bool        use_mmap; ///< Flag: read files via memory mapping
+
+  // lookup cache
+  size_t       lookup_cache_size; ///< Maximum count of cached names
+  int          lookup_cache_ttl;  ///< Time to live of cached name (seconds)
+  pLookupCache lookup_cache_;     ///< Cache of file name lookup results (nullptr if options not loaded)
+
+  // read-ahead
+  size_t     read_ahead_threads; ///< Count of read-ahead I/O threads
+  pReadAhead read_ahead_;        ///< Read-ahead I/O threads (nullptr if options not loaded)
+
+  // block cache
+  size_t      block_cache_size; ///< Memory budget of block cache (bytes)
+  pBlockCache block_cache_;     ///< Cache of files data (nullptr if options not loaded)
+
+  // preload
+  std::string preload_manifest; ///< Manifest of files loaded at start
+  pPreload    preload_;         ///< Preloaded files (nullptr if no manifest)
+
+  // memory arena
+  bool        use_huge_pages; ///< Flag: buffers from huge pages arena
+
+  // metrics
+  std::string metrics_listen; ///< Metrics endpoint ("ip:port" or socket path)
+
+  // administration
+  std::string control_path; ///< Control Unix socket path (empty if disabled)
+
+  // transfer summary
+  std::string transfer_log;  ///< File of transfer summary records (JSON lines)
+  pLogWriter  transfer_log_; ///< Writer of transfer summary records (nullptr if syslog)
+
+  // reload
+  std::string config_file; ///< Configuration file (re-read on reload)
+  VecStr      cmd_args;    ///< Command line arguments (re-parsed on reload)
+
   /** \brief Public creator
    *
    *  \return Shared pointer to this class
    */
   static auto create() -> pSettings;
 
+  /** \brief Public creator of copy
+   *
+   *  Use for make new snapshot of settings
+   *  \param [in] src Source settings
+   *  \return Shared pointer to this class
+   */
+  static auto create(const Settings & src) -> pSettings;
+
   /** \brief Destructor
    */
   virtual ~Settings();
@@ -98,14 +152,58 @@ public:
    */
   bool load_options(int argc, char * argv[]);
 
+  /** \brief Load settings from arguments and configuration file
+   *
+   *  Options from configuration file (--config) parsed before command line
+   *  options; command line options win
+   *  \param [in] args Arguments (first is application name)
+   *  \return True if success, else - false
+   */
+  bool load_options(const VecStr & args);
+
+  /** \brief Take over state of running settings
+   *
+   *  Use for new snapshot made by reload. Options which can't change
+   *  without restart (listen address, daemon, huge pages, log mode,
+   *  metrics endpoint, control socket) are
+   *  restored from running settings; loggers and runtime objects with
+   *  unchanged parameters (read-ahead, block cache, transfer log) are
+   *  shared.
+   *  \param [in] prev Running settings
+   *  \return Names of changed options ignored until restart
+   */
+  auto adopt(const Settings & prev) -> VecStr;
+
   void out_id(std::ostream & stream) const;
 
   void out_help(std::ostream & stream, std::string_view app) const;
 
+protected:
+
+  /** \brief Parse arguments without make runtime objects
+   *
+   *  \param [in] args Arguments (first is application name)
+   *  \return True if success, else - false
+   */
+  bool parse_options(const VecStr & args);
+
 };
 
 // -----------------------------------------------------------------------------
 
+/** \brief Read configuration file
+ *
+ *  One long option per line as "name value" or "name=value" (name without
+ *  leading "--"; value not need for flags); empty lines and lines started
+ *  with '#' are skipped
+ *  \param [in] path Path to configuration file
+ *  \return Tuple<success read; arguments as for command line>
+ */
+auto read_config_file(const std::string & path)
+    -> std::tuple<bool, VecStr>;
+
+// -----------------------------------------------------------------------------
+
 } // namespace tftp
 
 #endif /* SOURCE_TFTPSETTINGS_H_ */
@@ -0,0 +1,715 @@
+/**
+ * \file tftpSmBufAccess.h
+ * \brief Smart buffer accessors header
+ *
+ *  Common get/set/push methods of SmBuf, SmBufEx and SmBufView
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPSMBUFACCESS_H_
+#define SOURCE_TFTPSMBUFACCESS_H_
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "tftpCommon.h"
+
+namespace tftp
+{
+
+//------------------------------------------------------------------------------
+
+namespace constants
+{
+  constexpr bool default_buf_int_bigendian = true;
+  constexpr bool default_buf_str_zeroend = true;
+}
+
+//------------------------------------------------------------------------------
+
+/** \brief Get/set values of buffer memory
+ *
+ *  Support get/set intergral type (hton/nton/raw) and string
+ *  Need manipulate with offset (start data position)
+ *  Memory of buffer is Derived::data() with size Derived::size()
+ */
+template<typename Derived>
+class SmBufAccess
+{
+protected:
+
+  /** \brief Get buffer memory owner
+   *
+   *  \return Reference to derived object
+   */
+  auto self() noexcept -> Derived & { return static_cast<Derived &>(*this); }
+
+  /** \brief Get buffer memory owner
+   *
+   *  \return Const reference to derived object
+   */
+  auto self() const noexcept -> const Derived &
+  {
+    return static_cast<const Derived &>(*this);
+  }
+
+  /** \brief Check offset + data size with buffer size
+   *
+   *  If check wrong throw exception "invalid_argument"
+   *  \param [in] point Place of action (__PRETTY_FUNCTION)
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \param [in] t_size Data size
+   */
+  void check_offset(
+      std::string_view point,
+      const size_t & offset,
+      const size_t & t_size) const;
+
+  /** \brief Check offset + data sizeof(T) with buffer size
+   *
+   *  If check wrong throw exception "invalid_argument"
+   *  \param [in] point Place of action (__PRETTY_FUNCTION)
+   *  \param [in] offset Buffer offset (position) in bytes
+   */
+  template<typename T>
+  void check_offset_type(
+      std::string_view point,
+      const size_t & offset) const;
+
+public:
+
+  /** \brief Check offset and data size with buffer size
+   *
+   *  Result false if offset out of buffer (with data length is 0)
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \param [in] t_size Data size
+   *  \return True if offset and data size valid, else - false
+   */
+  bool is_valid(const size_t & offset,
+                const size_t & t_size) const noexcept;
+
+  /** \brief Check offset and data size type T with buffer size
+   *
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \return True if offset and data size valid, else - false
+   */
+  template<typename T>
+  bool is_valid(const size_t & offset) const noexcept;
+
+  /** \brief Get raw value from buffer of given type
+   *
+   *  Warning! Repeat, offset in bytes
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \return Reference to value type of T &
+   */
+  template<typename T>
+  auto raw(const size_t & offset)
+      -> std::enable_if_t<std::is_integral_v<T>, T &>;
+
+  /** \brief Get const raw value from buffer of given type
+   *
+   *  Warning! Repeat, offset in bytes
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \return Reference to value type of const T &
+   */
+  template<typename T>
+  auto raw(const size_t & offset) const
+      -> std::enable_if_t<std::is_integral_v<T>, const T &>;
+
+  /** \brief Get big endian value from buffer as host byte order
+   *
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \return Value type of T
+   */
+  template<typename T>
+  auto get_be(const size_t & offset) const
+      -> std::enable_if_t<std::is_integral_v<T>, T>;
+
+  /** \brief Get little endian value from buffer as host byte order
+   *
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \return Value type of T
+   */
+  template<typename T>
+  auto get_le(const size_t & offset) const
+      -> std::enable_if_t<std::is_integral_v<T>, T>;
+
+  /** \brief Set value integer type to buffer as big endian
+   *
+   *  Warning: need hard control of type T
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \param [in] val Value any integer type
+   *  \return Data size passed to buffer
+   */
+  template<typename T>
+  auto set_be(const size_t & offset, const T & val)
+      -> std::enable_if_t<std::is_integral_v<T>, ssize_t>;
+
+  /** \brief Set value integer type to buffer as little endian
+   *
+   *  Warning: need hard control of type T
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \param [in] val Value any integer type
+   *  \return Data size passed to buffer
+   */
+  template<typename T>
+  auto set_le(const size_t & offset, const T & val)
+      -> std::enable_if_t<std::is_integral_v<T>, ssize_t>;
+
+  /** \brief Get string value from buffer
+   *
+   *  If buffer has 0, then string will strip from zero poition
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \param [in] buf_len Length of string (maximum)
+   *  \return String value
+   */
+  auto get_string(
+      const size_t & offset,
+      const size_t & buf_len = 0) const -> std::string;
+
+  /** \brief Write string/container data to buffer
+   *
+   *  Can use for string with smart add zero end.
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \param [in] srt String or container data
+   *  \param [in] check_zero_end Enable/disable smart end zero
+   *  \return Data size passed to buffer
+   *
+   */
+  auto set_string(
+      const size_t & offset,
+      std::string_view str,
+      bool check_zero_end = false) -> ssize_t;
+
+  /** \brief Compare string with data in buffer
+   *
+   *  \param [in] offset Buffer offset (position) in bytes
+   *  \param [in] srt String for compare data
+   *  \param [in] check_zero_end Check zero at the end of data in buffer
+   *  \return True if data string equal buffer
+   *
+   */
+  bool eqv_string(
+      const size_t & offset,
+      std::string_view str,
+      bool check_zero_end = false) const;
+};
+
+//------------------------------------------------------------------------------
+
+/** \brief Push data to buffer memory
+ *
+ *  Now support only integer values, boolean, char and string values
+ *  Calculates pushed data size (actual data size)
+ *  Can write integer as big endian (default) or little endian
+ *  Can write string with zero end (default) or without it
+ *  Values written by Derived::set_be()/set_le()/set_string()
+ */
+template<typename Derived>
+class SmBufPush
+{
+protected:
+
+  size_t data_size_; ///< Pushed to buffer data size
+
+  bool val_int_bigendian_; ///< Flag for buffer value as big endian
+
+  bool val_str_zeroend_; ///< Flag for add zero at end of string
+
+  /** \brief Constructor with flags: BE, zeroend
+   *
+   *  \param [in] is_int_be Flag BE
+   *  \param [in] is_str_zero Flag zero end string
+   */
+  SmBufPush(bool is_int_be, bool is_str_zero);
+
+  /** \brief Push single value data to buffer
+   *
+   *  Now support only integer value and string value
+   *  \param [in] val Value for write
+   *  \return True if success pushed value, else false
+   */
+  template<typename T>
+  bool push_item(T && val);
+
+public:
+
+  /** \brief get pushed data size (actual data size)
+   *
+   *  \return data size
+   */
+  auto data_size() const -> const size_t &;
+
+  /** \brief Clear data (only reset data size, no init buffer)
+   */
+  void clear();
+
+  /** \brief Set data size (for example, after receive to memory)
+   *
+   *  \param [in] new_size New data size
+   */
+  void data_size_reset(size_t new_size);
+
+  /** \brief Push data to buffer
+   *
+   *  Now support only integer values and string values
+   *  \param [in] args Variadic values to push buffer
+   *  \return True if success pushed value, else false
+   */
+  template<typename ... Ts>
+  bool push_data(Ts && ... args);
+
+  /** \brief Check flag is "big endian"
+   *
+   *  \return Value of flag
+   */
+  bool is_bigendian() const;
+
+  /** \brief Check flag is "little endian"
+   *
+   *  \return Value of flag
+   */
+  bool is_littleendian() const;
+
+  /** \brief Check flag is "zero end string"
+   *
+   *  \return Value of flag
+   */
+  bool is_zeroend() const;
+
+  /** \brief Set flag to "big endian"
+   */
+  void set_bigendian();
+
+  /** \brief Set flag to "little endian"
+   */
+  void set_littleendian();
+
+  /** \brief Set flag to "zero end string"
+   */
+  void set_zeroend();
+
+  /** \brief Set flag to "not zero at end string"
+   */
+  void set_not_zeroend();
+};
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+bool SmBufAccess<Derived>::is_valid(
+    const size_t & offset,
+    const size_t & t_size) const noexcept
+{
+  return (offset < self().size()) &&
+         (offset + t_size) <= self().size();
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+bool SmBufAccess<Derived>::is_valid(const size_t & offset) const noexcept
+{
+  return is_valid(offset, sizeof(T));
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+void SmBufAccess<Derived>::check_offset(
+    std::string_view point,
+    const size_t & offset,
+    const size_t & t_size) const
+{
+  if(!is_valid(offset, t_size))
+  {
+    throw std::invalid_argument(
+        std::string{point}+": "+
+        "Offset "+std::to_string(offset)+
+        " with type size "+std::to_string(t_size)+
+        " is over buffer size "+std::to_string(self().size()));
+  }
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+void SmBufAccess<Derived>::check_offset_type(
+    std::string_view point,
+    const size_t & offset) const
+{
+  check_offset(point, offset, sizeof(T));
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+auto SmBufAccess<Derived>::raw(const size_t & offset)
+    -> std::enable_if_t<std::is_integral_v<T>, T &>
+{
+  check_offset_type<T>(__PRETTY_FUNCTION__, offset);
+
+  return *((T *) (self().data() + offset));
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+auto SmBufAccess<Derived>::raw(const size_t & offset) const
+    -> std::enable_if_t<std::is_integral_v<T>, const T &>
+{
+  check_offset_type<T>(__PRETTY_FUNCTION__, offset);
+
+  return *((T *) (self().data() + offset));
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+auto SmBufAccess<Derived>::get_be(const size_t & offset) const
+    -> std::enable_if_t<std::is_integral_v<T>, T>
+{
+  check_offset_type<T>(__PRETTY_FUNCTION__, offset);
+
+  const char * ptr = self().data() + offset;
+  switch(sizeof(T))
+  {
+    case 1U: return (T)*ptr;
+    case 2U: return (T)be16toh(*((uint16_t*)ptr));
+    case 4U: return (T)be32toh(*((uint32_t*)ptr));
+    case 8U: return (T)be64toh(*((uint64_t*)ptr));
+    default:
+      throw std::invalid_argument(
+          "Wrong integer size ("+std::to_string(sizeof(T))+")");
+  }
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+auto SmBufAccess<Derived>::get_le(const size_t & offset) const
+    -> std::enable_if_t<std::is_integral_v<T>, T>
+{
+  check_offset_type<T>(__PRETTY_FUNCTION__, offset);
+
+  const char * ptr = self().data() + offset;
+  switch(sizeof(T))
+  {
+    case 1U: return (T)*ptr;
+    case 2U: return (T)le16toh(*((uint16_t*)ptr));
+    case 4U: return (T)le32toh(*((uint32_t*)ptr));
+    case 8U: return (T)le64toh(*((uint64_t*)ptr));
+    default:
+      throw std::invalid_argument(
+          "Wrong integer size ("+std::to_string(sizeof(T))+")");
+  }
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+auto SmBufAccess<Derived>::set_be(const size_t & offset, const T & val)
+    -> std::enable_if_t<std::is_integral_v<T>, ssize_t>
+{
+  check_offset_type<T>(__PRETTY_FUNCTION__, offset);
+
+  constexpr ssize_t t_size = (ssize_t)sizeof(T);
+
+  char * ptr = self().data() + offset;
+  switch(t_size)
+  {
+    case 1U:
+      *ptr = val;
+      break;
+    case 2U:
+      *((uint16_t*)ptr) = htobe16((uint16_t)val);
+      break;
+    case 4U:
+      *((uint32_t*)ptr) = htobe32((uint32_t)val);
+      break;
+    case 8U:
+      *((uint64_t*)ptr) = htobe64((uint64_t)val);
+      break;
+    default:
+      throw std::invalid_argument(
+          "Wrong integer size ("+std::to_string(t_size)+")");
+  }
+
+  return t_size;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+auto SmBufAccess<Derived>::set_le(const size_t & offset, const T & val)
+    -> std::enable_if_t<std::is_integral_v<T>, ssize_t>
+{
+  check_offset_type<T>(__PRETTY_FUNCTION__, offset);
+
+  constexpr ssize_t t_size = (ssize_t)sizeof(T);
+
+  char * ptr = self().data() + offset;
+  switch(t_size)
+  {
+    case 1U:
+      *ptr = val;
+      break;
+    case 2U:
+      *((uint16_t*)ptr) = htole16((uint16_t)val);
+      break;
+    case 4U:
+      *((uint32_t*)ptr) = htole32((uint32_t)val);
+      break;
+    case 8U:
+      *((uint64_t*)ptr) = htole64((uint64_t)val);
+      break;
+    default:
+      throw std::invalid_argument(
+          "Wrong integer size ("+std::to_string(t_size)+")");
+  }
+
+  return t_size;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+auto SmBufAccess<Derived>::get_string(
+    const size_t & offset,
+    const size_t & buf_len) const -> std::string
+{
+  check_offset(__PRETTY_FUNCTION__, offset, buf_len);
+
+  auto curr_beg_it = self().data()+offset;
+  auto curr_end_it = self().data()+(buf_len>0 ? offset+buf_len : self().size());
+
+  return std::string{curr_beg_it,
+                     std::find(curr_beg_it, curr_end_it, 0)};
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+auto SmBufAccess<Derived>::set_string(
+    const size_t & offset,
+    std::string_view str,
+    bool check_zero_end) -> ssize_t
+{
+  auto zero_it = (check_zero_end ?
+      std::find(str.cbegin(),
+                str.cend(),
+                0) : str.cend());
+
+  ssize_t new_size = std::distance(
+      str.cbegin(),
+      zero_it);
+
+  assert(new_size >= 0); // never do it
+
+  check_offset(
+      __PRETTY_FUNCTION__,
+      offset,
+      new_size + (check_zero_end ? 1 : 0));
+
+  std::copy(str.cbegin(), zero_it, self().data() + offset);
+
+  if(check_zero_end) self().data()[offset+new_size++] = 0; // zero end
+
+  return new_size;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+bool SmBufAccess<Derived>::eqv_string(
+    const size_t & offset,
+    std::string_view str,
+    bool check_zero_end) const
+{
+  bool ret = is_valid(offset, str.size() + (check_zero_end?1:0));
+
+  if(ret)
+  {
+    const char * ptr = self().data()+offset;
+    ret = std::equal(ptr,
+                     ptr+str.size(),
+                     str.cbegin()) &&
+          (check_zero_end ? (ptr[str.size()] == 0) : true);
+  }
+
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+SmBufPush<Derived>::SmBufPush(bool is_int_be, bool is_str_zero):
+    data_size_{0U},
+    val_int_bigendian_{is_int_be},
+    val_str_zeroend_{is_str_zero}
+{
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename T>
+bool SmBufPush<Derived>::push_item(T && val)
+{
+  bool ret = false;
+  using TT = std::decay_t<T>;
+
+  auto & buf = static_cast<Derived &>(*this);
+
+  if constexpr (std::is_integral_v<TT>)
+  {
+    if((data_size_ + sizeof(TT)) <= buf.size())
+    {
+      ssize_t len = is_bigendian() ?
+          buf.set_be(data_size_, std::forward<T>(val)):
+          buf.set_le(data_size_, std::forward<T>(val));
+      if((ret = (len >= 0)))
+      {
+        data_size_ += (size_t) len;
+      }
+    }
+  }
+  else
+  if constexpr (std::is_constructible_v<std::string_view, T>)
+  {
+    std::string_view tmp_str{val};
+
+    if((data_size_ + tmp_str.size()) <= buf.size())
+    {
+      ssize_t len=buf.set_string(data_size_, tmp_str, val_str_zeroend_);
+      if((ret = (len >= 0)))
+      {
+        data_size_ += (size_t) len;
+      }
+    }
+  }
+
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+template<typename ... Ts>
+bool SmBufPush<Derived>::push_data(Ts && ... args)
+{
+  bool ret = true;
+
+  ((ret = push_item(std::forward<Ts>(args)) && ret), ...);
+
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+auto SmBufPush<Derived>::data_size() const -> const size_t &
+{
+  return data_size_;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+void SmBufPush<Derived>::clear()
+{
+  data_size_ = 0U;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+void SmBufPush<Derived>::data_size_reset(size_t new_size)
+{
+  if(new_size > static_cast<const Derived &>(*this).size())
+  {
+    throw std::invalid_argument("Overflow buffer size when set data size");
+  }
+
+  data_size_ = new_size;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+bool SmBufPush<Derived>::is_bigendian() const
+{
+  return val_int_bigendian_;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+bool SmBufPush<Derived>::is_littleendian() const
+{
+  return !val_int_bigendian_;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+bool SmBufPush<Derived>::is_zeroend() const
+{
+  return val_str_zeroend_;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+void SmBufPush<Derived>::set_bigendian()
+{
+  val_int_bigendian_ = true;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+void SmBufPush<Derived>::set_littleendian()
+{
+  val_int_bigendian_ = false;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+void SmBufPush<Derived>::set_zeroend()
+{
+  val_str_zeroend_ = true;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename Derived>
+void SmBufPush<Derived>::set_not_zeroend()
+{
+  val_str_zeroend_ = false;
+}
+
+//------------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPSMBUFACCESS_H_ */
@@ -0,0 +1,56 @@
+/**
+ * \file tftpSmBufView.cpp
+ * \brief Smart buffer view class SmBufView module
+ *
+ *  SmBufView class for network buffer manipulation in external memory
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include "tftpSmBufView.h"
+
+namespace tftp
+{
+
+//------------------------------------------------------------------------------
+
+SmBufView::SmBufView(
+    char * data,
+    const size_t & size,
+    bool is_int_be,
+    bool is_str_zero):
+        SmBufPush<SmBufView>(is_int_be, is_str_zero),
+        data_{data},
+        size_{size}
+{
+}
+
+//------------------------------------------------------------------------------
+
+SmBufView::SmBufView(SmBuf & buf):
+    SmBufView(buf.data(), buf.size())
+{
+}
+
+//------------------------------------------------------------------------------
+
+SmBufView::SmBufView(SmBufEx & buf):
+    SmBufView(buf.data(), buf.size(), buf.is_bigendian(), buf.is_zeroend())
+{
+  data_size_ = buf.data_size();
+}
+
+//------------------------------------------------------------------------------
+
+SmBufView::~SmBufView()
+{
+}
+
+//------------------------------------------------------------------------------
+
+} // namespace tftp
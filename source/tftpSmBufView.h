@@ -0,0 +1,116 @@
+/**
+ * \file tftpSmBufView.h
+ * \brief Smart buffer view class SmBufView header
+ *
+ *  SmBufView class for network buffer manipulation in external memory
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TFTPSMBUFVIEW_H_
+#define SOURCE_TFTPSMBUFVIEW_H_
+
+#include "tftpSmBufEx.h"
+
+namespace tftp
+{
+
+//------------------------------------------------------------------------------
+
+/** \brief Smart buffer view over externally owned memory
+ *
+ *  Same get/set/push API as SmBuf and SmBufEx, but memory not allocated
+ *  and not initialised: view only point to memory owned by other object
+ *  (receive ring slot, cache page, memory mapping, SmBuf, ...).
+ *  Owner must keep memory alive while view is used.
+ */
+class SmBufView: public SmBufAccess<SmBufView>, public SmBufPush<SmBufView>
+{
+protected:
+
+  char * data_; ///< Begin of viewed memory
+  size_t size_; ///< Size of viewed memory
+
+public:
+
+  /** \brief No default constructor (need memory!)
+   */
+  SmBufView() = delete;
+
+  /** \brief Constructor with memory and flags: BE, zeroend
+   *
+   *  \param [in] data Begin of memory
+   *  \param [in] size Size of memory
+   *  \param [in] is_int_be Flag BE
+   *  \param [in] is_str_zero Flag zero end string
+   */
+  SmBufView(
+      char * data,
+      const size_t & size,
+      bool is_int_be = constants::default_buf_int_bigendian,
+      bool is_str_zero = constants::default_buf_str_zeroend);
+
+  /** \brief Constructor of view over whole SmBuf
+   *
+   *  \param [in] buf Buffer
+   */
+  SmBufView(SmBuf & buf);
+
+  /** \brief Constructor of view over whole SmBufEx (with data size and flags)
+   *
+   *  \param [in] buf Buffer
+   */
+  SmBufView(SmBufEx & buf);
+
+  /** \brief Destructor
+   */
+  virtual ~SmBufView();
+
+  /** \brief Get begin of viewed memory
+   *
+   *  \return Pointer
+   */
+  auto data() noexcept -> char * { return data_; }
+
+  /** \brief Get begin of viewed memory
+   *
+   *  \return Pointer
+   */
+  auto data() const noexcept -> const char * { return data_; }
+
+  /** \brief Get size of viewed memory
+   *
+   *  \return Size
+   */
+  auto size() const noexcept -> size_t { return size_; }
+
+  auto begin() noexcept -> char * { return data_; }
+
+  auto end() noexcept -> char * { return data_ + size_; }
+
+  auto begin() const noexcept -> const char * { return data_; }
+
+  auto end() const noexcept -> const char * { return data_ + size_; }
+
+  auto cbegin() const noexcept -> const char * { return data_; }
+
+  auto cend() const noexcept -> const char * { return data_ + size_; }
+
+  auto operator[](const size_t & pos) -> char & { return data_[pos]; }
+
+  auto operator[](const size_t & pos) const -> const char &
+  {
+    return data_[pos];
+  }
+};
+
+//------------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TFTPSMBUFVIEW_H_ */
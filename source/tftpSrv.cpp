@@ -12,12 +12,21 @@
  *  \version 0.2.1
  */
 
+#include <signal.h>
 #include <string.h>
 #include <unistd.h>
 #include <netinet/in.h>
 
+#include <algorithm>
+#include <chrono>
+
 #include "tftpSrv.h"
 #include "tftpCommon.h"
+#include "tftpArena.h"
+#include "tftpDataMgrFile.h"
+#include "tftpPkt.h"
+#include "tftpPreload.h"
+#include "tftpProbe.h"
 #include "tftpSmBuf.h"
 #include "tftpAddr.h"
 
@@ -26,11 +35,31 @@ namespace tftp
 
 // -----------------------------------------------------------------------------
 
+namespace
+{
+  /// Flag "SIGHUP received"
+  volatile sig_atomic_t sighup_received = 0;
+
+  void on_sighup(int)
+  {
+    sighup_received = 1;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 Srv::Srv():
     Base(),
     sessions_{},
     socket_{-1},
-    stop_{false}
+    stop_{false},
+    reload_request_{false},
+    reload_ready_{false},
+    reload_thread_{},
+    reload_settings_{nullptr},
+    metrics_{nullptr},
+    control_{nullptr},
+    drain_{false}
 {
 }
 
@@ -38,6 +67,7 @@ Srv::Srv():
 
 Srv::~Srv()
 {
+  if(reload_thread_.joinable()) reload_thread_.join();
 }
 
 // -----------------------------------------------------------------------------
@@ -45,13 +75,9 @@ Srv::~Srv()
 bool Srv::socket_open()
 {
   // Open socket
-  {
-    auto lk = begin_shared();
-
-    socket_ = socket(settings_->local_base_.family(),
-                     SOCK_DGRAM,
-                     0);
-  }
+  socket_ = socket(settings_->local_base_.family(),
+                   SOCK_DGRAM,
+                   0);
   if(socket_< 0)
   {
     Buf err_msg_buf(1024, 0);
@@ -64,14 +90,9 @@ bool Srv::socket_open()
   };
 
   // Bind
-  int bind_result;
-  {
-    auto lk = begin_shared();
-
-    bind_result = bind(socket_,
-                       settings_->local_base_.as_sockaddr_ptr(),
-                       settings_->local_base_.data_size());
-  }
+  int bind_result = bind(socket_,
+                         settings_->local_base_.as_sockaddr_ptr(),
+                         settings_->local_base_.data_size());
   if(bind_result != 0)
   {
     Buf err_msg_buf(1024, 0);
@@ -104,6 +125,59 @@ bool Srv::init()
 
   bool ret = socket_open();
 
+  if(ret && get_use_huge_pages())
+  {
+    Arena::global().enable();
+    L_INF("Buffers allocated from huge pages arena");
+  }
+
+  if(ret) preload(settings_);
+
+  if(ret && get_metrics_listen().size())
+  {
+    metrics_ = std::make_shared<MetricsServer>(get_metrics_listen());
+    if(auto [metrics_ok, err] = metrics_->open(); metrics_ok)
+    {
+      L_INF("Metrics exported on "+get_metrics_listen());
+    }
+    else
+    {
+      Buf err_msg_buf(1024, 0);
+      L_ERR("Can't export metrics on "+get_metrics_listen()+": "+
+            std::string{strerror_r(err,
+                                   err_msg_buf.data(),
+                                   err_msg_buf.size())});
+      metrics_.reset();
+    }
+  }
+
+  if(ret && get_control_path().size())
+  {
+    control_ = std::make_shared<ControlServer>(get_control_path());
+    if(auto [control_ok, err] = control_->open(); control_ok)
+    {
+      L_INF("Control socket "+get_control_path());
+    }
+    else
+    {
+      Buf err_msg_buf(1024, 0);
+      L_ERR("Can't open control socket "+get_control_path()+": "+
+            std::string{strerror_r(err,
+                                   err_msg_buf.data(),
+                                   err_msg_buf.size())});
+      control_.reset();
+    }
+  }
+
+  if(ret)
+  {
+    struct sigaction act{};
+    act.sa_handler = on_sighup;
+    act.sa_flags = SA_RESTART;
+    sigemptyset(& act.sa_mask);
+    sigaction(SIGHUP, & act, nullptr);
+  }
+
   if(ret) L_INF("Server listening "+get_local_base_str());
 
   L_INF("Server initialise is "+(ret ? "SUCCESSFUL" : "FAIL"));
@@ -113,11 +187,318 @@ bool Srv::init()
 
 // -----------------------------------------------------------------------------
 
+void Srv::preload(pSettings snapshot, const Preload * prev)
+{
+  const auto & manifest = snapshot->preload_manifest;
+  auto store = snapshot->preload_;
+  if(!manifest.size() || !store) return;
+
+  auto start = std::chrono::steady_clock::now();
+
+  auto [ret, entries] = read_preload_manifest(manifest);
+  if(!ret)
+  {
+    L_ERR("Can't read preload manifest '"+manifest+"'");
+    return;
+  }
+
+  size_t cnt_huge = 0U;
+  size_t cnt_locked = 0U;
+  for(auto & entry : entries)
+  {
+    // Absolute path use as is, else search as requested name
+    Path path{entry};
+    bool found = path.is_absolute() && filesystem::is_regular_file(path);
+    if(!found)
+    {
+      DataMgrFile dm;
+      std::tie(found, path) = dm.locate(snapshot, entry);
+    }
+
+    if(!found)
+    {
+      L_WRN("Preload file '"+entry+"' not found");
+      continue;
+    }
+
+    auto [img, err] = store->load(path.string(), prev);
+    if(!img)
+    {
+      Buf err_msg_buf(1024, 0);
+      L_WRN("Can't preload file '"+path.string()+"': "+
+            std::string{strerror_r(err,
+                                   err_msg_buf.data(),
+                                   err_msg_buf.size())});
+      continue;
+    }
+
+    if(img->is_huge()) ++cnt_huge;
+    if(img->is_locked()) ++cnt_locked;
+  }
+
+  auto [cnt, data_size, alloc_size] = store->stat();
+  auto time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  L_INF("Preloaded "+std::to_string(cnt)+" files ("+
+        std::to_string(data_size)+" bytes data; "+
+        std::to_string(alloc_size)+" bytes memory; "+
+        std::to_string(cnt_huge)+" in huge pages; "+
+        std::to_string(cnt_locked)+" locked) in "+
+        std::to_string(time_ms)+" ms");
+
+  if(cnt_locked < cnt)
+  {
+    L_WRN("Not all preloaded files locked in RAM; check RLIMIT_MEMLOCK");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void Srv::stop()
 {
   stop_ = true;
 }
 
+// -----------------------------------------------------------------------------
+
+void Srv::reload()
+{
+  reload_request_ = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Srv::reload_prepare()
+{
+  auto start = std::chrono::steady_clock::now();
+
+  auto new_settings = Settings::create();
+
+  if(!new_settings->load_options(settings_->cmd_args))
+  {
+    L_ERR("Reload failed: wrong options"+
+          (settings_->config_file.size() ?
+              " or configuration file '"+settings_->config_file+"'" :
+              std::string{}));
+    reload_settings_.reset();
+    reload_ready_ = true;
+    return;
+  }
+
+  for(auto & name : new_settings->adopt(* settings_))
+  {
+    L_WRN("Option '"+name+"' changed; used only after restart");
+  }
+
+  // Warm up new lookup cache
+  size_t cnt_warm = 0U;
+  if(new_settings->lookup_cache_ && new_settings->lookup_cache_->enabled() &&
+     settings_->lookup_cache_)
+  {
+    for(auto & name : settings_->lookup_cache_->names())
+    {
+      DataMgrFile dm;
+      if(std::get<0>(dm.locate(new_settings, name))) ++cnt_warm;
+    }
+  }
+
+  preload(new_settings, settings_->preload_.get());
+
+  auto time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  L_INF("New settings ready ("+std::to_string(cnt_warm)+
+        " names resolved again) in "+std::to_string(time_ms)+" ms");
+
+  reload_settings_ = new_settings;
+  reload_ready_ = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Srv::reload_check()
+{
+  if(sighup_received)
+  {
+    sighup_received = 0;
+    L_INF("SIGHUP received");
+    reload_request_ = true;
+  }
+
+  if(reload_ready_)
+  {
+    reload_thread_.join();
+    reload_ready_ = false;
+
+    if(reload_settings_)
+    {
+      settings_ = reload_settings_;
+      reload_settings_.reset();
+      L_INF("Settings reloaded; running sessions keep previous settings");
+    }
+  }
+
+  if(reload_request_ && !reload_thread_.joinable())
+  {
+    reload_request_ = false;
+    L_INF("Settings reload started");
+    reload_thread_ = std::thread(& Srv::reload_prepare, this);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+auto Srv::metrics_text() const -> std::string
+{
+  std::string ret;
+
+  auto out_hits = [&](std::string_view name,
+                      std::string_view help,
+                      std::tuple<size_t, size_t> stat)
+  {
+    auto [hits, misses] = stat;
+    Metrics::out_head(ret, name, "counter", help);
+    Metrics::out_value(ret, name, "result=\"hit\"", std::to_string(hits));
+    Metrics::out_value(ret, name, "result=\"miss\"", std::to_string(misses));
+  };
+
+  if(auto cache = get_lookup_cache(); cache && cache->enabled())
+  {
+    out_hits("tftp_lookup_cache_total", "Lookup cache requests", cache->stat());
+  }
+
+  if(auto cache = get_block_cache(); cache)
+  {
+    out_hits("tftp_block_cache_total", "Block cache requests", cache->stat());
+  }
+
+  if(auto read_ahead = get_read_ahead(); read_ahead)
+  {
+    out_hits("tftp_read_ahead_total", "Read-ahead windows ready", read_ahead->stat());
+  }
+
+  auto out_log = [&](std::string_view log, const pLogWriter & writer)
+  {
+    auto [written, dropped] = writer->stat();
+    const std::string labels{"log=\""+std::string{log}+"\",result="};
+    Metrics::out_value(ret, "tftp_log_messages_total",
+                       labels+"\"written\"", std::to_string(written));
+    Metrics::out_value(ret, "tftp_log_messages_total",
+                       labels+"\"dropped\"", std::to_string(dropped));
+  };
+
+  auto log_writer = get_log_writer();
+  auto transfer_log = get_transfer_log();
+  if(log_writer || transfer_log)
+  {
+    Metrics::out_head(ret, "tftp_log_messages_total", "counter",
+                      "Asynchronous log messages (dropped if ring full)");
+    if(log_writer) out_log("syslog", log_writer);
+    if(transfer_log) out_log("transfer", transfer_log);
+  }
+
+  auto & arena = Arena::global();
+  if(auto [total, hugetlb, thp, used] = arena.stat(); arena.enabled() || total)
+  {
+    Metrics::out_head(ret, "tftp_arena_bytes", "gauge", "Memory of buffers arena");
+    Metrics::out_value(ret, "tftp_arena_bytes", "kind=\"total\"", std::to_string(total));
+    Metrics::out_value(ret, "tftp_arena_bytes", "kind=\"hugetlb\"", std::to_string(hugetlb));
+    Metrics::out_value(ret, "tftp_arena_bytes", "kind=\"thp\"", std::to_string(thp));
+    Metrics::out_value(ret, "tftp_arena_bytes", "kind=\"used\"", std::to_string(used));
+  }
+
+  return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+auto Srv::control_command(const std::vector<std::string> & cmd) -> std::string
+{
+  std::string ret;
+
+  if(cmd.empty() || (cmd[0U] == "help"))
+  {
+    ret = "Commands:\n"
+          "  list       Running sessions\n"
+          "  kill <id>  Cancel session (client get ERROR)\n"
+          "  drain      Stop accept new requests\n"
+          "  resume     Accept new requests again\n"
+          "  metrics    Metrics in Prometheus text format\n";
+  }
+  else
+  if(cmd[0U] == "list")
+  {
+    ret = "ID CLIENT OP STATE BLOCKS BYTES SECONDS RATE FILE\n";
+    for(const auto & item : sessions_)
+    {
+      const auto & sss = std::get<0>(item);
+      if(sss.is_finished()) continue;
+
+      auto snap = sss.snapshot();
+      ret.append(std::to_string(snap.id)).append(" ").
+          append(snap.client).append(" ").
+          append(to_string(snap.request)).append(" ").
+          append(to_string(snap.state)).append(" ").
+          append(std::to_string(snap.blocks)).append(" ").
+          append(std::to_string(snap.bytes)).append(" ").
+          append(std::to_string(snap.elapsed_us / 1000000U)).append(" ").
+          append(std::to_string(snap.elapsed_us ?
+              (uint64_t) snap.bytes * 1000000U / snap.elapsed_us : 0U)).append(" ").
+          append(snap.filename).append("\n");
+    }
+  }
+  else
+  if((cmd[0U] == "kill") && (cmd.size() == 2U))
+  {
+    uint64_t id = std::strtoull(cmd[1U].c_str(), nullptr, 10);
+    auto it = std::find_if(sessions_.begin(), sessions_.end(),
+        [&](const auto & item)
+        {
+          return (std::get<0>(item).id() == id) &&
+                 !std::get<0>(item).is_finished();
+        });
+
+    if(it != sessions_.end())
+    {
+      std::get<0>(* it).cancel();
+      L_WRN("Session "+cmd[1U]+" cancelled by control command");
+      ret = "OK session "+cmd[1U]+" cancelled\n";
+    }
+    else
+    {
+      ret = "ERROR session "+cmd[1U]+" not found\n";
+    }
+  }
+  else
+  if(cmd[0U] == "drain")
+  {
+    drain_ = true;
+    L_WRN("Drain: new requests not accepted");
+    auto running = std::count_if(sessions_.begin(), sessions_.end(),
+        [](const auto & item) { return !std::get<0>(item).is_finished(); });
+    ret = "OK draining; "+std::to_string(running)+" sessions running\n";
+  }
+  else
+  if(cmd[0U] == "resume")
+  {
+    drain_ = false;
+    L_INF("Resume: new requests accepted");
+    ret = "OK accepting requests\n";
+  }
+  else
+  if(cmd[0U] == "metrics")
+  {
+    ret = Metrics::global().text() + metrics_text();
+  }
+  else
+  {
+    ret = "ERROR unknown command '"+cmd[0U]+"'; try 'help'\n";
+  }
+
+  return ret;
+}
+
 // -----------------------------------------------------------------------------
 void Srv::main_loop()
 {
@@ -149,32 +530,64 @@ void Srv::main_loop()
       L_INF("Receive initial pkt (data size "+std::to_string(bsize)+
               " bytes) from "+client_addr.str());
 
-      tftp::Session sss(*this);
-
-      bool ret = sss.prepare(
-          client_addr,
-          pkt_buf,
-          (size_t) bsize);
+      const auto opcode = std::get<0>(pkt::decode_header(pkt_buf.data(),
+                                                         (size_t) bsize));
+      switch((pkt::Op) opcode)
+      {
+        case pkt::Op::rrq:
+          Metrics::add(Metric::requests_rrq);
+          break;
+        case pkt::Op::wrq:
+          Metrics::add(Metric::requests_wrq);
+          break;
+        default:
+          Metrics::add(Metric::requests_fake);
+          break;
+      }
 
-      if(ret)
+      if(drain_)
       {
-        auto new_session = sessions_.emplace(sessions_.end());
+        L_WRN("Drain mode; ignore request from "+client_addr.str());
+      }
+      else
+      {
+        tftp::Session sss(*this);
+
+        bool ret = sss.prepare(
+            client_addr,
+            pkt_buf,
+            (size_t) bsize);
 
-        std::get<0>(* new_session) = std::move(sss);
+        TFTP_PROBE4(request, sss.id(), opcode, bsize, client_addr.port());
 
-        std::get<1>(* new_session) = std::thread(
-            & tftp::Session::run,
-            & std::get<0>(* new_session));
+        if(ret)
+        {
+          auto new_session = sessions_.emplace(sessions_.end());
 
+          std::get<0>(* new_session) = std::move(sss);
+
+          std::get<1>(* new_session) = std::thread(
+              & tftp::Session::run,
+              & std::get<0>(* new_session));
+
+        }
       }
     }
     else
     if(bsize > 0)
     {
+      Metrics::add(Metric::requests_fake);
       L_WRN("Receive fake initial pkt (data size " + std::to_string(bsize) +
             " bytes) from " + client_addr.str());
     }
 
+    reload_check();
+
+    if(metrics_) metrics_->serve([this]() { return metrics_text(); });
+
+    if(control_) control_->serve([this](const std::vector<std::string> & cmd)
+        { return control_command(cmd); });
+
     // check finished other sessions
     usleep(1000);
     for(auto it = sessions_.begin(); it != sessions_.end(); ++it)
@@ -187,6 +600,27 @@ void Srv::main_loop()
       }
     }
   }
+
+  if(reload_thread_.joinable()) reload_thread_.join();
+
+  if(Arena::global().enabled())
+  {
+    auto [total, hugetlb, thp, used] = Arena::global().stat();
+    L_INF("Arena memory "+std::to_string(total)+" bytes ("+
+          std::to_string(hugetlb)+" bytes MAP_HUGETLB; "+
+          std::to_string(thp)+" bytes transparent huge pages advised; "+
+          std::to_string(used)+" bytes used)");
+  }
+
+  if(auto writer = get_log_writer(); writer)
+  {
+    auto [written, dropped] = writer->stat();
+    if(dropped)
+    {
+      L_WRN("Log messages dropped "+std::to_string(dropped)+" (written "+
+            std::to_string(written)+"); log rings was full");
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
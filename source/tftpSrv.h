@@ -15,9 +15,12 @@
 #ifndef SOURCE_TFTP_SERVER_H_
 #define SOURCE_TFTP_SERVER_H_
 
+#include <atomic>
 #include <list>
 #include <thread>
 
+#include "tftpControl.h"
+#include "tftpMetrics.h"
 #include "tftpSession.h"
 #include "tftpSmBuf.h"
 
@@ -47,6 +50,27 @@ protected:
   /// Flag "need stop"
   bool stop_;
 
+  /// Flag "need reload settings"
+  std::atomic_bool reload_request_;
+
+  /// Flag "reload thread finished"
+  std::atomic_bool reload_ready_;
+
+  /// Thread of reload settings
+  std::thread reload_thread_;
+
+  /// Settings made by reload thread (nullptr if reload failed)
+  pSettings reload_settings_;
+
+  /// Metrics endpoint (nullptr if disabled)
+  pMetricsServer metrics_;
+
+  /// Control socket (nullptr if disabled)
+  pControlServer control_;
+
+  /// Flag "drain": new requests not accepted
+  bool drain_;
+
   /** \brief Open socket and listening
    *
    *  \return True if success, false if error occured
@@ -57,6 +81,42 @@ protected:
    */
   void socket_close();
 
+  /** \brief Load files from preload manifest to memory
+   *
+   *  Log count of files, memory footprint and load time
+   *  \param [in] snapshot Settings with manifest and storage for files
+   *  \param [in] prev Storage of running settings (share unchanged files)
+   */
+  void preload(pSettings snapshot, const Preload * prev = nullptr);
+
+  /** \brief Make new settings from configuration (reload thread)
+   *
+   *  Parse options again, warm up new lookup cache by names resolved
+   *  with running settings and load preloaded files
+   */
+  void reload_prepare();
+
+  /** \brief Start reload if requested; publish settings if ready
+   *
+   *  Called from main loop only. Running sessions keep own settings.
+   */
+  void reload_check();
+
+  /** \brief Make text of caches metrics in Prometheus format
+   *
+   *  \return Text
+   */
+  auto metrics_text() const -> std::string;
+
+  /** \brief Execute command from control socket
+   *
+   *  Called from main loop only (sessions list not locked).
+   *  Commands: list, kill <id>, drain, resume, metrics, help
+   *  \param [in] cmd Words of command line
+   *  \return Response text
+   */
+  auto control_command(const std::vector<std::string> & cmd) -> std::string;
+
 public:
 
   /** \brief Default constructor
@@ -85,6 +145,12 @@ public:
    */
   void stop();
 
+  /** \brief Request reload settings (as by SIGHUP)
+   *
+   *  Settings switched inside main_loop() when new snapshot ready
+   */
+  void reload();
+
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+/**
+ * \file server-fw-ctl.cpp
+ * \brief Control utility of TFTP server
+ *
+ *  Send command to control socket of running server (option --control)
+ *  and print response
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+  if(argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <socket path> <command> [argument]" << std::endl
+              << "Commands:" << std::endl
+              << "  list       Running sessions" << std::endl
+              << "  kill <id>  Cancel session (client get ERROR)" << std::endl
+              << "  drain      Stop accept new requests" << std::endl
+              << "  resume     Accept new requests again" << std::endl
+              << "  metrics    Metrics in Prometheus text format" << std::endl;
+    return 2;
+  }
+
+  struct sockaddr_un addr{};
+  std::string path{argv[1]};
+  if(path.size() >= sizeof(addr.sun_path))
+  {
+    std::cerr << "Socket path too long" << std::endl;
+    return 2;
+  }
+  addr.sun_family = AF_UNIX;
+  path.copy(addr.sun_path, path.size());
+
+  int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if((sock < 0) ||
+     (connect(sock, (struct sockaddr *) & addr, sizeof(addr)) != 0))
+  {
+    std::cerr << "Can't connect to '" << path << "': " << strerror(errno) << std::endl;
+    if(sock >= 0) close(sock);
+    return 2;
+  }
+
+  std::string line;
+  for(int iter = 2; iter < argc; ++iter)
+  {
+    if(iter > 2) line.push_back(' ');
+    line.append(argv[iter]);
+  }
+  line.push_back('\n');
+
+  if(write(sock, line.data(), line.size()) != (ssize_t) line.size())
+  {
+    std::cerr << "Can't send command: " << strerror(errno) << std::endl;
+    close(sock);
+    return 2;
+  }
+
+  std::string resp;
+  std::array<char, 4096U> buf;
+  ssize_t res;
+  while((res = read(sock, buf.data(), buf.size())) > 0) resp.append(buf.data(), res);
+  close(sock);
+
+  std::cout << resp;
+
+  return resp.compare(0U, 5U, "ERROR") ? 0 : 1;
+}
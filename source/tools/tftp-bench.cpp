@@ -0,0 +1,793 @@
+/**
+ * \file tftp-bench.cpp
+ * \brief TFTP load generator
+ *
+ *  Simulate many concurrent TFTP clients (one UDP socket per client, one
+ *  epoll loop) and report throughput, latency percentiles and resources
+ *  used by server under test; optional lossy link emulated between clients
+ *  and server
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <getopt.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "../tftpAddr.h"
+#include "../tftpPkt.h"
+#include "tftpLossyLink.h"
+
+namespace bench
+{
+
+// -----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+/// Requested file of mix
+struct FileItem
+{
+  std::string name;   ///< File name
+  std::string md5;    ///< MD5 sum of file (empty if unknown)
+  size_t      weight; ///< Relative weight in mix
+};
+
+/// Configuration of load
+struct Config
+{
+  tftp::Addr server;      ///< Server address
+  size_t     clients;     ///< Count of concurrent clients
+  size_t     requests;    ///< Total requests (0 - limited by duration)
+  double     duration;    ///< Duration of load, seconds (0 - by requests)
+  uint16_t   blksize;     ///< Requested block size
+  uint16_t   windowsize;  ///< Requested window size
+  std::vector<FileItem> files; ///< Mix of files for RRQ
+  double     md5_ratio;   ///< Part of RRQ by md5 sum (if known)
+  double     wrq_ratio;   ///< Part of WRQ requests
+  size_t     wrq_size;    ///< Size of uploaded file
+  unsigned   think_ms;    ///< Pause of client between transfers
+  unsigned   timeout_ms;  ///< Reply timeout
+  unsigned   retries;     ///< Retransmits before fail
+  pid_t      pid;         ///< PID of server under test (0 - unknown)
+  uint32_t   seed;        ///< Random seed
+  tftp::Impairment link;  ///< Impairments of link to server
+};
+
+/// State of client
+enum class St
+{
+  idle,       ///< No transfer (think time)
+  wait_first, ///< Request sent; wait first reply
+  transfer,   ///< Data exchange
+};
+
+/// Simulated client
+struct Client
+{
+  int               sock{-1};   ///< Socket of current transfer
+  St                st{St::idle};
+  bool              wrq{false}; ///< Flag: upload
+  bool              peer_set{false}; ///< Flag: server transfer port known
+  tftp::Addr        peer{};     ///< Server address of transfer
+  Clock::time_point start{};    ///< Time of request
+  Clock::time_point first{};    ///< Time of first data (RRQ) or reply (WRQ)
+  Clock::time_point last_io{};  ///< Time of last progress
+  Clock::time_point next_start{}; ///< Time of next request (think)
+  uint16_t          blksize{512U};
+  uint16_t          window{1U};
+  size_t            blk{0U};    ///< RRQ: last received block; WRQ: last acked
+  size_t            total{0U};  ///< WRQ: count of blocks
+  size_t            acked{0U};  ///< RRQ: last acknowledged block
+  bool              gap_acked{false}; ///< RRQ: ACK of gap sent, rest of window ignored
+  size_t            bytes{0U};  ///< Data transferred
+  unsigned          retries{0U};
+  std::vector<char> last_pkt{}; ///< Last packet for retransmit (not WRQ data)
+};
+
+/// Results
+struct Stat
+{
+  size_t started{0U};
+  size_t ok{0U};
+  size_t errors{0U};
+  size_t timeouts{0U};
+  size_t bytes{0U};
+  size_t retransmits{0U};
+  std::vector<uint64_t> ttfb_us;     ///< Time to first byte of successful transfers
+  std::vector<uint64_t> transfer_us; ///< Time of successful transfers
+};
+
+// -----------------------------------------------------------------------------
+
+auto usec(const Clock::duration & dur) -> uint64_t
+{
+  return (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(dur).count();
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Value of percentile
+ *
+ *  \param [in,out] vals Values (sorted)
+ *  \param [in] part Percentile (0..1)
+ *  \return Value
+ */
+auto percentile(std::vector<uint64_t> & vals, double part) -> uint64_t
+{
+  if(vals.empty()) return 0U;
+
+  size_t idx = std::min(vals.size() - 1U, (size_t) (part * (double) vals.size()));
+  std::nth_element(vals.begin(), vals.begin() + idx, vals.end());
+
+  return vals[idx];
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief CPU time of process
+ *
+ *  \param [in] pid Process id
+ *  \return Seconds (user + system); negative if unknown
+ */
+auto proc_cpu(pid_t pid) -> double
+{
+  std::ifstream file{"/proc/"+std::to_string(pid)+"/stat"};
+  std::string line;
+  if(!pid || !std::getline(file, line)) return -1.0;
+
+  // Fields after command name (command may have spaces)
+  std::istringstream fields{line.substr(line.rfind(')') + 2U)};
+  std::string val;
+  unsigned long utime = 0U;
+  unsigned long stime = 0U;
+  for(size_t iter = 3U; (iter <= 15U) && (fields >> val); ++iter)
+  {
+    if(iter == 14U) utime = std::stoul(val);
+    if(iter == 15U) stime = std::stoul(val);
+  }
+
+  return (double) (utime + stime) / (double) sysconf(_SC_CLK_TCK);
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Memory of process
+ *
+ *  \param [in] pid Process id
+ *  \return Tuple<resident KiB; peak resident KiB>
+ */
+auto proc_mem(pid_t pid) -> std::tuple<size_t, size_t>
+{
+  std::ifstream file{"/proc/"+std::to_string(pid)+"/status"};
+  size_t rss = 0U;
+  size_t hwm = 0U;
+  std::string line;
+  while(pid && std::getline(file, line))
+  {
+    if(line.compare(0U, 6U, "VmRSS:") == 0) rss = std::stoul(line.substr(6U));
+    if(line.compare(0U, 6U, "VmHWM:") == 0) hwm = std::stoul(line.substr(6U));
+  }
+
+  return {rss, hwm};
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Load generator
+ */
+class Bench
+{
+protected:
+
+  Config cfg_;
+
+  std::vector<Client> clients_;
+
+  Stat stat_;
+
+  int epoll_;
+
+  std::mt19937 rnd_;
+
+  size_t weight_sum_;
+
+  size_t wrq_seq_;
+
+  std::vector<char> tx_buf_;
+
+  std::vector<char> rx_buf_;
+
+  /// Send packet to server transfer port (or listen port before reply)
+  void send(Client & cl, const char * data, size_t size)
+  {
+    tftp::Addr & dst = cl.peer_set ? cl.peer : cfg_.server;
+    sendto(cl.sock, data, size, 0, dst.as_sockaddr_ptr(), dst.data_size());
+  }
+
+  /// Send and store for retransmit
+  void send_stored(Client & cl, std::vector<char> && pkt)
+  {
+    cl.last_pkt = std::move(pkt);
+    send(cl, cl.last_pkt.data(), cl.last_pkt.size());
+  }
+
+  /// Send ACK of block (RRQ: all before received too)
+  void send_ack(Client & cl, size_t blk)
+  {
+    std::vector<char> pkt(tftp::constants::pkt_header_size);
+    tftp::pkt::Ack::encode(pkt.data(), (uint16_t) blk);
+    cl.acked = blk;
+    send_stored(cl, std::move(pkt));
+  }
+
+  /// Send window of WRQ data after last acked block
+  void send_window(Client & cl)
+  {
+    for(size_t blk = cl.blk + 1U;
+        (blk <= cl.total) && (blk <= cl.blk + cl.window);
+        ++blk)
+    {
+      size_t offset = (blk - 1U) * cl.blksize;
+      size_t size = std::min((size_t) cl.blksize, cfg_.wrq_size - offset);
+      tftp::pkt::Data::encode(tx_buf_.data(), (uint16_t) blk);
+      send(cl, tx_buf_.data(), tftp::constants::pkt_header_size + size);
+    }
+  }
+
+  /// Make RRQ/WRQ packet
+  auto make_request(bool wrq, const std::string & name) -> std::vector<char>
+  {
+    std::vector<char> pkt{0, (char) (wrq ? 2 : 1)};
+    auto add = [&](const std::string & str)
+        { pkt.insert(pkt.end(), str.begin(), str.end()); pkt.push_back(0); };
+
+    add(name);
+    add("octet");
+    if(cfg_.blksize != 512U)
+    {
+      add("blksize");
+      add(std::to_string(cfg_.blksize));
+    }
+    if(cfg_.windowsize != 1U)
+    {
+      add("windowsize");
+      add(std::to_string(cfg_.windowsize));
+    }
+    if(wrq)
+    {
+      add("tsize");
+      add(std::to_string(cfg_.wrq_size));
+    }
+
+    return pkt;
+  }
+
+  /// Apply options acknowledged by server
+  void parse_oack(Client & cl, const char * src, size_t size)
+  {
+    std::vector<std::string> items;
+    size_t pos = 0U;
+    while(pos < size)
+    {
+      size_t len = strnlen(src + pos, size - pos);
+      items.emplace_back(src + pos, len);
+      pos += len + 1U;
+    }
+
+    for(size_t iter = 0U; iter + 1U < items.size(); iter += 2U)
+    {
+      if(items[iter] == "blksize") cl.blksize = (uint16_t) std::stoul(items[iter + 1U]);
+      if(items[iter] == "windowsize") cl.window = (uint16_t) std::stoul(items[iter + 1U]);
+    }
+  }
+
+  /// Start new transfer
+  bool start(Client & cl, const Clock::time_point & now)
+  {
+    cl.sock = socket(cfg_.server.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(cl.sock < 0) return false;
+
+    struct epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = (uint64_t) (& cl - clients_.data());
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, cl.sock, & ev);
+
+    std::uniform_real_distribution<double> part{0.0, 1.0};
+    cl.wrq = cfg_.files.empty() || (part(rnd_) < cfg_.wrq_ratio);
+    cl.st = St::wait_first;
+    cl.peer_set = false;
+    cl.start = now;
+    cl.last_io = now;
+    cl.blksize = 512U;
+    cl.window = 1U;
+    cl.blk = 0U;
+    cl.acked = 0U;
+    cl.gap_acked = false;
+    cl.bytes = 0U;
+    cl.retries = 0U;
+
+    std::string name;
+    if(cl.wrq)
+    {
+      name = "tftp-bench-"+std::to_string(getpid())+"-"+std::to_string(++wrq_seq_);
+    }
+    else
+    {
+      size_t pick = std::uniform_int_distribution<size_t>{0U, weight_sum_ - 1U}(rnd_);
+      auto it = cfg_.files.begin();
+      while(pick >= it->weight) pick -= (it++)->weight;
+      name = (it->md5.size() && (part(rnd_) < cfg_.md5_ratio)) ? it->md5 : it->name;
+    }
+
+    ++stat_.started;
+    send_stored(cl, make_request(cl.wrq, name));
+
+    return true;
+  }
+
+  /// Finish transfer
+  void finish(Client & cl, const Clock::time_point & now, bool ok, bool timeout)
+  {
+    if(ok)
+    {
+      ++stat_.ok;
+      stat_.bytes += cl.bytes;
+      stat_.ttfb_us.push_back(usec(cl.first - cl.start));
+      stat_.transfer_us.push_back(usec(now - cl.start));
+    }
+    else
+    {
+      ++(timeout ? stat_.timeouts : stat_.errors);
+    }
+
+    close(cl.sock);
+    cl.sock = -1;
+    cl.st = St::idle;
+    cl.next_start = now + std::chrono::milliseconds{cfg_.think_ms};
+  }
+
+  /// Process received packet
+  void receive(Client & cl, const tftp::Addr & from, size_t size,
+               const Clock::time_point & now)
+  {
+    if(!cl.peer_set)
+    {
+      cl.peer = from;
+      cl.peer_set = true;
+    }
+    else
+    if(!(from == cl.peer))
+    {
+      return; // other TID
+    }
+
+    const tftp::pkt::Rx rx = tftp::pkt::classify(rx_buf_.data(), size);
+
+    if(rx.op == tftp::pkt::Op::error)
+    {
+      finish(cl, now, false, false);
+      return;
+    }
+
+    bool first_reply = (cl.st == St::wait_first);
+    if(first_reply && (rx.op == tftp::pkt::Op::oack))
+    {
+      parse_oack(cl, rx_buf_.data() + 2U, size - 2U); // OACK has no field
+    }
+
+    if(cl.wrq)
+    {
+      if(first_reply && (rx.op != tftp::pkt::Op::oack) &&
+         !((rx.op == tftp::pkt::Op::ack) && (rx.field == 0U))) return;
+      if(!first_reply && (rx.op != tftp::pkt::Op::ack)) return;
+
+      if(first_reply)
+      {
+        cl.st = St::transfer;
+        cl.first = now;
+        cl.total = cfg_.wrq_size / cl.blksize + 1U;
+      }
+      else
+      {
+        // Map 16-bit block number to full number
+        size_t delta = (uint16_t) (rx.field - (uint16_t) cl.blk);
+        if(!delta || (cl.blk + delta > std::min(cl.total, cl.blk + cl.window))) return;
+        cl.bytes += std::min(cfg_.wrq_size, (cl.blk + delta) * cl.blksize) -
+                    std::min(cfg_.wrq_size, cl.blk * cl.blksize);
+        cl.blk += delta;
+      }
+
+      cl.last_io = now;
+      cl.retries = 0U;
+      if(cl.blk == cl.total)
+      {
+        finish(cl, now, true, false);
+      }
+      else
+      {
+        send_window(cl);
+      }
+      return;
+    }
+
+    // RRQ
+    if(rx.op == tftp::pkt::Op::oack)
+    {
+      if(!first_reply) return;
+      cl.st = St::transfer;
+      cl.last_io = now;
+      send_ack(cl, 0U);
+      return;
+    }
+
+    if(rx.op != tftp::pkt::Op::data) return;
+
+    // Window of server ends at last ACK + window size (RFC 7440)
+    uint16_t ahead = (uint16_t) (rx.field - (uint16_t) cl.blk);
+    if(!ahead || (ahead > cl.window)) return; // duplicate or old block
+
+    if(ahead > 1U)
+    {
+      // Gap - acknowledge last good block once, rest of window discarded
+      if(!cl.gap_acked)
+      {
+        cl.gap_acked = true;
+        send_ack(cl, cl.blk);
+      }
+      return;
+    }
+    cl.gap_acked = false;
+
+    if(!cl.blk) cl.first = now;
+    cl.st = St::transfer;
+    ++cl.blk;
+    cl.bytes += rx.payload_size;
+    cl.last_io = now;
+    cl.retries = 0U;
+
+    bool last = (rx.payload_size < cl.blksize);
+    if(last || (cl.blk >= cl.acked + cl.window)) send_ack(cl, cl.blk);
+    if(last) finish(cl, now, true, false);
+  }
+
+  /// Check timeouts; retransmit
+  void check_timeouts(const Clock::time_point & now)
+  {
+    const auto timeout = std::chrono::milliseconds{cfg_.timeout_ms};
+
+    for(auto & cl : clients_)
+    {
+      if((cl.st == St::idle) || (now - cl.last_io < timeout)) continue;
+
+      if(++cl.retries > cfg_.retries)
+      {
+        finish(cl, now, false, true);
+        continue;
+      }
+
+      ++stat_.retransmits;
+      cl.last_io = now;
+      if(cl.wrq && (cl.st == St::transfer))
+      {
+        send_window(cl);
+      }
+      else
+      if(!cl.wrq && cl.blk)
+      {
+        send_ack(cl, cl.blk); // server continue after last good block
+      }
+      else
+      {
+        send(cl, cl.last_pkt.data(), cl.last_pkt.size());
+      }
+    }
+  }
+
+public:
+
+  Bench(const Config & cfg):
+      cfg_{cfg},
+      clients_(cfg.clients),
+      stat_{},
+      epoll_{epoll_create1(EPOLL_CLOEXEC)},
+      rnd_{cfg.seed},
+      weight_sum_{0U},
+      wrq_seq_{0U},
+      tx_buf_(0xFFFFU, 'x'),
+      rx_buf_(0xFFFFU, 0)
+  {
+    for(const auto & item : cfg_.files) weight_sum_ += item.weight;
+  }
+
+  ~Bench()
+  {
+    for(auto & cl : clients_) if(cl.sock >= 0) close(cl.sock);
+    close(epoll_);
+  }
+
+  /** \brief Run load
+   *
+   *  \return Elapsed seconds
+   */
+  auto run() -> double
+  {
+    const auto begin = Clock::now();
+    const auto end = begin + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>{cfg_.duration});
+    std::array<struct epoll_event, 256U> events;
+
+    while(true)
+    {
+      auto now = Clock::now();
+      bool more = (!cfg_.requests || (stat_.started < cfg_.requests)) &&
+                  ((cfg_.duration <= 0.0) || (now < end));
+
+      size_t active = 0U;
+      for(auto & cl : clients_)
+      {
+        if((cl.st == St::idle) && more && (now >= cl.next_start) &&
+           (!cfg_.requests || (stat_.started < cfg_.requests)))
+        {
+          if(!start(cl, now)) more = false;
+        }
+        if(cl.st != St::idle) ++active;
+      }
+
+      if(!active && !more) break;
+
+      int count = epoll_wait(epoll_, events.data(), (int) events.size(), 5);
+      now = Clock::now();
+      for(int iter = 0; iter < count; ++iter)
+      {
+        auto & cl = clients_[events[iter].data.u64];
+        tftp::Addr from;
+        ssize_t size;
+        while(cl.sock >= 0)
+        {
+          from.data_size() = from.size();
+          size = recvfrom(cl.sock, rx_buf_.data(), rx_buf_.size(), 0,
+                          from.as_sockaddr_ptr(), & from.data_size());
+          if(size < 0) break;
+          receive(cl, from, (size_t) size, now);
+        }
+      }
+
+      check_timeouts(now);
+    }
+
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+  }
+
+  auto stat() -> Stat & { return stat_; }
+};
+
+// -----------------------------------------------------------------------------
+
+void out_help(const char * app)
+{
+  std::cout << "Usage: " << app << " [options]" << std::endl
+  << "  --server <ip:port> Server under test (default 127.0.0.1:69)" << std::endl
+  << "  --clients <N> Concurrent clients (default 100)" << std::endl
+  << "  --requests <N> Total requests; 0 - unlimited (default 1000)" << std::endl
+  << "  --duration <seconds> Stop start requests after time (default - by requests)" << std::endl
+  << "  --blksize <N> Requested block size (default 512)" << std::endl
+  << "  --windowsize <N> Requested window size (default 1)" << std::endl
+  << "  --file <name>[,<md5>[,<weight>]] File for RRQ (repeat for mix)" << std::endl
+  << "  --md5-ratio <0..1> Part of RRQ by md5 sum (default 0)" << std::endl
+  << "  --wrq-ratio <0..1> Part of WRQ (upload) requests (default 0; 1 if no files)" << std::endl
+  << "  --wrq-size <bytes> Size of uploaded file (default 65536)" << std::endl
+  << "  --think <ms> Pause of client between transfers (default 0)" << std::endl
+  << "  --timeout <ms> Reply timeout (default 1000)" << std::endl
+  << "  --retries <N> Retransmits before fail (default 5)" << std::endl
+  << "  --pid <PID> Server process for CPU and memory report" << std::endl
+  << "  --seed <N> Random seed (default 1)" << std::endl
+  << "Lossy link between clients and server (UDP proxy in process):" << std::endl
+  << "  --loss <0..1> Probability of packet loss" << std::endl
+  << "  --duplicate <0..1> Probability of packet duplication" << std::endl
+  << "  --reorder <0..1> Probability of packet reordering" << std::endl
+  << "  --delay <ms> One-way delay" << std::endl
+  << "  --jitter <ms> Delay variation" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+auto parse(int argc, char * argv[], Config & cfg) -> bool
+{
+  static const struct option long_options[] = {
+      { "server",     required_argument, NULL, 0 }, // 0
+      { "clients",    required_argument, NULL, 0 }, // 1
+      { "requests",   required_argument, NULL, 0 }, // 2
+      { "duration",   required_argument, NULL, 0 }, // 3
+      { "blksize",    required_argument, NULL, 0 }, // 4
+      { "windowsize", required_argument, NULL, 0 }, // 5
+      { "file",       required_argument, NULL, 0 }, // 6
+      { "md5-ratio",  required_argument, NULL, 0 }, // 7
+      { "wrq-ratio",  required_argument, NULL, 0 }, // 8
+      { "wrq-size",   required_argument, NULL, 0 }, // 9
+      { "think",      required_argument, NULL, 0 }, // 10
+      { "timeout",    required_argument, NULL, 0 }, // 11
+      { "retries",    required_argument, NULL, 0 }, // 12
+      { "pid",        required_argument, NULL, 0 }, // 13
+      { "seed",       required_argument, NULL, 0 }, // 14
+      { "help",             no_argument, NULL, 0 }, // 15
+      { "loss",       required_argument, NULL, 0 }, // 16
+      { "duplicate",  required_argument, NULL, 0 }, // 17
+      { "reorder",    required_argument, NULL, 0 }, // 18
+      { "delay",      required_argument, NULL, 0 }, // 19
+      { "jitter",     required_argument, NULL, 0 }, // 20
+      { NULL,               no_argument, NULL, 0 }  // always last
+  };
+
+  cfg.server.set_string("127.0.0.1:69");
+
+  int opt_idx;
+  while(getopt_long(argc, argv, "", long_options, & opt_idx) == 0)
+  {
+    std::string arg{optarg ? optarg : ""};
+    try
+    {
+      switch(opt_idx)
+      {
+        case 0:
+          if(!std::get<0>(cfg.server.set_string(arg)))
+          {
+            std::cerr << "Wrong server address '" << arg << "'" << std::endl;
+            return false;
+          }
+          break;
+        case 1: cfg.clients = std::stoul(arg); break;
+        case 2: cfg.requests = std::stoul(arg); break;
+        case 3: cfg.duration = std::stod(arg); break;
+        case 4: cfg.blksize = (uint16_t) std::stoul(arg); break;
+        case 5: cfg.windowsize = (uint16_t) std::stoul(arg); break;
+        case 6:
+          {
+            FileItem item{arg, "", 1U};
+            if(size_t pos = arg.find(','); pos != std::string::npos)
+            {
+              item.name = arg.substr(0U, pos);
+              item.md5 = arg.substr(pos + 1U);
+              if(pos = item.md5.find(','); pos != std::string::npos)
+              {
+                item.weight = std::stoul(item.md5.substr(pos + 1U));
+                item.md5.erase(pos);
+              }
+            }
+            if(item.weight) cfg.files.push_back(item);
+          }
+          break;
+        case 7: cfg.md5_ratio = std::stod(arg); break;
+        case 8: cfg.wrq_ratio = std::stod(arg); break;
+        case 9: cfg.wrq_size = std::stoul(arg); break;
+        case 10: cfg.think_ms = (unsigned) std::stoul(arg); break;
+        case 11: cfg.timeout_ms = (unsigned) std::stoul(arg); break;
+        case 12: cfg.retries = (unsigned) std::stoul(arg); break;
+        case 13: cfg.pid = (pid_t) std::stol(arg); break;
+        case 14: cfg.seed = (uint32_t) std::stoul(arg); break;
+        case 15: out_help(argv[0]); return false;
+        case 16: cfg.link.loss = std::stod(arg); break;
+        case 17: cfg.link.duplicate = std::stod(arg); break;
+        case 18: cfg.link.reorder = std::stod(arg); break;
+        case 19: cfg.link.delay_ms = (unsigned) std::stoul(arg); break;
+        case 20: cfg.link.jitter_ms = (unsigned) std::stoul(arg); break;
+      }
+    }
+    catch(const std::exception &)
+    {
+      std::cerr << "Wrong value '" << arg << "' of option --"
+                << long_options[opt_idx].name << std::endl;
+      return false;
+    }
+  }
+
+  if(optind < argc)
+  {
+    out_help(argv[0]);
+    return false;
+  }
+
+  if(!cfg.clients || (!cfg.requests && (cfg.duration <= 0.0)))
+  {
+    std::cerr << "Need clients and requests or duration" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace bench
+
+int main(int argc, char * argv[])
+{
+  bench::Config cfg{{}, 100U, 1000U, 0.0, 512U, 1U, {}, 0.0, 0.0, 65536U,
+                    0U, 1000U, 5U, 0, 1U, {}};
+  if(!bench::parse(argc, argv, cfg)) return 2;
+
+  // Clients work through lossy link if need
+  cfg.link.seed = cfg.seed;
+  tftp::LossyLink link{cfg.server, cfg.link};
+  if(cfg.link.any())
+  {
+    tftp::Addr listen;
+    listen.set_string(cfg.server.family() == AF_INET6 ? "[::1]:0" : "127.0.0.1:0");
+    if(auto [ok, err] = link.open(listen); !ok)
+    {
+      std::cerr << "Can't open lossy link: " << strerror(err) << std::endl;
+      return 2;
+    }
+    link.start();
+    cfg.server = link.local();
+  }
+
+  // One socket per client
+  struct rlimit lim;
+  if(getrlimit(RLIMIT_NOFILE, & lim) == 0)
+  {
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, & lim);
+  }
+
+  double cpu_before = bench::proc_cpu(cfg.pid);
+
+  bench::Bench load{cfg};
+  double elapsed = load.run();
+  auto & st = load.stat();
+  link.stop();
+
+  double cpu = bench::proc_cpu(cfg.pid) - cpu_before;
+  auto [rss, hwm] = bench::proc_mem(cfg.pid);
+
+  std::cout << std::fixed << std::setprecision(2)
+  << "Requests:      " << st.started << " started, " << st.ok << " ok, "
+  << st.errors << " errors, " << st.timeouts << " timeouts" << std::endl
+  << "Elapsed:       " << elapsed << " s" << std::endl
+  << "Rate:          " << (double) st.ok / elapsed << " requests/s" << std::endl
+  << "Goodput:       " << (double) st.bytes / elapsed / 1048576.0 << " MiB/s ("
+  << st.bytes << " bytes)" << std::endl
+  << "Retransmits:   " << st.retransmits << std::endl
+  << "TTFB:          p50 " << bench::percentile(st.ttfb_us, 0.5)
+  << " us, p99 " << bench::percentile(st.ttfb_us, 0.99)
+  << " us, p99.9 " << bench::percentile(st.ttfb_us, 0.999) << " us" << std::endl
+  << "Transfer time: p50 " << bench::percentile(st.transfer_us, 0.5)
+  << " us, p99 " << bench::percentile(st.transfer_us, 0.99)
+  << " us, p99.9 " << bench::percentile(st.transfer_us, 0.999) << " us" << std::endl;
+
+  if(cfg.link.any())
+  {
+    auto ls = link.stat();
+    std::cout
+    << "Link:          " << ls.forwarded << " forwarded, " << ls.dropped
+    << " dropped, " << ls.duplicated << " duplicated, " << ls.reordered
+    << " reordered" << std::endl;
+  }
+
+  if(cfg.pid && (cpu_before >= 0.0))
+  {
+    std::cout
+    << "Server CPU:    " << cpu << " s; " << (st.bytes ?
+        cpu / ((double) st.bytes / 1e9) : 0.0) << " s per GB" << std::endl
+    << "Server memory: " << rss / 1024.0 << " MiB resident, "
+    << hwm / 1024.0 << " MiB peak" << std::endl;
+  }
+
+  return (st.ok == st.started) ? 0 : 1;
+}
@@ -0,0 +1,348 @@
+/**
+ * \file tftpLossyLink.cpp
+ * \brief Lossy link emulator class module
+ *
+ *  UDP proxy between TFTP clients and server with injected loss,
+ *  duplication, reordering, delay and jitter (no root, no netem)
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "tftpLossyLink.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+/** \brief Key of address (only used bytes)
+ *
+ *  \param [in] addr Address
+ *  \return Key
+ */
+static auto addr_key(const Addr & addr) -> std::string
+{
+  return std::string{addr.data(), addr.data_size()};
+}
+
+// -----------------------------------------------------------------------------
+
+bool Impairment::any() const
+{
+  return (loss > 0.0) || (duplicate > 0.0) || (reorder > 0.0) ||
+         delay_ms || jitter_ms;
+}
+
+// -----------------------------------------------------------------------------
+
+bool LossyLink::Pending::operator>(const Pending & val) const
+{
+  return std::tie(due, seq) > std::tie(val.due, val.seq);
+}
+
+// -----------------------------------------------------------------------------
+
+LossyLink::LossyLink(const Addr & server, const Impairment & imp):
+    server_{server},
+    imp_{imp},
+    local_{},
+    listen_{-1},
+    flows_{},
+    queue_{},
+    seq_{0U},
+    flow_idle_{constants::lossy_flow_idle_s},
+    rnd_{imp.seed},
+    thread_{},
+    stop_{false},
+    forwarded_{0U},
+    dropped_{0U},
+    duplicated_{0U},
+    reordered_{0U}
+{
+}
+
+// -----------------------------------------------------------------------------
+
+LossyLink::~LossyLink()
+{
+  stop();
+  close_all();
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::close_all()
+{
+  for(auto & [key, flow] : flows_) close(flow.sock);
+  flows_.clear();
+
+  if(listen_ >= 0) close(listen_);
+  listen_ = -1;
+}
+
+// -----------------------------------------------------------------------------
+
+auto LossyLink::open(const Addr & listen) -> std::tuple<bool, int>
+{
+  stop();
+  close_all();
+
+  local_ = listen;
+  listen_ = socket(local_.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if(listen_ < 0) return {false, errno};
+
+  if((bind(listen_, local_.as_sockaddr_ptr(), local_.data_size()) != 0) ||
+     (getsockname(listen_, local_.as_sockaddr_ptr(), & local_.data_size()) != 0))
+  {
+    int err = errno;
+    close_all();
+    return {false, err};
+  }
+
+  return {true, 0};
+}
+
+// -----------------------------------------------------------------------------
+
+auto LossyLink::local() const -> const Addr &
+{
+  return local_;
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::start()
+{
+  if(thread_.joinable() || (listen_ < 0)) return;
+
+  stop_ = false;
+  thread_ = std::thread{& LossyLink::loop, this};
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::stop()
+{
+  stop_ = true;
+  if(thread_.joinable()) thread_.join();
+
+  while(!queue_.empty()) queue_.pop();
+}
+
+// -----------------------------------------------------------------------------
+
+auto LossyLink::stat() const -> Stat
+{
+  return {forwarded_.load(), dropped_.load(), duplicated_.load(),
+          reordered_.load()};
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::push(
+    int sock,
+    const Addr & to,
+    const char * data,
+    const size_t & size,
+    const Clock::time_point & now,
+    Clock::time_point & last_due)
+{
+  std::uniform_real_distribution<double> part{0.0, 1.0};
+
+  if(part(rnd_) < imp_.loss)
+  {
+    ++dropped_;
+    return;
+  }
+
+  size_t copies = 1U;
+  if(part(rnd_) < imp_.duplicate)
+  {
+    ++duplicated_;
+    ++copies;
+  }
+
+  for(size_t iter = 0U; iter < copies; ++iter)
+  {
+    int delay_us = (int) imp_.delay_ms * 1000;
+    if(imp_.jitter_ms)
+    {
+      int jitter_us = (int) imp_.jitter_ms * 1000;
+      delay_us += std::uniform_int_distribution<int>{-jitter_us, jitter_us}(rnd_);
+    }
+    auto due = now + std::chrono::microseconds{std::max(delay_us, 0)};
+
+    if(part(rnd_) < imp_.reorder)
+    {
+      ++reordered_;
+      due += std::chrono::milliseconds{imp_.reorder_ms};
+    }
+    else
+    {
+      due = std::max(due, last_due);
+      last_due = due;
+    }
+
+    queue_.push(Pending{
+        due,
+        seq_++,
+        sock,
+        to,
+        std::vector<char>(data, data + size)});
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+auto LossyLink::flush(const Clock::time_point & now) -> int
+{
+  while(!queue_.empty() && (queue_.top().due <= now))
+  {
+    const Pending & pkt = queue_.top();
+    Addr to{pkt.to};
+    if(sendto(pkt.sock, pkt.data.data(), pkt.data.size(), 0,
+              to.as_sockaddr_ptr(), to.data_size()) >= 0)
+    {
+      ++forwarded_;
+    }
+    queue_.pop();
+  }
+
+  if(queue_.empty()) return constants::lossy_poll_ms;
+
+  auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+      queue_.top().due - now).count() + 1;
+  return (int) std::min<decltype(wait)>(wait, constants::lossy_poll_ms);
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::from_client(const Clock::time_point & now)
+{
+  std::array<char, 0x10000U> buf;
+  Addr from;
+  ssize_t size;
+  while(from.data_size() = from.size(),
+        (size = recvfrom(listen_, buf.data(), buf.size(), 0,
+                         from.as_sockaddr_ptr(), & from.data_size())) >= 0)
+  {
+    auto it = flows_.find(addr_key(from));
+    if(it == flows_.end())
+    {
+      int sock = socket(server_.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if(sock < 0) continue;
+
+      it = flows_.emplace(addr_key(from), Flow{sock, from, {}, false, now, now, now}).first;
+    }
+
+    auto & flow = it->second;
+    flow.last = now;
+    push(flow.sock, flow.peer_set ? flow.peer : server_, buf.data(),
+         (size_t) size, now, flow.up);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::from_server(Flow & flow, const Clock::time_point & now)
+{
+  std::array<char, 0x10000U> buf;
+  Addr from;
+  ssize_t size;
+  while(from.data_size() = from.size(),
+        (size = recvfrom(flow.sock, buf.data(), buf.size(), 0,
+                         from.as_sockaddr_ptr(), & from.data_size())) >= 0)
+  {
+    if(!flow.peer_set)
+    {
+      flow.peer = from;
+      flow.peer_set = true;
+    }
+    else
+    if(addr_key(from) != addr_key(flow.peer))
+    {
+      continue; // other TID
+    }
+
+    flow.last = now;
+    push(listen_, flow.client, buf.data(), (size_t) size, now, flow.down);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::purge(int sock)
+{
+  std::vector<Pending> kept;
+  while(!queue_.empty())
+  {
+    if(queue_.top().sock != sock) kept.push_back(queue_.top());
+                             else ++dropped_;
+    queue_.pop();
+  }
+
+  for(auto & pkt : kept) queue_.push(std::move(pkt));
+}
+
+// -----------------------------------------------------------------------------
+
+void LossyLink::loop()
+{
+  std::vector<struct pollfd> fds;
+  std::vector<Flow *> fd_flows;
+  int wait_ms = constants::lossy_poll_ms;
+
+  while(!stop_)
+  {
+    fds.assign(1U, {listen_, POLLIN, 0});
+    fd_flows.assign(1U, nullptr);
+    for(auto & [key, flow] : flows_)
+    {
+      fds.push_back({flow.sock, POLLIN, 0});
+      fd_flows.push_back(& flow);
+    }
+
+    poll(fds.data(), fds.size(), wait_ms);
+
+    auto now = Clock::now();
+    for(size_t iter = 0U; iter < fds.size(); ++iter)
+    {
+      if(!(fds[iter].revents & POLLIN)) continue;
+
+      if(fd_flows[iter]) from_server(*fd_flows[iter], now);
+                    else from_client(now);
+    }
+
+    wait_ms = flush(Clock::now());
+
+    // Forget idle flows
+    for(auto it = flows_.begin(); it != flows_.end();)
+    {
+      if(now - it->second.last > flow_idle_)
+      {
+        purge(it->second.sock); // socket closed - packets never go
+        close(it->second.sock);
+        it = flows_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
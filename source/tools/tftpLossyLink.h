@@ -0,0 +1,246 @@
+/**
+ * \file tftpLossyLink.h
+ * \brief Lossy link emulator class header
+ *
+ *  UDP proxy between TFTP clients and server with injected loss,
+ *  duplication, reordering, delay and jitter (no root, no netem)
+ *
+ *  License GPL-3.0
+ *
+ *  \date 18-oct-2026
+ *  \author Vitaliy Shirinkin, e-mail: vitaliy.shirinkin@gmail.com
+ *
+ *  \version 0.2.1
+ */
+
+#ifndef SOURCE_TOOLS_TFTPLOSSYLINK_H_
+#define SOURCE_TOOLS_TFTPLOSSYLINK_H_
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <queue>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "../tftpAddr.h"
+
+namespace tftp
+{
+
+// -----------------------------------------------------------------------------
+
+namespace constants
+{
+  /// Extra delay of reordered packet (milliseconds)
+  constexpr unsigned lossy_reorder_ms = 5U;
+
+  /// Poll period of proxy thread (milliseconds)
+  constexpr int lossy_poll_ms = 10;
+
+  /// Flow of client forgotten after idle time (seconds)
+  constexpr unsigned lossy_flow_idle_s = 60U;
+}
+
+// -----------------------------------------------------------------------------
+
+/** \brief Impairments of link (applied to both directions independently)
+ */
+struct Impairment
+{
+  double   loss{0.0};      ///< Probability of packet drop (0..1)
+  double   duplicate{0.0}; ///< Probability of packet duplication (0..1)
+  double   reorder{0.0};   ///< Probability of packet delivered after next ones (0..1)
+  unsigned delay_ms{0U};   ///< One-way delay
+  unsigned jitter_ms{0U};  ///< Delay variation (uniform -jitter..+jitter; order kept)
+  unsigned reorder_ms{constants::lossy_reorder_ms}; ///< Extra delay of reordered packet
+  uint32_t seed{1U};       ///< Random seed (reproducible impairments)
+
+  /** \brief Check any impairment set
+   *
+   *  \return True if link not clean
+   */
+  bool any() const;
+};
+
+// -----------------------------------------------------------------------------
+
+/** \brief Lossy link emulator (UDP proxy)
+ *
+ *  Clients send requests to local() instead of server. Every client address
+ *  get own upstream socket, so server see separate clients. First reply
+ *  source of server (transfer TID) is remembered and later client packets
+ *  forwarded to it; replies from other server ports dropped as client with
+ *  other TID would do. Replies come to client from local() address.
+ *  Work in own thread between start() and stop().
+ */
+class LossyLink
+{
+public:
+
+  /// Counters of packets
+  struct Stat
+  {
+    size_t forwarded;  ///< Delivered packets (duplicates too)
+    size_t dropped;    ///< Lost packets
+    size_t duplicated; ///< Duplicated packets
+    size_t reordered;  ///< Packets held for reordering
+  };
+
+protected:
+
+  /// Client of proxy
+  struct Flow
+  {
+    int               sock;     ///< Upstream socket (to server)
+    Addr              client;   ///< Client address
+    Addr              peer;     ///< Server transfer address (TID)
+    bool              peer_set; ///< Flag: server TID known
+    std::chrono::steady_clock::time_point last; ///< Last activity
+    std::chrono::steady_clock::time_point up;   ///< Last delivery time to server
+    std::chrono::steady_clock::time_point down; ///< Last delivery time to client
+  };
+
+  /// Packet waiting delivery
+  struct Pending
+  {
+    std::chrono::steady_clock::time_point due; ///< Delivery time
+    uint64_t          seq;  ///< Sequence of arrival (stable order on equal time)
+    int               sock; ///< Socket to send from
+    Addr              to;   ///< Destination
+    std::vector<char> data; ///< Packet
+
+    bool operator>(const Pending & val) const;
+  };
+
+  Addr server_;      ///< Server listen address
+  Impairment imp_;   ///< Impairments
+  Addr local_;       ///< Proxy listen address
+  int listen_;       ///< Proxy listen socket
+
+  std::map<std::string, Flow> flows_; ///< Flows by client address
+
+  std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> queue_;
+
+  uint64_t seq_;     ///< Arrival counter
+
+  std::chrono::seconds flow_idle_; ///< Flow forgotten after idle time
+
+  std::mt19937 rnd_; ///< Random generator of impairments
+
+  std::thread thread_;
+
+  std::atomic_bool stop_;
+
+  std::atomic<size_t> forwarded_;
+  std::atomic<size_t> dropped_;
+  std::atomic<size_t> duplicated_;
+  std::atomic<size_t> reordered_;
+
+  /** \brief Apply impairments and queue packet
+   *
+   *  Jitter not reorder packets of one direction (as FIFO queue of real
+   *  link), only reorder probability does
+   *  \param [in] sock Socket to send from
+   *  \param [in] to Destination
+   *  \param [in] data Packet
+   *  \param [in] size Size of packet
+   *  \param [in] now Current time
+   *  \param [in,out] last_due Last delivery time of direction
+   */
+  void push(
+      int sock,
+      const Addr & to,
+      const char * data,
+      const size_t & size,
+      const std::chrono::steady_clock::time_point & now,
+      std::chrono::steady_clock::time_point & last_due);
+
+  /** \brief Send packets with passed delivery time
+   *
+   *  \param [in] now Current time
+   *  \return Milliseconds till next delivery (or poll period)
+   */
+  auto flush(const std::chrono::steady_clock::time_point & now) -> int;
+
+  /** \brief Receive from client; create flow if new
+   *
+   *  \param [in] now Current time
+   */
+  void from_client(const std::chrono::steady_clock::time_point & now);
+
+  /** \brief Receive from server to client of flow
+   *
+   *  \param [in,out] flow Flow
+   *  \param [in] now Current time
+   */
+  void from_server(Flow & flow, const std::chrono::steady_clock::time_point & now);
+
+  /** \brief Drop pending packets sent from socket (counted as lost)
+   *
+   *  \param [in] sock Socket of forgotten flow
+   */
+  void purge(int sock);
+
+  /** \brief Main loop of proxy thread
+   */
+  void loop();
+
+  /** \brief Close all sockets
+   */
+  void close_all();
+
+public:
+
+  /** \brief Constructor
+   *
+   *  \param [in] server Address of server under test
+   *  \param [in] imp Impairments
+   */
+  LossyLink(const Addr & server, const Impairment & imp);
+
+  LossyLink(const LossyLink &) = delete; ///< Deleted/unused
+
+  LossyLink & operator=(const LossyLink &) = delete; ///< Deleted/unused
+
+  /** \brief Destructor
+   *
+   *  Stop thread; close sockets
+   */
+  virtual ~LossyLink();
+
+  /** \brief Open proxy listen socket
+   *
+   *  \param [in] listen Listen address (port 0 - any free port)
+   *  \return Tuple<success; errno value>
+   */
+  auto open(const Addr & listen) -> std::tuple<bool, int>;
+
+  /** \brief Address for clients (actual port after open())
+   *
+   *  \return Address
+   */
+  auto local() const -> const Addr &;
+
+  /** \brief Start proxy thread
+   */
+  void start();
+
+  /** \brief Stop proxy thread (pending packets dropped)
+   */
+  void stop();
+
+  /** \brief Get counters of packets
+   *
+   *  \return Counters
+   */
+  auto stat() const -> Stat;
+};
+
+// -----------------------------------------------------------------------------
+
+} // namespace tftp
+
+#endif /* SOURCE_TOOLS_TFTPLOSSYLINK_H_ */